@@ -0,0 +1,247 @@
+#include <cryptography/Executor.hh>
+
+#include <algorithm>
+#include <iostream>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.Executor");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /*-------------.
+    | Enumerations |
+    `-------------*/
+
+    std::ostream&
+    operator <<(std::ostream& stream,
+                Priority const priority)
+    {
+      switch (priority)
+      {
+        case Priority::low:
+        {
+          stream << "low";
+          break;
+        }
+        case Priority::normal:
+        {
+          stream << "normal";
+          break;
+        }
+        case Priority::high:
+        {
+          stream << "high";
+          break;
+        }
+        default:
+          throw Error(
+            elle::sprintf("unknown priority '%s'",
+                          static_cast<int>(priority)));
+      }
+
+      return (stream);
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Cancellation::Cancellation():
+      _flag(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    void
+    Cancellation::cancel()
+    {
+      this->_flag->store(true);
+    }
+
+    bool
+    Cancellation::cancelled() const
+    {
+      return (this->_flag->load());
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Cancelled::Cancelled():
+      Error("the task has been cancelled")
+    {}
+
+    namespace cancellation
+    {
+      /// The token of the task being executed by the current thread, if any.
+      static thread_local Cancellation const* _current = nullptr;
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      bool
+      requested()
+      {
+        return ((_current != nullptr) && _current->cancelled());
+      }
+
+      int
+      callback(::EVP_PKEY_CTX*)
+      {
+        // Returning zero makes OpenSSL abort the generation.
+        return (requested() ? 0 : 1);
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      Scope::Scope(Cancellation const& cancellation):
+        _previous(_current)
+      {
+        _current = &cancellation;
+      }
+
+      Scope::~Scope()
+      {
+        _current = this->_previous;
+      }
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Executor::Executor(unsigned int const threads,
+                       std::size_t const capacity):
+      _capacity(capacity),
+      _sequence(0),
+      _stop(false)
+    {
+      ELLE_ASSERT_GT(threads, 0u);
+
+      for (unsigned int i = 0; i < threads; ++i)
+        this->_threads.emplace_back([this] { this->_run(); });
+    }
+
+    Executor::~Executor()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stop = true;
+      }
+      this->_condition.notify_all();
+
+      for (auto& thread: this->_threads)
+        thread.join();
+
+      if (!this->_tasks.empty())
+        ELLE_DEBUG("%s: abandon %s pending tasks", *this, this->_tasks.size());
+    }
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    std::size_t
+    Executor::pending() const
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      return (this->_tasks.size());
+    }
+
+    void
+    Executor::_schedule(std::function<void ()> task,
+                        Priority const priority)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        if (this->_tasks.size() >= this->_capacity)
+          throw Error(
+            elle::sprintf("the executor has reached its capacity of %s "
+                          "pending tasks",
+                          this->_capacity));
+
+        this->_tasks.push_back(
+          Task{priority, this->_sequence++, std::move(task)});
+        std::push_heap(this->_tasks.begin(), this->_tasks.end());
+
+        ELLE_DUMP("%s: schedule a task with a %s priority", *this, priority);
+      }
+
+      this->_condition.notify_one();
+    }
+
+    void
+    Executor::_run()
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+
+      while (true)
+      {
+        this->_condition.wait(
+          lock,
+          [this] { return (this->_stop || !this->_tasks.empty()); });
+
+        if (this->_stop)
+          break;
+
+        std::pop_heap(this->_tasks.begin(), this->_tasks.end());
+        std::function<void ()> task = std::move(this->_tasks.back().function);
+        this->_tasks.pop_back();
+
+        lock.unlock();
+
+        // The task reports its errors through its promise.
+        task();
+
+        lock.lock();
+      }
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    void
+    Executor::print(std::ostream& stream) const
+    {
+      stream << "Executor(" << this->_threads.size() << " threads)";
+    }
+
+    namespace executor
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      Executor&
+      generation()
+      {
+        static Executor executor(
+          std::max(std::thread::hardware_concurrency(), 1u));
+
+        return (executor);
+      }
+
+      Executor&
+      batch()
+      {
+        static Executor executor(
+          std::max(std::thread::hardware_concurrency(), 1u));
+
+        return (executor);
+      }
+    }
+  }
+}
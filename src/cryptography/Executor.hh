@@ -0,0 +1,231 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EXECUTOR_HH
+# define INFINIT_CRYPTOGRAPHY_EXECUTOR_HH
+
+# include <atomic>
+# include <condition_variable>
+# include <functional>
+# include <future>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <vector>
+
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+
+# include <cryptography/Error.hh>
+
+# include <openssl/evp.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /*-------------.
+    | Enumerations |
+    `-------------*/
+
+    /// The hint used to order the tasks waiting to be executed.
+    enum class Priority
+    {
+      low,
+      normal,
+      high
+    };
+
+    std::ostream&
+    operator <<(std::ostream& stream,
+                Priority const priority);
+
+    /// Represent a cancellation token shared between the requester of a
+    /// task and the task itself, every copy referring to the same state.
+    class Cancellation
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+    public:
+      Cancellation();
+
+      /*--------.
+      | Methods |
+      `--------*/
+    public:
+      /// Request the cancellation of the task(s) bound to this token.
+      void
+      cancel();
+      /// Return true if the cancellation has been requested.
+      bool
+      cancelled() const;
+
+      /*-----------.
+      | Attributes |
+      `-----------*/
+    private:
+      std::shared_ptr<std::atomic<bool>> _flag;
+    };
+
+    /// The error a future reports should its task have been cancelled.
+    class Cancelled:
+      public Error
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+    public:
+      Cancelled();
+    };
+
+    namespace cancellation
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Return true if the cancellation of the task being executed by the
+      /// calling thread has been requested.
+      bool
+      requested();
+      /// A generation callback, see EVP_PKEY_CTX_set_cb(), aborting the
+      /// operation should the current task have been cancelled.
+      int
+      callback(::EVP_PKEY_CTX* context);
+
+      /*--------.
+      | Classes |
+      `--------*/
+
+      /// Make the given token the one of the calling thread for the scope's
+      /// lifetime.
+      class Scope
+      {
+      public:
+        Scope(Cancellation const& cancellation);
+        Scope(Scope const&) = delete;
+        ~Scope();
+      private:
+        Cancellation const* _previous;
+      };
+    }
+
+    /// Represent a bounded set of threads executing the submitted tasks by
+    /// order of priority, tasks of the same priority being executed in the
+    /// order of submission.
+    ///
+    /// Every task is handed a cancellation token: a task whose cancellation
+    /// is requested before it starts is not executed while a running one
+    /// can poll cancellation::requested() or, for OpenSSL generations,
+    /// install cancellation::callback(). In both cases, the future reports
+    /// a Cancelled error.
+    ///
+    /// Note that the tasks still pending when the executor is destroyed are
+    /// abandoned, their futures reporting a broken promise.
+    class Executor:
+      public elle::Printable
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+    public:
+      /// Construct an executor running the given number of threads and
+      /// accepting at most capacity pending tasks.
+      Executor(unsigned int const threads,
+               std::size_t const capacity = 1024);
+      Executor(Executor const&) = delete;
+      ~Executor();
+
+      /*--------.
+      | Methods |
+      `--------*/
+    public:
+      /// Submit the given function, returning a future on its result.
+      ///
+      /// Note that an Error is thrown should the executor be at capacity.
+      template <typename F>
+      std::future<typename std::result_of<F ()>::type>
+      submit(F function,
+             Priority const priority = Priority::normal,
+             Cancellation const& cancellation = Cancellation());
+      /// Return the number of tasks waiting to be executed.
+      std::size_t
+      pending() const;
+    private:
+      /// Queue the given task.
+      void
+      _schedule(std::function<void ()> task,
+                Priority const priority);
+      /// Execute the queued tasks until the executor is destroyed.
+      void
+      _run();
+
+      /*----------.
+      | Operators |
+      `----------*/
+    public:
+      Executor&
+      operator =(Executor const&) = delete;
+
+      /*----------.
+      | Printable |
+      `----------*/
+    public:
+      void
+      print(std::ostream& stream) const override;
+
+      /*-----------.
+      | Attributes |
+      `-----------*/
+    private:
+      struct Task
+      {
+        Priority priority;
+        uint64_t sequence;
+        std::function<void ()> function;
+
+        /// Order the tasks so that the heap's top be the one of the highest
+        /// priority, submitted first.
+        bool
+        operator <(Task const& other) const
+        {
+          if (this->priority != other.priority)
+            return (this->priority < other.priority);
+
+          return (this->sequence > other.sequence);
+        }
+      };
+
+      ELLE_ATTRIBUTE_R(std::size_t, capacity);
+      /// A heap of the pending tasks, see std::push_heap().
+      std::vector<Task> _tasks;
+      uint64_t _sequence;
+      bool _stop;
+      mutable std::mutex _mutex;
+      std::condition_variable _condition;
+      std::vector<std::thread> _threads;
+    };
+
+    namespace executor
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Return the executor dedicated to key generation, running as many
+      /// threads as the hardware supports.
+      Executor&
+      generation();
+      /// Return the executor dedicated to the batch operations, such as the
+      /// signature verifications, running as many threads as the hardware
+      /// supports.
+      ///
+      /// Note that its tasks must not wait for other tasks of this executor.
+      Executor&
+      batch();
+    }
+  }
+}
+
+# include <cryptography/Executor.hxx>
+
+#endif
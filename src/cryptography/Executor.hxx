@@ -0,0 +1,85 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EXECUTOR_HXX
+# define INFINIT_CRYPTOGRAPHY_EXECUTOR_HXX
+
+# include <utility>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace executor
+    {
+      namespace _details
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        template <typename T, typename F>
+        void
+        fulfill(std::promise<T>& promise,
+                F& function)
+        {
+          promise.set_value(function());
+        }
+
+        template <typename F>
+        void
+        fulfill(std::promise<void>& promise,
+                F& function)
+        {
+          function();
+          promise.set_value();
+        }
+      }
+    }
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    template <typename F>
+    std::future<typename std::result_of<F ()>::type>
+    Executor::submit(F function,
+                     Priority const priority,
+                     Cancellation const& cancellation)
+    {
+      typedef typename std::result_of<F ()>::type T;
+
+      auto promise = std::make_shared<std::promise<T>>();
+      std::future<T> future = promise->get_future();
+
+      this->_schedule(
+        [promise, function, cancellation] () mutable
+        {
+          if (cancellation.cancelled())
+          {
+            promise->set_exception(std::make_exception_ptr(Cancelled()));
+
+            return;
+          }
+
+          cancellation::Scope scope(cancellation);
+
+          try
+          {
+            executor::_details::fulfill(*promise, function);
+          }
+          catch (...)
+          {
+            // A task aborted because of its cancellation is reported as
+            // such rather than through the error it resulted in.
+            if (cancellation.cancelled())
+              promise->set_exception(std::make_exception_ptr(Cancelled()));
+            else
+              promise->set_exception(std::current_exception());
+          }
+        },
+        priority);
+
+      return (future);
+    }
+  }
+}
+
+#endif
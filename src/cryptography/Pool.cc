@@ -0,0 +1,32 @@
+#include <cryptography/Pool.hh>
+
+#include <iostream>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace pool
+    {
+      /*----------.
+      | Operators |
+      `----------*/
+
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Metrics const& metrics)
+      {
+        stream << "Metrics(hits: " << metrics.hits
+               << ", misses: " << metrics.misses
+               << ", wait: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    metrics.wait).count() << "ms"
+               << ", threads: " << metrics.threads
+               << ", available: " << metrics.available
+               << ", rate: " << metrics.rate << "/s)";
+
+        return (stream);
+      }
+    }
+  }
+}
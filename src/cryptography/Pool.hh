@@ -0,0 +1,151 @@
+#ifndef INFINIT_CRYPTOGRAPHY_POOL_HH
+# define INFINIT_CRYPTOGRAPHY_POOL_HH
+
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <functional>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+
+# include <cryptography/Queue.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace pool
+    {
+      /*--------.
+      | Structs |
+      `--------*/
+
+      /// The settings of a pool.
+      struct Configuration
+      {
+        /// The maximum number of values kept in advance.
+        std::size_t capacity = 64;
+        /// The bounds of the number of producer threads.
+        unsigned int minimum_threads = 1;
+        unsigned int maximum_threads = std::thread::hardware_concurrency();
+        /// The maximum time callers should wait for a value: exceeding it
+        /// leads to more producers being activated.
+        std::chrono::milliseconds target_latency =
+          std::chrono::milliseconds(1);
+        /// The interval between two adjustments of the number of producers.
+        std::chrono::milliseconds period = std::chrono::milliseconds(250);
+      };
+
+      /// The metrics of a pool since its construction.
+      struct Metrics
+      {
+        /// The number of values readily handed out.
+        uint64_t hits;
+        /// The number of values generated on the caller's behalf.
+        uint64_t misses;
+        /// The time callers have spent waiting for values to be generated.
+        std::chrono::nanoseconds wait;
+        /// The number of active producer threads.
+        unsigned int threads;
+        /// The number of values available.
+        std::size_t available;
+        /// The number of values consumed per second, smoothed.
+        double rate;
+      };
+
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Metrics const& metrics);
+    }
+
+    /// Represent a pool of values, typically keys, generated in advance by
+    /// a set of producer threads and handed out through a lock-free queue.
+    ///
+    /// The number of active producers is adjusted periodically according
+    /// to the consumption rate and the time needed to generate a value,
+    /// more producers being activated whenever callers have to wait longer
+    /// than the target latency. Should the pool be empty, the value is
+    /// generated on the caller's behalf rather than waiting for a producer.
+    template <typename T>
+    class Pool
+      : public elle::Printable
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+    public:
+      typedef std::function<T ()> Generator;
+
+      Pool(Generator generator,
+           pool::Configuration const& configuration = pool::Configuration());
+      Pool(Pool<T> const&) = delete;
+      virtual
+      ~Pool();
+
+      /*--------.
+      | Methods |
+      `--------*/
+    public:
+      /// Return a value, generating it should none be available.
+      T
+      get();
+      /// Return the pool's metrics.
+      pool::Metrics
+      metrics() const;
+    private:
+      /// Generate values while active.
+      void
+      _produce(unsigned int const index);
+      /// Periodically adjust the number of active producers.
+      void
+      _supervise();
+      /// Generate a value, accounting for the time it took.
+      std::unique_ptr<T>
+      _generate();
+
+      /*----------.
+      | Operators |
+      `----------*/
+    public:
+      Pool<T>&
+      operator =(Pool<T> const&) = delete;
+
+      /*----------.
+      | Printable |
+      `----------*/
+    public:
+      void
+      print(std::ostream& stream) const override;
+
+      /*-----------.
+      | Attributes |
+      `-----------*/
+    private:
+      ELLE_ATTRIBUTE(Generator, generator);
+      ELLE_ATTRIBUTE_R(pool::Configuration, configuration);
+      Queue<T> _queue;
+      std::atomic<uint64_t> _hits;
+      std::atomic<uint64_t> _misses;
+      std::atomic<uint64_t> _wait;
+      /// The average time, in nanoseconds, to generate a value.
+      std::atomic<uint64_t> _duration;
+      /// The number of producers allowed to generate values.
+      std::atomic<unsigned int> _active;
+      std::atomic<double> _rate;
+      bool _stop;
+      std::mutex _mutex;
+      /// Signaled to wake up the parked producers and the supervisor.
+      std::condition_variable _condition;
+      std::vector<std::thread> _producers;
+      std::thread _supervisor;
+    };
+  }
+}
+
+# include <cryptography/Pool.hxx>
+
+#endif
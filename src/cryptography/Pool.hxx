@@ -0,0 +1,253 @@
+#ifndef INFINIT_CRYPTOGRAPHY_POOL_HXX
+# define INFINIT_CRYPTOGRAPHY_POOL_HXX
+
+# include <algorithm>
+# include <cmath>
+
+# include <elle/log.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    template <typename T>
+    Pool<T>::Pool(Generator generator,
+                  pool::Configuration const& configuration):
+      _generator(std::move(generator)),
+      _configuration(configuration),
+      _queue(configuration.capacity),
+      _hits(0),
+      _misses(0),
+      _wait(0),
+      _duration(0),
+      _active(0),
+      _rate(0),
+      _stop(false)
+    {
+      this->_configuration.maximum_threads =
+        std::max({this->_configuration.maximum_threads,
+                  this->_configuration.minimum_threads,
+                  1u});
+      this->_active = this->_configuration.minimum_threads;
+
+      // All the producers are spawned once and for all, the inactive ones
+      // being parked until the supervisor activates them.
+      for (unsigned int i = 0; i < this->_configuration.maximum_threads; ++i)
+        this->_producers.emplace_back([this, i] { this->_produce(i); });
+
+      this->_supervisor = std::thread([this] { this->_supervise(); });
+    }
+
+    template <typename T>
+    Pool<T>::~Pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stop = true;
+      }
+      this->_condition.notify_all();
+
+      this->_supervisor.join();
+      for (auto& producer: this->_producers)
+        producer.join();
+    }
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    template <typename T>
+    T
+    Pool<T>::get()
+    {
+      std::unique_ptr<T> value = this->_queue.pop();
+
+      if (value != nullptr)
+      {
+        this->_hits++;
+
+        return (std::move(*value));
+      }
+
+      // Rather than waiting for a producer, generate the value: the
+      // supervisor will notice the miss and activate more producers.
+      this->_misses++;
+
+      auto start = std::chrono::steady_clock::now();
+      value = this->_generate();
+      this->_wait +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+
+      return (std::move(*value));
+    }
+
+    template <typename T>
+    pool::Metrics
+    Pool<T>::metrics() const
+    {
+      return (pool::Metrics{
+          this->_hits.load(),
+          this->_misses.load(),
+          std::chrono::nanoseconds(this->_wait.load()),
+          this->_active.load(),
+          this->_queue.size(),
+          this->_rate.load()});
+    }
+
+    template <typename T>
+    void
+    Pool<T>::_produce(unsigned int const index)
+    {
+      ELLE_LOG_COMPONENT("infinit.cryptography.Pool");
+
+      std::unique_lock<std::mutex> lock(this->_mutex);
+
+      while (!this->_stop)
+      {
+        // Park the inactive producers as well as the active ones while the
+        // pool is full.
+        if ((index >= this->_active) ||
+            (this->_queue.size() >= this->_configuration.capacity))
+        {
+          this->_condition.wait_for(lock, this->_configuration.period);
+
+          continue;
+        }
+
+        lock.unlock();
+
+        try
+        {
+          std::unique_ptr<T> value = this->_generate();
+
+          // The queue may have been filled by another producer in the
+          // meantime, in which case the value is discarded.
+          if (!this->_queue.push(value))
+            ELLE_DEBUG("%s: discard a value, the pool being full", *this);
+
+          lock.lock();
+        }
+        catch (std::exception const& e)
+        {
+          ELLE_ERR("%s: unable to generate a value: %s", *this, e.what());
+
+          lock.lock();
+
+          // Do not retry immediately.
+          this->_condition.wait_for(lock, this->_configuration.period);
+        }
+      }
+    }
+
+    template <typename T>
+    void
+    Pool<T>::_supervise()
+    {
+      ELLE_LOG_COMPONENT("infinit.cryptography.Pool");
+
+      std::unique_lock<std::mutex> lock(this->_mutex);
+
+      uint64_t consumed = 0;
+      uint64_t misses = 0;
+      uint64_t wait = 0;
+      double period =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+          this->_configuration.period).count();
+      double target =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+          this->_configuration.target_latency).count();
+
+      while (true)
+      {
+        this->_condition.wait_for(lock, this->_configuration.period);
+
+        if (this->_stop)
+          break;
+
+        uint64_t _misses = this->_misses.load();
+        uint64_t _consumed = this->_hits.load() + _misses;
+        uint64_t _wait = this->_wait.load();
+
+        // Smooth the consumption rate.
+        double rate = (_consumed - consumed) / period;
+        this->_rate = 0.75 * this->_rate.load() + 0.25 * rate;
+
+        // Whether the callers had to wait longer than the target latency
+        // on average.
+        bool starving =
+          (_misses > misses) &&
+          (((_wait - wait) / 1e9 / (_misses - misses)) > target);
+
+        consumed = _consumed;
+        misses = _misses;
+        wait = _wait;
+
+        // The number of producers needed to keep up with the consumption
+        // given the time it takes to generate a value.
+        double duration = this->_duration.load() / 1e9;
+        unsigned int active = this->_active.load();
+        unsigned int needed =
+          static_cast<unsigned int>(std::ceil(this->_rate.load() * duration));
+
+        if (starving)
+          needed = std::max(needed, active + 1);
+        else if (needed < active)
+          // Scale down progressively to avoid oscillating.
+          needed = active - 1;
+
+        needed = std::min(std::max(needed,
+                                   this->_configuration.minimum_threads),
+                          this->_configuration.maximum_threads);
+
+        if (needed != active)
+        {
+          ELLE_DEBUG("%s: scale from %s to %s producers at %s values per "
+                     "second", *this, active, needed, this->_rate.load());
+
+          this->_active = needed;
+          this->_condition.notify_all();
+        }
+      }
+    }
+
+    template <typename T>
+    std::unique_ptr<T>
+    Pool<T>::_generate()
+    {
+      auto start = std::chrono::steady_clock::now();
+      std::unique_ptr<T> value(new T(this->_generator()));
+      uint64_t elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+
+      // Smooth the generation time, the approximation resulting from
+      // concurrent updates being harmless.
+      uint64_t duration = this->_duration.load();
+      this->_duration =
+        duration == 0 ? elapsed : (duration * 7 + elapsed) / 8;
+
+      return (value);
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    template <typename T>
+    void
+    Pool<T>::print(std::ostream& stream) const
+    {
+      stream << "Pool(" << this->_active.load() << "/"
+             << this->_configuration.maximum_threads << " producers, "
+             << this->_queue.size() << "/"
+             << this->_configuration.capacity << " values)";
+    }
+  }
+}
+
+#endif
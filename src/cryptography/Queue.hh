@@ -0,0 +1,81 @@
+#ifndef INFINIT_CRYPTOGRAPHY_QUEUE_HH
+# define INFINIT_CRYPTOGRAPHY_QUEUE_HH
+
+# include <atomic>
+# include <cstddef>
+# include <memory>
+
+# include <elle/attribute.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /// Represent a bounded, lock-free, multi-producer/multi-consumer queue
+    /// of heap-allocated values.
+    ///
+    /// Every cell carries a sequence number telling whether it is ready to
+    /// be written or read for a given position, producers and consumers
+    /// claiming positions through a compare-and-swap on their respective
+    /// counter.
+    template <typename T>
+    class Queue
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+    public:
+      /// Construct a queue holding at most capacity values, rounded up to
+      /// the next power of two.
+      explicit
+      Queue(std::size_t const capacity);
+      Queue(Queue<T> const&) = delete;
+
+      /*--------.
+      | Methods |
+      `--------*/
+    public:
+      /// Push the given value, returning false, the value being left
+      /// untouched, should the queue be full.
+      bool
+      push(std::unique_ptr<T>& value);
+      /// Pop a value, null being returned should the queue be empty.
+      std::unique_ptr<T>
+      pop();
+      /// Return an approximation of the number of values in the queue.
+      std::size_t
+      size() const;
+      /// Return the number of values the queue can hold.
+      std::size_t
+      capacity() const;
+
+      /*----------.
+      | Operators |
+      `----------*/
+    public:
+      Queue<T>&
+      operator =(Queue<T> const&) = delete;
+
+      /*-----------.
+      | Attributes |
+      `-----------*/
+    private:
+      struct Cell
+      {
+        std::atomic<std::size_t> sequence;
+        std::unique_ptr<T> value;
+      };
+
+      std::size_t _mask;
+      std::unique_ptr<Cell[]> _cells;
+      // Keep the counters on distinct cache lines since they are written by
+      // different threads.
+      alignas(64) std::atomic<std::size_t> _enqueue;
+      alignas(64) std::atomic<std::size_t> _dequeue;
+    };
+  }
+}
+
+# include <cryptography/Queue.hxx>
+
+#endif
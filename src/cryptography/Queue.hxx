@@ -0,0 +1,126 @@
+#ifndef INFINIT_CRYPTOGRAPHY_QUEUE_HXX
+# define INFINIT_CRYPTOGRAPHY_QUEUE_HXX
+
+# include <cstdint>
+
+# include <elle/assert.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    template <typename T>
+    Queue<T>::Queue(std::size_t const capacity):
+      _enqueue(0),
+      _dequeue(0)
+    {
+      ELLE_ASSERT_GT(capacity, 0u);
+
+      std::size_t size = 1;
+      while (size < capacity)
+        size <<= 1;
+
+      this->_mask = size - 1;
+      this->_cells.reset(new Cell[size]);
+
+      for (std::size_t i = 0; i < size; ++i)
+        this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    template <typename T>
+    bool
+    Queue<T>::push(std::unique_ptr<T>& value)
+    {
+      Cell* cell;
+      std::size_t position = this->_enqueue.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &this->_cells[position & this->_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference =
+          static_cast<std::intptr_t>(sequence) -
+          static_cast<std::intptr_t>(position);
+
+        if (difference == 0)
+        {
+          if (this->_enqueue.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+          // The cell has not been read since the previous round: full.
+          return (false);
+        else
+          position = this->_enqueue.load(std::memory_order_relaxed);
+      }
+
+      cell->value = std::move(value);
+      cell->sequence.store(position + 1, std::memory_order_release);
+
+      return (true);
+    }
+
+    template <typename T>
+    std::unique_ptr<T>
+    Queue<T>::pop()
+    {
+      Cell* cell;
+      std::size_t position = this->_dequeue.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &this->_cells[position & this->_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference =
+          static_cast<std::intptr_t>(sequence) -
+          static_cast<std::intptr_t>(position + 1);
+
+        if (difference == 0)
+        {
+          if (this->_dequeue.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+          // The cell has not been written yet: empty.
+          return (nullptr);
+        else
+          position = this->_dequeue.load(std::memory_order_relaxed);
+      }
+
+      std::unique_ptr<T> value = std::move(cell->value);
+      cell->sequence.store(position + this->_mask + 1,
+                           std::memory_order_release);
+
+      return (value);
+    }
+
+    template <typename T>
+    std::size_t
+    Queue<T>::size() const
+    {
+      std::size_t enqueue = this->_enqueue.load(std::memory_order_relaxed);
+      std::size_t dequeue = this->_dequeue.load(std::memory_order_relaxed);
+
+      return (enqueue > dequeue ? enqueue - dequeue : 0);
+    }
+
+    template <typename T>
+    std::size_t
+    Queue<T>::capacity() const
+    {
+      return (this->_mask + 1);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef INFINIT_CRYPTOGRAPHY_SECRETKEYPOOL_HH
+# define INFINIT_CRYPTOGRAPHY_SECRETKEYPOOL_HH
+
+# include <cryptography/Pool.hh>
+# include <cryptography/SecretKey.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /// A pool of secret keys of a given length, in bits.
+    class SecretKeyPool
+      : public Pool<SecretKey>
+    {
+    public:
+      SecretKeyPool(uint32_t const length,
+                    pool::Configuration const& configuration =
+                      pool::Configuration())
+      : Pool<SecretKey>(
+          [length] { return secretkey::generate(length); },
+          configuration)
+      {}
+    };
+  }
+}
+
+#endif
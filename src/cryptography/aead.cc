@@ -0,0 +1,225 @@
+#include <cryptography/aead.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/io.hh>
+
+#include <elle/printf.hh>
+
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace aead
+    {
+      /*----------.
+      | Constants |
+      `----------*/
+
+      /// The amount of data the chunk buffers start with, growing with the
+      /// data actually read so that small plains do not pay for whole
+      /// chunks.
+      static std::size_t const _step = 4096;
+
+      /*-----------------.
+      | Static Functions |
+      `-----------------*/
+
+      /// Compute the nonce of the given chunk.
+      static
+      void
+      _nonce(unsigned char* nonce,
+             unsigned char const* prefix,
+             uint32_t const counter,
+             bool const last)
+      {
+        ::memcpy(nonce, prefix, prefix_size);
+        for (std::size_t i = 0; i < 4; ++i)
+          nonce[prefix_size + i] = (counter >> (8 * (3 - i))) & 0xff;
+        nonce[prefix_size + 4] = last ? 1 : 0;
+      }
+
+      /// Read at most size bytes from the stream in the buffer, growing it
+      /// as data comes, set the length read and return true if the stream
+      /// has been entirely read.
+      ///
+      /// Note that the buffer never shrinks, hence never being empty once
+      /// read into, so that OpenSSL is never handed a null pointer.
+      static
+      bool
+      _read(std::istream& stream,
+            std::vector<unsigned char>& buffer,
+            std::size_t const size,
+            char const* what,
+            std::size_t& length)
+      {
+        length = 0;
+
+        while (length < size)
+        {
+          if (buffer.size() == length)
+            buffer.resize(
+              std::min(size, std::max(buffer.size() * 2, _step)));
+
+          std::size_t const step = std::min(size, buffer.size()) - length;
+
+          stream.read(reinterpret_cast<char*>(buffer.data() + length), step);
+          if (stream.bad())
+            throw Error(
+              elle::sprintf("unable to read the %s's input stream: %s",
+                            what, stream.rdstate()));
+
+          length += stream.gcount();
+
+          if (static_cast<std::size_t>(stream.gcount()) < step)
+            break;
+        }
+
+        // The chunk is the final one should the stream have been entirely
+        // read, which peek() reveals for streams multiple of the size.
+        return (stream.eof() ||
+                (stream.peek() == std::istream::traits_type::eof()));
+      }
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      void
+      seal(::EVP_CIPHER_CTX* context,
+           unsigned char const* prefix,
+           elle::ConstWeakBuffer const& associated,
+           uint32_t const chunk_size,
+           std::istream& plain,
+           std::ostream& code)
+      {
+        std::vector<unsigned char> input;
+        std::vector<unsigned char> output;
+        unsigned char nonce[nonce_size];
+
+        for (uint32_t counter = 0; ; ++counter)
+        {
+          std::size_t size;
+          bool last = _read(plain, input, chunk_size, "plain", size);
+
+          if (!last && (counter == 0xffffffff))
+            throw Error("the plain is too large for the chunk size");
+
+          _nonce(nonce, prefix, counter, last);
+
+          if (output.size() < size + tag_size)
+            output.resize(size + tag_size);
+
+          int size_update(0);
+          int size_final(0);
+
+          if ((::EVP_EncryptInit_ex(context, nullptr, nullptr,
+                                    nullptr, nonce) <= 0) ||
+              (::EVP_EncryptUpdate(context, nullptr, &size_update,
+                                   associated.contents(),
+                                   associated.size()) <= 0) ||
+              (::EVP_EncryptUpdate(context, output.data(), &size_update,
+                                   input.data(), size) <= 0) ||
+              (::EVP_EncryptFinal_ex(context,
+                                     output.data() + size_update,
+                                     &size_final) <= 0) ||
+              (::EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_GET_TAG,
+                                     tag_size,
+                                     output.data() + size_update +
+                                     size_final) <= 0))
+            throw Error(
+              elle::sprintf("unable to encrypt the chunk %s: %s",
+                            counter,
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          io::write(code, output.data(), size_update + size_final + tag_size,
+                    "chunk");
+
+          if (last)
+            break;
+        }
+      }
+
+      void
+      open(::EVP_CIPHER_CTX* context,
+           unsigned char const* prefix,
+           elle::ConstWeakBuffer const& associated,
+           uint32_t const chunk_size,
+           std::istream& code,
+           std::ostream& plain)
+      {
+        std::vector<unsigned char> input;
+        std::vector<unsigned char> output;
+        unsigned char nonce[nonce_size];
+
+        for (uint32_t counter = 0; ; ++counter)
+        {
+          // The final chunk is the one ending the code, a truncated code
+          // failing the authentication of its last chunk.
+          std::size_t size;
+          bool last = _read(code, input, chunk_size + tag_size, "code", size);
+
+          if (size < tag_size)
+            throw Error("the envelope is truncated");
+
+          if (!last && (counter == 0xffffffff))
+            throw Error("the envelope has too many chunks");
+
+          size -= tag_size;
+
+          _nonce(nonce, prefix, counter, last);
+
+          if (output.size() < size + tag_size)
+            output.resize(size + tag_size);
+
+          int size_update(0);
+          int size_final(0);
+
+          if ((::EVP_DecryptInit_ex(context, nullptr, nullptr,
+                                    nullptr, nonce) <= 0) ||
+              (::EVP_DecryptUpdate(context, nullptr, &size_update,
+                                   associated.contents(),
+                                   associated.size()) <= 0) ||
+              (::EVP_DecryptUpdate(context, output.data(), &size_update,
+                                   input.data(), size) <= 0) ||
+              (::EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_TAG,
+                                     tag_size,
+                                     input.data() + size) <= 0))
+            throw Error(
+              elle::sprintf("unable to decrypt the chunk %s: %s",
+                            counter,
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::EVP_DecryptFinal_ex(context,
+                                    output.data() + size_update,
+                                    &size_final) <= 0)
+          {
+            // Wipe the unauthenticated plain.
+            ::OPENSSL_cleanse(output.data(), output.size());
+
+            throw Error(
+              elle::sprintf("the chunk %s of the envelope is not authentic",
+                            counter));
+          }
+
+          plain.write(reinterpret_cast<char const*>(output.data()),
+                      size_update + size_final);
+          if (!plain.good())
+            throw Error(
+              elle::sprintf("unable to write the plain's output stream: %s",
+                            plain.rdstate()));
+
+          if (last)
+            break;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+#ifndef INFINIT_CRYPTOGRAPHY_AEAD_HH
+# define INFINIT_CRYPTOGRAPHY_AEAD_HH
+
+# include <elle/Buffer.hh>
+# include <elle/types.hh>
+
+# include <openssl/evp.h>
+
+# include <cstddef>
+# include <iosfwd>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /// Contain the STREAM construction the chunked envelopes, i.e. the v3
+    /// RSA envelopes and the ECIES ones, rely upon: the plain is split in
+    /// chunks of a given size, every one being encrypted with AES-GCM and
+    /// authenticated independently along with the associated data, the
+    /// nonce being made of a prefix, the chunk counter and a flag marking
+    /// the final chunk.
+    ///
+    /// Note that the cipher context must have been initialized with the
+    /// key, an AES-GCM cipher and nonces of nonce_size bytes, the nonces
+    /// being set chunk after chunk.
+    namespace aead
+    {
+      /*----------.
+      | Constants |
+      `----------*/
+
+      /// The size of the nonce prefix.
+      static std::size_t const prefix_size = 7;
+      /// The size of the nonces: the prefix, the chunk counter on four bytes
+      /// and the final-chunk flag.
+      static std::size_t const nonce_size = prefix_size + 5;
+      /// The size of the tag authenticating every chunk.
+      static std::size_t const tag_size = 16;
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Encrypt the plain's input stream chunk by chunk, writing every
+      /// chunk followed by its tag to the code's output stream.
+      void
+      seal(::EVP_CIPHER_CTX* context,
+           unsigned char const* prefix,
+           elle::ConstWeakBuffer const& associated,
+           uint32_t const chunk_size,
+           std::istream& plain,
+           std::ostream& code);
+      /// Decrypt the code's input stream chunk by chunk, writing every
+      /// chunk to the plain's output stream as soon as it has been
+      /// authenticated.
+      ///
+      /// Note that an error is reported should the code be truncated, the
+      /// chunks written so far being authentic but the plain incomplete.
+      void
+      open(::EVP_CIPHER_CTX* context,
+           unsigned char const* prefix,
+           elle::ConstWeakBuffer const& associated,
+           uint32_t const chunk_size,
+           std::istream& code,
+           std::ostream& plain);
+    }
+  }
+}
+
+#endif
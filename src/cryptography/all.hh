@@ -4,8 +4,13 @@
 # include <cryptography/Cipher.hh>
 # include <cryptography/Cryptosystem.hh>
 # include <cryptography/Error.hh>
+# include <cryptography/Executor.hh>
 # include <cryptography/Oneway.hh>
+# include <cryptography/Pool.hh>
+# include <cryptography/Queue.hh>
 # include <cryptography/SecretKey.hh>
+# include <cryptography/SecretKeyPool.hh>
+# include <cryptography/aead.hh>
 # include <cryptography/bn.hh>
 # include <cryptography/cryptography.hh>
 # include <cryptography/raw.hh>
@@ -15,13 +20,16 @@
 # include <cryptography/types.hh>
 # include <cryptography/hash.hh>
 # include <cryptography/hmac.hh>
+# include <cryptography/io.hh>
 # include <cryptography/pem.hh>
+# include <cryptography/pipeline.hh>
 # include <cryptography/serialization.hh>
 # include <cryptography/context.hh>
 # include <cryptography/constants.hh>
 
 # include <cryptography/rsa/all.hh>
 # include <cryptography/dsa/all.hh>
+# include <cryptography/ec/all.hh>
 # include <cryptography/dh/all.hh>
 
 #endif
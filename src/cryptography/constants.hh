@@ -13,6 +13,12 @@ namespace infinit
 
       /// The size of the chunk to process iteratively from the streams.
       static uint32_t const stream_block_size = 524288;
+      /// The size of the chunk accumulated from the data written to a
+      /// digest sink before being processed.
+      static uint32_t const sink_block_size = 4096;
+      /// The size of the chunks the v3 envelopes, authenticated chunk by
+      /// chunk, are split in.
+      static uint32_t const envelope_chunk_size = 65536;
     }
   }
 }
@@ -3,11 +3,16 @@
 #include <openssl/engine.h>
 #include <openssl/err.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_set>
+
 #include <elle/log.hh>
 
 #include <cryptography/Error.hh>
 #include <cryptography/context.hh>
 #include <cryptography/finally.hh>
+#include <cryptography/types.hh>
 
 namespace infinit
 {
@@ -41,6 +46,166 @@ namespace infinit
 
         return (context);
       }
+
+      namespace cache
+      {
+        /*----------.
+        | Constants |
+        `----------*/
+
+        /// The maximum number of contexts kept by every thread, the least
+        /// recently used being released first.
+        static std::size_t const capacity = 32;
+
+        /*--------.
+        | Classes |
+        `--------*/
+
+        namespace
+        {
+          struct Entry
+          {
+            ::EVP_PKEY* key;
+            int (*function)(EVP_PKEY_CTX*);
+            int variant;
+            types::EVP_PKEY_CTX context;
+          };
+
+          struct Cache;
+
+          /// The set of the threads' caches, so that a key can be invalidated
+          /// whatever the thread it has been used from.
+          struct Registry
+          {
+            std::mutex mutex;
+            std::unordered_set<Cache*> caches;
+          };
+
+          static
+          Registry&
+          _registry()
+          {
+            // Never destroyed so that threads exiting late can still
+            // unregister their cache.
+            static Registry* registry = new Registry;
+
+            return (*registry);
+          }
+
+          /// The contexts of a thread, the most recently used first.
+          ///
+          /// The mutex is only ever contended when another thread
+          /// invalidates a key.
+          struct Cache
+          {
+            Cache()
+            {
+              std::lock_guard<std::mutex> lock(_registry().mutex);
+              _registry().caches.insert(this);
+            }
+
+            ~Cache()
+            {
+              std::lock_guard<std::mutex> lock(_registry().mutex);
+              _registry().caches.erase(this);
+            }
+
+            std::mutex mutex;
+            std::list<Entry> entries;
+          };
+
+          static
+          Cache&
+          _cache()
+          {
+            static thread_local Cache cache;
+
+            return (cache);
+          }
+        }
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        void
+        apply(::EVP_PKEY* key,
+              int (*function)(EVP_PKEY_CTX*),
+              int const variant,
+              std::function<void (::EVP_PKEY_CTX*)> const& setup,
+              std::function<void (::EVP_PKEY_CTX*)> const& action)
+        {
+          ELLE_ASSERT_NEQ(key, nullptr);
+
+          Cache& cache = _cache();
+          std::lock_guard<std::mutex> lock(cache.mutex);
+
+          auto iterator = cache.entries.begin();
+
+          for (; iterator != cache.entries.end(); ++iterator)
+            if ((iterator->key == key) &&
+                (iterator->function == function) &&
+                (iterator->variant == variant))
+              break;
+
+          if (iterator != cache.entries.end())
+          {
+            // Move the entry at the front to keep the list ordered.
+            cache.entries.splice(cache.entries.begin(),
+                                 cache.entries,
+                                 iterator);
+          }
+          else
+          {
+            types::EVP_PKEY_CTX context(create(key, function));
+
+            if (setup)
+              setup(context.get());
+
+            cache.entries.push_front(
+              Entry{key, function, variant, std::move(context)});
+
+            if (cache.entries.size() > capacity)
+              cache.entries.pop_back();
+          }
+
+          try
+          {
+            action(cache.entries.front().context.get());
+          }
+          catch (...)
+          {
+            cache.entries.pop_front();
+
+            throw;
+          }
+        }
+
+        void
+        invalidate(::EVP_PKEY* key)
+        {
+          if (key == nullptr)
+            return;
+
+          // Every cached context holding a reference on its key, there is
+          // nothing to release if the caller holds the only one.
+          if (key->references <= 1)
+            return;
+
+          std::lock_guard<std::mutex> lock(_registry().mutex);
+
+          for (Cache* cache: _registry().caches)
+          {
+            std::lock_guard<std::mutex> _lock(cache->mutex);
+
+            cache->entries.remove_if(
+              [key] (Entry const& entry)
+              {
+                return (entry.key == key);
+              });
+          }
+        }
+      }
     }
   }
 }
@@ -3,6 +3,7 @@
 
 # include <openssl/evp.h>
 
+# include <functional>
 # include <iosfwd>
 
 namespace infinit
@@ -15,6 +16,37 @@ namespace infinit
       ::EVP_PKEY_CTX*
       create(::EVP_PKEY* key,
              int (*function)(EVP_PKEY_CTX*));
+
+      /// Keep, for every thread, a small set of initialized contexts so that
+      /// repeated operations with the same key do not pay for allocating and
+      /// initializing a new context every time.
+      ///
+      /// Contexts are identified by the key, the initialization function
+      /// (i.e the operation) and a variant, for instance the padding, which
+      /// discriminates between contexts set up differently for the same
+      /// operation.
+      ///
+      /// Note that a cached context holds a reference on its key, which is
+      /// therefore never released while cached. Key classes must invalidate
+      /// the contexts related to their key upon destruction.
+      namespace cache
+      {
+        /// Call the action with the context associated with the given key,
+        /// operation and variant, creating the context and calling the setup
+        /// function on it should it not be cached already.
+        ///
+        /// Should the action throw, the context is discarded rather than
+        /// kept in an unknown state.
+        void
+        apply(::EVP_PKEY* key,
+              int (*function)(EVP_PKEY_CTX*),
+              int const variant,
+              std::function<void (::EVP_PKEY_CTX*)> const& setup,
+              std::function<void (::EVP_PKEY_CTX*)> const& action);
+        /// Release every context related to the given key, in every thread.
+        void
+        invalidate(::EVP_PKEY* key);
+      }
     }
   }
 }
@@ -203,6 +203,16 @@ namespace infinit
 
           return (KeyPair(std::move(K), std::move(k)));
         }
+
+        std::future<KeyPair>
+        generate_async(Priority const priority,
+                       Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [] { return (generate()); },
+                    priority,
+                    cancellation));
+        }
       }
     }
   }
@@ -8,9 +8,11 @@
 # include <cryptography/fwd.hh>
 # include <cryptography/Oneway.hh>
 # include <cryptography/Cipher.hh>
+# include <cryptography/Executor.hh>
 # include <cryptography/dh/PublicKey.hh>
 # include <cryptography/dh/PrivateKey.hh>
 
+# include <future>
 # include <utility>
 ELLE_OPERATOR_RELATIONALS();
 
@@ -112,6 +114,11 @@ namespace infinit
         /// freshly generated DH key pair.
         KeyPair
         generate();
+        /// Generate a key pair on the key generation executor, returning
+        /// a future on it.
+        std::future<KeyPair>
+        generate_async(Priority const priority = Priority::normal,
+                       Cancellation const& cancellation = Cancellation());
       }
     }
   }
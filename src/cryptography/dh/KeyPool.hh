@@ -0,0 +1,29 @@
+#ifndef INFINIT_CRYPTOGRAPHY_DH_KEYPOOL_HH
+# define INFINIT_CRYPTOGRAPHY_DH_KEYPOOL_HH
+
+# include <cryptography/Pool.hh>
+# include <cryptography/dh/KeyPair.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dh
+    {
+      /// A pool of DH key pairs, typically for ephemeral agreements.
+      class KeyPool
+        : public Pool<KeyPair>
+      {
+      public:
+        KeyPool(pool::Configuration const& configuration =
+                  pool::Configuration())
+        : Pool<KeyPair>(
+            [] { return keypair::generate(); },
+            configuration)
+        {}
+      };
+    }
+  }
+}
+
+#endif
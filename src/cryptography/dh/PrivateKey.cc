@@ -7,6 +7,7 @@
 
 #include <cryptography/Error.hh>
 #include <cryptography/bn.hh>
+#include <cryptography/context.hh>
 #include <cryptography/cryptography.hh>
 #include <cryptography/dh/KeyPair.hh>
 #include <cryptography/dh/PrivateKey.hh>
@@ -88,6 +89,11 @@ namespace infinit
         this->_check();
       }
 
+      PrivateKey::~PrivateKey()
+      {
+        context::cache::invalidate(this->_key.get());
+      }
+
       /*--------.
       | Methods |
       `--------*/
@@ -126,8 +132,19 @@ namespace infinit
       SecretKey
       PrivateKey::agree(PublicKey const& peer_K) const
       {
-        return (raw::asymmetric::agree(this->_key.get(),
-                                       peer_K.key().get()));
+        elle::Buffer secret;
+
+        context::cache::apply(
+          this->_key.get(),
+          ::EVP_PKEY_derive_init,
+          0,
+          nullptr,
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            secret = raw::asymmetric::agree(context, peer_K.key().get());
+          });
+
+        return (SecretKey(std::move(secret)));
       }
 
       uint32_t
@@ -46,7 +46,7 @@ namespace infinit
         PrivateKey(PrivateKey const& other);
         PrivateKey(PrivateKey&& other);
         virtual
-        ~PrivateKey() = default;
+        ~PrivateKey();
 
         /*--------.
         | Methods |
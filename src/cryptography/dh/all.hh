@@ -2,6 +2,7 @@
 # define INFINIT_CRYPTOGRAPHY_DH_ALL_HH
 
 # include <cryptography/dh/KeyPair.hh>
+# include <cryptography/dh/KeyPool.hh>
 # include <cryptography/dh/PrivateKey.hh>
 # include <cryptography/dh/PublicKey.hh>
 # include <cryptography/dh/low.hh>
@@ -166,48 +166,17 @@ namespace infinit
         KeyPair
         generate(uint32_t const length,
                  Oneway const digest_algorithm)
+        {
+          return (generate(parameters::generate(length), digest_algorithm));
+        }
+
+        KeyPair
+        generate(Parameters const& parameters,
+                 Oneway const digest_algorithm)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
 
-          ::EVP_PKEY* parameters = nullptr;
-
-          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY(parameters);
-
-          // Generate the parameters for the DSA key.
-          {
-            ::EVP_PKEY_CTX* context;
-
-            if ((context =
-                 ::EVP_PKEY_CTX_new_id(EVP_PKEY_DSA, nullptr)) == nullptr)
-              throw Error(
-                elle::sprintf("unable to allocate a parameters generation "
-                              "context: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-
-            INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY_CONTEXT(context);
-
-            if (::EVP_PKEY_paramgen_init(context) <= 0)
-              throw Error(
-                elle::sprintf("unable to initialize the parameters generation "
-                              "context: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-
-            if (::EVP_PKEY_CTX_set_dsa_paramgen_bits(context, length) <= 0)
-              throw Error(
-                elle::sprintf("unable to set the parameters generation "
-                              "context's key length: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-
-            if (::EVP_PKEY_paramgen(context, &parameters) <= 0)
-              throw Error(
-                elle::sprintf("unable to generate the parameters: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-
-            INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
-            ::EVP_PKEY_CTX_free(context);
-          }
-
           ::EVP_PKEY* key = nullptr;
 
           INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY(key);
@@ -217,7 +186,8 @@ namespace infinit
             ::EVP_PKEY_CTX* context;
 
             if ((context =
-                 ::EVP_PKEY_CTX_new(parameters, nullptr)) == nullptr)
+                 ::EVP_PKEY_CTX_new(parameters.key().get(),
+                                    nullptr)) == nullptr)
               throw Error(
                 elle::sprintf("unable to allocate a keypair generation "
                               "context: %s",
@@ -250,11 +220,38 @@ namespace infinit
 
           INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(key);
 
-          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(parameters);
-          ::EVP_PKEY_free(parameters);
-
           return (KeyPair(std::move(K), std::move(k)));
         }
+
+        std::future<KeyPair>
+        generate_async(uint32_t const length,
+                       Oneway const digest_algorithm,
+                       Priority const priority,
+                       Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [length, digest_algorithm]
+                    {
+                      return (generate(length, digest_algorithm));
+                    },
+                    priority,
+                    cancellation));
+        }
+
+        std::future<KeyPair>
+        generate_async(Parameters const& parameters,
+                       Oneway const digest_algorithm,
+                       Priority const priority,
+                       Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [parameters, digest_algorithm]
+                    {
+                      return (generate(parameters, digest_algorithm));
+                    },
+                    priority,
+                    cancellation));
+        }
       }
     }
   }
@@ -1,6 +1,7 @@
 #ifndef INFINIT_CRYPTOGRAPHY_DSA_KEYPAIR_HH
 # define INFINIT_CRYPTOGRAPHY_DSA_KEYPAIR_HH
 
+# include <future>
 # include <iosfwd>
 # include <utility>
 
@@ -11,6 +12,8 @@
 # include <cryptography/fwd.hh>
 # include <cryptography/Oneway.hh>
 # include <cryptography/Cipher.hh>
+# include <cryptography/Executor.hh>
+# include <cryptography/dsa/Parameters.hh>
 # include <cryptography/dsa/PublicKey.hh>
 # include <cryptography/dsa/PrivateKey.hh>
 # include <cryptography/dsa/defaults.hh>
@@ -124,6 +127,31 @@ namespace infinit
         generate(uint32_t const length,
                  Oneway const digest_algorithm =
                    defaults::digest_algorithm);
+        /// Return a freshly generated DSA key pair based on the given
+        /// parameters, sparing their generation.
+        KeyPair
+        generate(Parameters const& parameters,
+                 Oneway const digest_algorithm =
+                   defaults::digest_algorithm);
+        /// Generate a key pair on the key generation executor, returning
+        /// a future on it.
+        ///
+        /// Note that the generation of the parameters is aborted as soon as
+        /// its cancellation is requested.
+        std::future<KeyPair>
+        generate_async(uint32_t const length,
+                       Oneway const digest_algorithm =
+                         defaults::digest_algorithm,
+                       Priority const priority = Priority::normal,
+                       Cancellation const& cancellation = Cancellation());
+        /// Generate a key pair based on the given parameters on the key
+        /// generation executor, returning a future on it.
+        std::future<KeyPair>
+        generate_async(Parameters const& parameters,
+                       Oneway const digest_algorithm =
+                         defaults::digest_algorithm,
+                       Priority const priority = Priority::normal,
+                       Cancellation const& cancellation = Cancellation());
       }
     }
   }
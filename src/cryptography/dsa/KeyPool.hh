@@ -0,0 +1,50 @@
+#ifndef INFINIT_CRYPTOGRAPHY_DSA_KEYPOOL_HH
+# define INFINIT_CRYPTOGRAPHY_DSA_KEYPOOL_HH
+
+# include <cryptography/Pool.hh>
+# include <cryptography/dsa/KeyPair.hh>
+# include <cryptography/dsa/defaults.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      /// A pool of DSA key pairs, including the generation of their
+      /// parameters unless shared parameters are provided.
+      class KeyPool
+        : public Pool<KeyPair>
+      {
+      public:
+        KeyPool(uint32_t const length,
+                Oneway const digest_algorithm = defaults::digest_algorithm,
+                pool::Configuration const& configuration =
+                  pool::Configuration())
+        : Pool<KeyPair>(
+            [length, digest_algorithm]
+            {
+              return keypair::generate(length, digest_algorithm);
+            },
+            configuration)
+        {}
+
+        /// Construct a pool of key pairs sharing the given parameters, only
+        /// the key pairs being generated.
+        KeyPool(Parameters const& parameters,
+                Oneway const digest_algorithm = defaults::digest_algorithm,
+                pool::Configuration const& configuration =
+                  pool::Configuration())
+        : Pool<KeyPair>(
+            [parameters, digest_algorithm]
+            {
+              return keypair::generate(parameters, digest_algorithm);
+            },
+            configuration)
+        {}
+      };
+    }
+  }
+}
+
+#endif
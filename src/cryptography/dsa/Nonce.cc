@@ -0,0 +1,160 @@
+#include <cryptography/dsa/Nonce.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/finally.hh>
+
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/dsa.h>
+#include <openssl/err.h>
+
+#include <algorithm>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.dsa.Nonce");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace nonce
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        Nonce
+        generate(::DSA* dsa)
+        {
+          ELLE_ASSERT_NEQ(dsa, nullptr);
+
+          ::BIGNUM* kinv = nullptr;
+          ::BIGNUM* r = nullptr;
+
+          if (::DSA_sign_setup(dsa, nullptr, &kinv, &r) <= 0)
+            throw Error(
+              elle::sprintf("unable to precompute the signature nonce: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          Nonce nonce;
+
+          nonce.kinv.reset(kinv);
+          nonce.r.reset(r);
+
+          return (nonce);
+        }
+
+        elle::Buffer
+        sign(::DSA* dsa,
+             elle::ConstWeakBuffer const& digest,
+             Nonce const& nonce)
+        {
+          ELLE_ASSERT_NEQ(dsa, nullptr);
+          ELLE_ASSERT_NEQ(dsa->priv_key, nullptr);
+          ELLE_ASSERT_NEQ(nonce.kinv, nullptr);
+          ELLE_ASSERT_NEQ(nonce.r, nullptr);
+
+          ::BN_CTX* context = ::BN_CTX_new();
+          if (context == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the BN context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+          ::DSA_SIG* signature = ::DSA_SIG_new();
+          if (signature == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the DSA signature: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DSA_SIG(signature);
+
+          ::BIGNUM* m = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(m);
+          ::BIGNUM* blind = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(blind);
+          ::BIGNUM* blindm = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(blindm);
+          ::BIGNUM* tmp = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(tmp);
+
+          if ((m == nullptr) ||
+              (blind == nullptr) ||
+              (blindm == nullptr) ||
+              (tmp == nullptr) ||
+              ((signature->r = ::BN_dup(nonce.r.get())) == nullptr) ||
+              ((signature->s = ::BN_new()) == nullptr))
+            throw Error(
+              elle::sprintf("unable to allocate the big numbers: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // As OpenSSL does, keep the digest's leftmost bytes should it be
+          // longer than the subgroup order.
+          std::size_t const size =
+            std::min<std::size_t>(digest.size(), BN_num_bytes(dsa->q));
+
+          if (::BN_bin2bn(digest.contents(), size, m) == nullptr)
+            throw Error(
+              elle::sprintf("unable to convert the digest: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Generate a non-null blinding value so that the arithmetic
+          // involving the private key does not leak it through its timing,
+          // as OpenSSL's own signature does since CVE-2018-0495.
+          do
+          {
+            if (::BN_rand(blind, BN_num_bits(dsa->q) - 1, -1, 0) <= 0)
+              throw Error(
+                elle::sprintf("unable to generate the blinding value: %s",
+                              ::ERR_error_string(ERR_get_error(),
+                                                 nullptr)));
+          } while (::BN_is_zero(blind));
+
+          BN_set_flags(blind, BN_FLG_CONSTTIME);
+          BN_set_flags(blindm, BN_FLG_CONSTTIME);
+          BN_set_flags(tmp, BN_FLG_CONSTTIME);
+
+          // Compute s = k^-1 (m + x r) mod q, blinded as
+          // s = b^-1 k^-1 (b m + b x r) mod q.
+          if ((::BN_mod_mul(tmp, blind, dsa->priv_key,
+                            dsa->q, context) <= 0) ||
+              (::BN_mod_mul(tmp, tmp, nonce.r.get(),
+                            dsa->q, context) <= 0) ||
+              (::BN_mod_mul(blindm, blind, m,
+                            dsa->q, context) <= 0) ||
+              (::BN_mod_add_quick(signature->s, tmp, blindm,
+                                  dsa->q) <= 0) ||
+              (::BN_mod_mul(signature->s, signature->s, nonce.kinv.get(),
+                            dsa->q, context) <= 0) ||
+              (::BN_mod_inverse(blind, blind, dsa->q, context) == nullptr) ||
+              (::BN_mod_mul(signature->s, signature->s, blind,
+                            dsa->q, context) <= 0))
+            throw Error(
+              elle::sprintf("unable to compute the signature: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // The probability is negligible but a null s would reveal nothing
+          // while being rejected by the verifiers.
+          if (::BN_is_zero(signature->s))
+            throw Error("the signature nonce yields an invalid signature");
+
+          unsigned char* buffer = nullptr;
+          int length = 0;
+
+          if ((length = ::i2d_DSA_SIG(signature, &buffer)) <= 0)
+            throw Error(
+              elle::sprintf("unable to encode the signature: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(buffer);
+
+          return (elle::Buffer(buffer, length));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef INFINIT_CRYPTOGRAPHY_DSA_NONCE_HH
+# define INFINIT_CRYPTOGRAPHY_DSA_NONCE_HH
+
+# include <openssl/dsa.h>
+
+# include <elle/Buffer.hh>
+
+# include <cryptography/types.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      /*--------.
+      | Structs |
+      `--------*/
+
+      /// The part of a DSA signature which does not depend on the message:
+      /// the inverse of the per-signature secret k and r = (g^k mod p) mod q.
+      ///
+      /// WARNING: A nonce must be used for a single signature, the private
+      ///          key being recoverable from two signatures sharing it.
+      struct Nonce
+      {
+        types::BIGNUM kinv;
+        types::BIGNUM r;
+      };
+
+      namespace nonce
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Return a fresh nonce for the given key.
+        Nonce
+        generate(::DSA* dsa);
+        /// Return the DER-encoded signature of the given digest, completing
+        /// the nonce with the modular arithmetic depending on the message,
+        /// blinded as OpenSSL does so as not to leak the private key through
+        /// timing.
+        elle::Buffer
+        sign(::DSA* dsa,
+             elle::ConstWeakBuffer const& digest,
+             Nonce const& nonce);
+      }
+    }
+  }
+}
+
+#endif
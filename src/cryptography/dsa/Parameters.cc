@@ -0,0 +1,336 @@
+#include <openssl/dh.h>
+#include <openssl/dsa.h>
+#include <openssl/err.h>
+
+#include <elle/log.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/Executor.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/dsa/Parameters.hh>
+#include <cryptography/dsa/der.hh>
+#include <cryptography/dsa/serialization.hh>
+#include <cryptography/finally.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.dsa.Parameters");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace parameters
+      {
+        /*--------------.
+        | Serialization |
+        `--------------*/
+
+        struct Serialization:
+          public dsa::serialization::DSA
+        {
+          static
+          elle::Buffer
+          encode(::DSA* dsa)
+          {
+            return der::encode_parameters(dsa);
+          }
+
+          static
+          ::DSA*
+          decode(elle::ConstWeakBuffer const& buffer)
+          {
+            return der::decode_parameters(buffer);
+          }
+        };
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      Parameters::Parameters(::DSA* dsa)
+      {
+        ELLE_ASSERT_NEQ(dsa, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        this->_construct(dsa);
+
+        this->_check();
+      }
+
+      Parameters::Parameters(Parameters const& other)
+      {
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Duplicate the DSA structure.
+        ::DSA* _dsa = ::DSAparams_dup(other._key->pkey.dsa);
+        if (_dsa == nullptr)
+          throw Error(
+            elle::sprintf("unable to duplicate the DSA parameters: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DSA(_dsa);
+
+        this->_construct(_dsa);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_dsa);
+
+        this->_check();
+      }
+
+      Parameters::Parameters(Parameters&& other):
+        _key(std::move(other._key))
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        this->_check();
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      void
+      Parameters::_construct(::DSA* dsa)
+      {
+        ELLE_ASSERT_NEQ(dsa, nullptr);
+
+        // Initialise the parameters' EVP structure.
+        ELLE_ASSERT_EQ(this->_key, nullptr);
+        this->_key.reset(::EVP_PKEY_new());
+
+        if (this->_key == nullptr)
+          throw Error(
+            elle::sprintf("unable to allocate the EVP_PKEY structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        // Set the DSA structure into the EVP key.
+        if (::EVP_PKEY_assign_DSA(this->_key.get(), dsa) <= 0)
+          throw Error(
+            elle::sprintf("unable to assign the DSA parameters to the "
+                          "EVP_PKEY structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      void
+      Parameters::_check() const
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.dsa, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.dsa->p, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.dsa->q, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.dsa->g, nullptr);
+      }
+
+      uint32_t
+      Parameters::length() const
+      {
+        return (static_cast<uint32_t>(
+                  ::BN_num_bits(this->_key->pkey.dsa->p)));
+      }
+
+      uint32_t
+      Parameters::order() const
+      {
+        return (static_cast<uint32_t>(
+                  ::BN_num_bits(this->_key->pkey.dsa->q)));
+      }
+
+      /*----------.
+      | Operators |
+      `----------*/
+
+      bool
+      Parameters::operator ==(Parameters const& other) const
+      {
+        if (this == &other)
+          return (true);
+
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        return (::EVP_PKEY_cmp_parameters(this->_key.get(),
+                                          other._key.get()) == 1);
+      }
+
+      /*--------------.
+      | Serialization |
+      `--------------*/
+
+      Parameters::Parameters(elle::serialization::SerializerIn& serializer)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Allocate the EVP key to receive the deserialized's DSA structure.
+        this->_key.reset(::EVP_PKEY_new());
+
+        // Set the EVP key as being of type DSA.
+        if (::EVP_PKEY_set_type(this->_key.get(), EVP_PKEY_DSA) <= 0)
+          throw Error(
+            elle::sprintf("unable to set the EVP key's type: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        this->serialize(serializer);
+
+        this->_check();
+      }
+
+      void
+      Parameters::serialize(elle::serialization::Serializer& serializer)
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+
+        cryptography::serialize<parameters::Serialization>(
+          serializer,
+          this->_key->pkey.dsa);
+        ELLE_ASSERT_NEQ(this->_key->pkey.dsa, nullptr);
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      Parameters::print(std::ostream& stream) const
+      {
+        stream << "("
+               << this->length()
+               << ", "
+               << this->order()
+               << ")";
+      }
+
+      namespace parameters
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        Parameters
+        generate(uint32_t const length)
+        {
+          ELLE_TRACE_SCOPE("generate %s-bit parameters", length);
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::EVP_PKEY* parameters = nullptr;
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY(parameters);
+
+          ::EVP_PKEY_CTX* context;
+
+          if ((context =
+               ::EVP_PKEY_CTX_new_id(EVP_PKEY_DSA, nullptr)) == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate a parameters generation "
+                            "context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY_CONTEXT(context);
+
+          if (::EVP_PKEY_paramgen_init(context) <= 0)
+            throw Error(
+              elle::sprintf("unable to initialize the parameters generation "
+                            "context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::EVP_PKEY_CTX_set_dsa_paramgen_bits(context, length) <= 0)
+            throw Error(
+              elle::sprintf("unable to set the parameters generation "
+                            "context's key length: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Abort the generation should the task running it be cancelled.
+          ::EVP_PKEY_CTX_set_cb(context, cancellation::callback);
+
+          if (::EVP_PKEY_paramgen(context, &parameters) <= 0)
+            throw Error(
+              elle::sprintf("unable to generate the parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Retrieve the DSA structure, increasing its reference counter so
+          // that it survives the EVP key.
+          ::DSA* dsa = ::EVP_PKEY_get1_DSA(parameters);
+          if (dsa == nullptr)
+            throw Error(
+              elle::sprintf("unable to retrieve the DSA parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DSA(dsa);
+
+          Parameters result(dsa);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(dsa);
+
+          return (result);
+        }
+
+        Parameters
+        standard(uint32_t const length)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::DH* dh = nullptr;
+
+          switch (length)
+          {
+            case 1024:
+            {
+              dh = ::DH_get_1024_160();
+              break;
+            }
+            case 2048:
+            {
+              dh = ::DH_get_2048_256();
+              break;
+            }
+            default:
+              throw Error(
+                elle::sprintf("no standard DSA parameters of length %s",
+                              length));
+          }
+
+          if (dh == nullptr)
+            throw Error(
+              elle::sprintf("unable to retrieve the standard parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DH(dh);
+
+          ::DSA* dsa = ::DSA_new();
+          if (dsa == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the DSA structure: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DSA(dsa);
+
+          // The RFC 5114 groups come with the order of their subgroup,
+          // which makes them suitable for DSA.
+          if (((dsa->p = ::BN_dup(dh->p)) == nullptr) ||
+              ((dsa->q = ::BN_dup(dh->q)) == nullptr) ||
+              ((dsa->g = ::BN_dup(dh->g)) == nullptr))
+            throw Error(
+              elle::sprintf("unable to copy the standard parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          Parameters result(dsa);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(dsa);
+
+          return (result);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+#ifndef INFINIT_CRYPTOGRAPHY_DSA_PARAMETERS_HH
+# define INFINIT_CRYPTOGRAPHY_DSA_PARAMETERS_HH
+
+# include <utility>
+
+# include <openssl/dsa.h>
+# include <openssl/evp.h>
+
+# include <elle/types.hh>
+# include <elle/attribute.hh>
+# include <elle/operator.hh>
+# include <elle/serialization.hh>
+
+ELLE_OPERATOR_RELATIONALS();
+
+# include <cryptography/fwd.hh>
+# include <cryptography/types.hh>
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      /// The domain parameters p, q and g of the DSA cryptosystem.
+      ///
+      /// Generating the parameters being far more expensive than generating
+      /// a key pair based on them, the parameters can be generated once, or
+      /// taken from the standard sets, and shared by many key pairs, see
+      /// keypair::generate().
+      class Parameters:
+        public elle::Printable
+      {
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        /// Construct the parameters based on the given DSA structure whose
+        /// ownership is transferred.
+        explicit
+        Parameters(::DSA* dsa);
+        Parameters(Parameters const& other);
+        Parameters(Parameters&& other);
+        virtual
+        ~Parameters() = default;
+
+        /*--------.
+        | Methods |
+        `--------*/
+      private:
+        /// Construct the object based on the given DSA structure whose
+        /// ownership is transferred to the callee.
+        void
+        _construct(::DSA* dsa);
+        /// Check that the parameters are valid.
+        void
+        _check() const;
+      public:
+        /// Return the length of the prime modulus p, in bits.
+        uint32_t
+        length() const;
+        /// Return the length of the subgroup order q, in bits.
+        uint32_t
+        order() const;
+
+        /*----------.
+        | Operators |
+        `----------*/
+      public:
+        bool
+        operator ==(Parameters const& other) const;
+        ELLE_OPERATOR_NO_ASSIGNMENT(Parameters);
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*-------------.
+        | Serializable |
+        `-------------*/
+      public:
+        Parameters(elle::serialization::SerializerIn& serializer);
+        void
+        serialize(elle::serialization::Serializer& serializer);
+        typedef elle::serialization_tag serialization_tag;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      private:
+        /// The EVP key holding the parameters only, from which key pairs
+        /// are generated.
+        ELLE_ATTRIBUTE_R(types::EVP_PKEY, key);
+      };
+    }
+  }
+}
+
+//
+// ---------- Generator -------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace parameters
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Return freshly generated parameters whose prime modulus is of
+        /// the given length, in bits.
+        ///
+        /// Note that the generation is aborted should the task running it
+        /// be cancelled, see Executor.
+        Parameters
+        generate(uint32_t const length);
+        /// Return the standard parameters whose prime modulus is of the
+        /// given length i.e the 1024-bit MODP group with a 160-bit prime
+        /// order subgroup and the 2048-bit one with a 256-bit subgroup, as
+        /// defined by RFC 5114.
+        Parameters
+        standard(uint32_t const length);
+      }
+    }
+  }
+}
+
+#endif
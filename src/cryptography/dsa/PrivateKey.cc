@@ -9,6 +9,7 @@
 #include <cryptography/bn.hh>
 #include <cryptography/cryptography.hh>
 #include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/dsa/Nonce.hh>
 #include <cryptography/dsa/PrivateKey.hh>
 #include <cryptography/dsa/der.hh>
 #include <cryptography/dsa/low.hh>
@@ -112,7 +113,8 @@ namespace infinit
 
       PrivateKey::PrivateKey(PrivateKey&& other):
         _key(std::move(other._key)),
-        _digest_algorithm(std::move(other._digest_algorithm))
+        _digest_algorithm(std::move(other._digest_algorithm)),
+        _nonces(std::move(other._nonces))
       {
         // Make sure the cryptographic system is set up.
         cryptography::require();
@@ -166,12 +168,40 @@ namespace infinit
       elle::Buffer
       PrivateKey::sign(std::istream& plain) const
       {
+        if (this->_nonces != nullptr)
+        {
+          elle::Buffer digest =
+            raw::hash(oneway::resolve(this->_digest_algorithm), plain);
+
+          return (nonce::sign(this->_key->pkey.dsa,
+                              digest,
+                              this->_nonces->get()));
+        }
+
         return (raw::asymmetric::sign(
                   this->_key.get(),
                   oneway::resolve(this->_digest_algorithm),
                   plain));
       }
 
+      void
+      PrivateKey::precompute(pool::Configuration const& configuration)
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+
+        // Capture the DSA structure rather than the key so that the
+        // producers keep working should the key be moved.
+        ::DSA* dsa = this->_key->pkey.dsa;
+
+        this->_nonces.reset(
+          new Pool<Nonce>(
+            [dsa]
+            {
+              return nonce::generate(dsa);
+            },
+            configuration));
+      }
+
       uint32_t
       PrivateKey::size() const
       {
@@ -1,6 +1,7 @@
 #ifndef INFINIT_CRYPTOGRAPHY_DSA_PRIVATEKEY_HH
 # define INFINIT_CRYPTOGRAPHY_DSA_PRIVATEKEY_HH
 
+# include <memory>
 # include <utility>
 
 # include <openssl/evp.h>
@@ -16,6 +17,8 @@ ELLE_OPERATOR_RELATIONALS();
 # include <cryptography/types.hh>
 # include <cryptography/Oneway.hh>
 # include <cryptography/Cipher.hh>
+# include <cryptography/Pool.hh>
+# include <cryptography/dsa/Nonce.hh>
 
 //
 // ---------- Class -----------------------------------------------------------
@@ -68,6 +71,18 @@ namespace infinit
         /// Sign a stream-based plain text.
         elle::Buffer
         sign(std::istream& plain) const;
+        /// Start generating signature nonces in the background so that
+        /// sign() is left with the message-dependent arithmetic only, each
+        /// nonce being used for a single signature.
+        ///
+        /// Note that copies of the key do not inherit the precomputation.
+        ///
+        /// WARNING: This method replaces the pool of nonces and must
+        ///          therefore not be called while other threads are
+        ///          signing with the key.
+        void
+        precompute(pool::Configuration const& configuration =
+                     pool::Configuration());
         /// Return the private key's size in bytes.
         uint32_t
         size() const;
@@ -105,6 +120,9 @@ namespace infinit
       private:
         ELLE_ATTRIBUTE_R(types::EVP_PKEY, key);
         ELLE_ATTRIBUTE_R(Oneway, digest_algorithm);
+        /// The precomputed nonces, if enabled. Declared after the key so as
+        /// to stop the producers before the key is released.
+        std::unique_ptr<Pool<Nonce>> _nonces;
       };
     }
   }
@@ -2,6 +2,9 @@
 # define INFINIT_CRYPTOGRAPHY_DSA_ALL_HH
 
 # include <cryptography/dsa/KeyPair.hh>
+# include <cryptography/dsa/KeyPool.hh>
+# include <cryptography/dsa/Nonce.hh>
+# include <cryptography/dsa/Parameters.hh>
 # include <cryptography/dsa/PrivateKey.hh>
 # include <cryptography/dsa/PublicKey.hh>
 # include <cryptography/dsa/pem.hh>
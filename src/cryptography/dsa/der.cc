@@ -88,6 +88,42 @@ namespace infinit
 
           return (dsa);
         }
+
+        elle::Buffer
+        encode_parameters(::DSA* dsa)
+        {
+          unsigned char* _buffer = nullptr;
+
+          int _size = ::i2d_DSAparams(dsa, &_buffer);
+          if (_size <= 0)
+            throw Error(
+              elle::sprintf("unable to encode the DSA parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_buffer);
+
+          elle::Buffer buffer(_buffer, _size);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_buffer);
+          ::OPENSSL_free(_buffer);
+
+          return (buffer);
+        }
+
+        ::DSA*
+        decode_parameters(elle::ConstWeakBuffer const& buffer)
+        {
+          const unsigned char* _buffer = buffer.contents();
+          long _size = buffer.size();
+
+          ::DSA* dsa = nullptr;
+          if ((dsa = ::d2i_DSAparams(NULL, &_buffer, _size)) == NULL)
+            throw Error(
+              elle::sprintf("unable to decode the DSA parameters: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (dsa);
+        }
       }
     }
   }
@@ -33,6 +33,13 @@ namespace infinit
         /// Decode the DSA private key from a DER-based buffer.
         ::DSA*
         decode_private(elle::ConstWeakBuffer const& buffer);
+        /// Encode the given DSA structure's domain parameters into a
+        /// binary-based format.
+        elle::Buffer
+        encode_parameters(::DSA* dsa);
+        /// Decode the DSA domain parameters from a DER-based buffer.
+        ::DSA*
+        decode_parameters(elle::ConstWeakBuffer const& buffer);
       }
     }
   }
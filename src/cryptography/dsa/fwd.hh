@@ -7,6 +7,7 @@ namespace infinit
   {
     namespace dsa
     {
+      class Parameters;
       class PrivateKey;
       class PublicKey;
       class KeyPair;
@@ -0,0 +1,88 @@
+#include <ostream>
+
+#include <openssl/obj_mac.h>
+
+#include <elle/assert.hh>
+#include <elle/printf.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/ec/Curve.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /*----------.
+      | Operators |
+      `----------*/
+
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Curve const curve)
+      {
+        switch (curve)
+        {
+          case Curve::p256:
+          {
+            stream << "P-256";
+            break;
+          }
+          case Curve::p384:
+          {
+            stream << "P-384";
+            break;
+          }
+          default:
+            throw Error(elle::sprintf("unknown elliptic curve '%s'",
+                                      static_cast<int>(curve)));
+        }
+
+        return (stream);
+      }
+
+      namespace curve
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        int
+        resolve(Curve const curve)
+        {
+          switch (curve)
+          {
+            case Curve::p256:
+              return (NID_X9_62_prime256v1);
+            case Curve::p384:
+              return (NID_secp384r1);
+            default:
+              throw Error(elle::sprintf("unable to resolve the given "
+                                        "elliptic curve '%s'",
+                                        static_cast<int>(curve)));
+          }
+
+          elle::unreachable();
+        }
+
+        Curve
+        resolve(int const nid)
+        {
+          switch (nid)
+          {
+            case NID_X9_62_prime256v1:
+              return (Curve::p256);
+            case NID_secp384r1:
+              return (Curve::p384);
+            default:
+              throw Error(elle::sprintf("unsupported elliptic curve NID %s",
+                                        nid));
+          }
+
+          elle::unreachable();
+        }
+      }
+    }
+  }
+}
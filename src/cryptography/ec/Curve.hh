@@ -0,0 +1,50 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_CURVE_HH
+# define INFINIT_CRYPTOGRAPHY_EC_CURVE_HH
+
+# include <iosfwd>
+
+# include <elle/types.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /*-------------.
+      | Enumerations |
+      `-------------*/
+
+      /// Define the elliptic curve the keys are defined over.
+      enum class Curve
+      {
+        p256,
+        p384
+      };
+
+      /*----------.
+      | Operators |
+      `----------*/
+
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Curve const curve);
+
+      namespace curve
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Resolve a curve into its OpenSSL NID.
+        int
+        resolve(Curve const curve);
+        /// Return the curve corresponding to the given NID.
+        Curve
+        resolve(int const nid);
+      }
+    }
+  }
+}
+
+#endif
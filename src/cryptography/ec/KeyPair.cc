@@ -0,0 +1,224 @@
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/finally.hh>
+#include <cryptography/deleter.hh>
+#include <cryptography/types.hh>
+
+#include <elle/attribute.hh>
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+#include <openssl/ec.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      KeyPair::KeyPair(PublicKey const& K,
+                       PrivateKey const& k):
+        _K(new PublicKey(K)),
+        _k(new PrivateKey(k))
+      {
+      }
+
+      KeyPair::KeyPair(PublicKey&& K,
+                       PrivateKey&& k):
+        _K(new PublicKey(std::move(K))),
+        _k(new PrivateKey(std::move(k)))
+      {
+      }
+
+      KeyPair::KeyPair(KeyPair const& other):
+        _K(new PublicKey(*other._K)),
+        _k(new PrivateKey(*other._k))
+      {
+      }
+
+      KeyPair::KeyPair(KeyPair&& other):
+        _K(std::move(other._K)),
+        _k(std::move(other._k))
+      {
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      PublicKey const&
+      KeyPair::K() const
+      {
+        ELLE_ASSERT_NEQ(this->_K, nullptr);
+
+        return (*this->_K);
+      }
+
+      PrivateKey const&
+      KeyPair::k() const
+      {
+        ELLE_ASSERT_NEQ(this->_k, nullptr);
+
+        return (*this->_k);
+      }
+
+      uint32_t
+      KeyPair::size() const
+      {
+        ELLE_ASSERT_NEQ(this->_K, nullptr);
+        ELLE_ASSERT_NEQ(this->_k, nullptr);
+        ELLE_ASSERT_EQ(this->_K->size(), this->_k->size());
+
+        return (this->_K->size());
+      }
+
+      uint32_t
+      KeyPair::length() const
+      {
+        ELLE_ASSERT_NEQ(this->_K, nullptr);
+        ELLE_ASSERT_NEQ(this->_k, nullptr);
+        ELLE_ASSERT_EQ(this->_K->length(), this->_k->length());
+
+        return (this->_K->length());
+      }
+
+      /*----------.
+      | Operators |
+      `----------*/
+
+      bool
+      KeyPair::operator ==(KeyPair const& other) const
+      {
+        if (this == &other)
+          return (true);
+
+        ELLE_ASSERT_NEQ(this->_K, nullptr);
+        ELLE_ASSERT_NEQ(this->_k, nullptr);
+
+        // The public component is enough to uniquely identify a key pair.
+        return (*this->_K == *other._K);
+      }
+
+      /*--------------.
+      | Serialization |
+      `--------------*/
+
+      KeyPair::KeyPair(elle::serialization::SerializerIn& serializer):
+        _K(),
+        _k()
+      {
+        this->serialize(serializer);
+      }
+
+      void
+      KeyPair::serialize(elle::serialization::Serializer& serializer)
+      {
+        serializer.serialize("public key", this->_K);
+        if (this->_K == nullptr)
+          throw Error(
+            elle::sprintf("unable to deserialize the 'public key'"));
+
+        serializer.serialize("private key", this->_k);
+        if (this->_k == nullptr)
+          throw Error(
+            elle::sprintf("unable to deserialize the 'private key'"));
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      KeyPair::print(std::ostream& stream) const
+      {
+        ELLE_ASSERT_NEQ(this->_K, nullptr);
+        ELLE_ASSERT_NEQ(this->_k, nullptr);
+
+        stream << "(" << *this->_K << ", " << *this->_k << ")";
+      }
+    }
+  }
+}
+
+//
+// ---------- Generator -------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace keypair
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        KeyPair
+        generate(Curve const curve,
+                 Oneway const digest_algorithm)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::EC_KEY* ec = ::EC_KEY_new_by_curve_name(curve::resolve(curve));
+
+          if (ec == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the EC key over %s: %s",
+                            curve,
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(ec);
+
+          // Reference the curve by its name in the encoded keys rather than
+          // embedding its explicit parameters.
+          ::EC_KEY_set_asn1_flag(ec, OPENSSL_EC_NAMED_CURVE);
+          // Encode the public points in their compressed form, halving the
+          // size of the public keys exchanged during key agreements.
+          ::EC_KEY_set_conv_form(ec, POINT_CONVERSION_COMPRESSED);
+
+          if (::EC_KEY_generate_key(ec) <= 0)
+            throw Error(
+              elle::sprintf("unable to generate a keypair: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Instanciate both an EC public and private key based on the
+          // EC key.
+          PrivateKey k(ec,
+                       digest_algorithm);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(ec);
+
+          PublicKey K(k);
+
+          return (KeyPair(std::move(K), std::move(k)));
+        }
+
+        std::future<KeyPair>
+        generate_async(Curve const curve,
+                       Oneway const digest_algorithm,
+                       Priority const priority,
+                       Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [curve, digest_algorithm]
+                    {
+                      return (generate(curve, digest_algorithm));
+                    },
+                    priority,
+                    cancellation));
+        }
+      }
+    }
+  }
+}
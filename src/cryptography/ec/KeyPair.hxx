@@ -0,0 +1,21 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_KEYPAIR_HXX
+# define INFINIT_CRYPTOGRAPHY_EC_KEYPAIR_HXX
+
+//
+// ---------- Hash ------------------------------------------------------------
+//
+
+namespace std
+{
+  template <>
+  struct hash<infinit::cryptography::ec::KeyPair>
+  {
+    size_t
+    operator ()(infinit::cryptography::ec::KeyPair const& value) const
+    {
+      return (std::hash<infinit::cryptography::ec::PublicKey>()(value.K()));
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_KEYPOOL_HH
+# define INFINIT_CRYPTOGRAPHY_EC_KEYPOOL_HH
+
+# include <cryptography/Pool.hh>
+# include <cryptography/ec/KeyPair.hh>
+# include <cryptography/ec/defaults.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// A pool of EC key pairs over a given curve.
+      class KeyPool
+        : public Pool<KeyPair>
+      {
+      public:
+        KeyPool(Curve const curve = defaults::curve,
+                Oneway const digest_algorithm = defaults::digest_algorithm,
+                pool::Configuration const& configuration =
+                  pool::Configuration())
+        : Pool<KeyPair>(
+            [curve, digest_algorithm]
+            {
+              return keypair::generate(curve, digest_algorithm);
+            },
+            configuration)
+        {}
+      };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,335 @@
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/err.h>
+
+#include <sstream>
+
+#include <elle/IOStream.hh>
+#include <elle/log.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/context.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/ec/PrivateKey.hh>
+#include <cryptography/ec/PublicKey.hh>
+#include <cryptography/ec/der.hh>
+#include <cryptography/ec/deterministic.hh>
+#include <cryptography/ec/ecies.hh>
+#include <cryptography/ec/low.hh>
+#include <cryptography/ec/serialization.hh>
+#include <cryptography/finally.hh>
+#include <cryptography/raw.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace privatekey
+      {
+        /*--------------.
+        | Serialization |
+        `--------------*/
+
+        struct Serialization:
+          public ec::serialization::EC
+        {
+          static
+          elle::Buffer
+          encode(::EC_KEY* ec)
+          {
+            return der::encode_private(ec);
+          }
+
+          static
+          ::EC_KEY*
+          decode(elle::ConstWeakBuffer const& buffer)
+          {
+            return der::decode_private(buffer);
+          }
+        };
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      PrivateKey::PrivateKey(::EVP_PKEY* key,
+                             Oneway const digest_algorithm):
+        _key(key),
+        _digest_algorithm(digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(key, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        if (::EVP_PKEY_type(this->_key->type) != EVP_PKEY_EC)
+          throw Error(
+            elle::sprintf("the EVP_PKEY key is not of type EC: %s",
+                          ::EVP_PKEY_type(this->_key->type)));
+
+        this->_check();
+      }
+
+      PrivateKey::PrivateKey(::EC_KEY* ec,
+                             Oneway const digest_algorithm):
+        _digest_algorithm(digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(ec, nullptr);
+        ELLE_ASSERT_NEQ(::EC_KEY_get0_private_key(ec), nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Construct the private key based on the given EC structure.
+        this->_construct(ec);
+
+        this->_check();
+      }
+
+      PrivateKey::PrivateKey(PrivateKey const& other):
+        _digest_algorithm(other._digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Duplicate the EC structure.
+        ::EC_KEY* _ec = low::EC_KEY_dup(other._key->pkey.ec);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(_ec);
+
+        this->_construct(_ec);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_ec);
+
+        this->_check();
+      }
+
+      PrivateKey::PrivateKey(PrivateKey&& other):
+        _key(std::move(other._key)),
+        _digest_algorithm(std::move(other._digest_algorithm))
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        this->_check();
+      }
+
+      PrivateKey::~PrivateKey()
+      {
+        context::cache::invalidate(this->_key.get());
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      void
+      PrivateKey::_construct(::EC_KEY* ec)
+      {
+        ELLE_ASSERT_NEQ(ec, nullptr);
+
+        // Initialise the private key structure.
+        ELLE_ASSERT_EQ(this->_key, nullptr);
+        this->_key.reset(::EVP_PKEY_new());
+
+        if (this->_key == nullptr)
+          throw Error(
+            elle::sprintf("unable to allocate the EVP_PKEY structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        // Set the EC structure into the private key.
+        if (::EVP_PKEY_assign_EC_KEY(this->_key.get(), ec) <= 0)
+          throw Error(
+            elle::sprintf("unable to assign the EC key to the EVP_PKEY "
+                          "structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      void
+      PrivateKey::_check() const
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+        ELLE_ASSERT_NEQ(::EC_KEY_get0_public_key(this->_key->pkey.ec),
+                        nullptr);
+        ELLE_ASSERT_NEQ(::EC_KEY_get0_private_key(this->_key->pkey.ec),
+                        nullptr);
+      }
+
+      elle::Buffer
+      PrivateKey::open(elle::ConstWeakBuffer const& code) const
+      {
+        elle::IOStream _code(code.istreambuf());
+        std::stringstream _plain;
+
+        this->open(_code, _plain);
+
+        return (elle::Buffer(_plain.str().data(), _plain.str().length()));
+      }
+
+      void
+      PrivateKey::open(std::istream& code,
+                       std::ostream& plain) const
+      {
+        ecies::open(this->_key->pkey.ec, code, plain);
+      }
+
+      elle::Buffer
+      PrivateKey::sign(elle::ConstWeakBuffer const& plain) const
+      {
+        elle::IOStream _plain(plain.istreambuf());
+
+        return (this->sign(_plain));
+      }
+
+      elle::Buffer
+      PrivateKey::sign(std::istream& plain) const
+      {
+        ::EVP_MD const* oneway = oneway::resolve(this->_digest_algorithm);
+
+        return (deterministic::sign(this->_key->pkey.ec,
+                                    oneway,
+                                    raw::hash(oneway, plain)));
+      }
+
+      elle::Buffer
+      PrivateKey::_sign(std::function<void (std::ostream&)> const& plain) const
+      {
+        ::EVP_MD const* oneway = oneway::resolve(this->_digest_algorithm);
+
+        return (deterministic::sign(this->_key->pkey.ec,
+                                    oneway,
+                                    raw::hash(oneway, plain)));
+      }
+
+      SecretKey
+      PrivateKey::agree(PublicKey const& peer_K) const
+      {
+        if (peer_K.curve() != this->curve())
+          throw Error(
+            elle::sprintf("unable to agree with a key over %s from a key "
+                          "over %s",
+                          peer_K.curve(), this->curve()));
+
+        elle::Buffer secret;
+
+        context::cache::apply(
+          this->_key.get(),
+          ::EVP_PKEY_derive_init,
+          0,
+          nullptr,
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            secret = raw::asymmetric::agree(context, peer_K.key().get());
+          });
+
+        return (SecretKey(std::move(secret)));
+      }
+
+      Curve
+      PrivateKey::curve() const
+      {
+        return (curve::resolve(
+                  ::EC_GROUP_get_curve_name(
+                    ::EC_KEY_get0_group(this->_key->pkey.ec))));
+      }
+
+      uint32_t
+      PrivateKey::size() const
+      {
+        return (static_cast<uint32_t>(
+                  ::EVP_PKEY_size(this->_key.get())));
+      }
+
+      uint32_t
+      PrivateKey::length() const
+      {
+        return (static_cast<uint32_t>(
+                  ::EVP_PKEY_bits(this->_key.get())));
+      }
+
+      /*----------.
+      | Operators |
+      `----------*/
+
+      bool
+      PrivateKey::operator ==(PrivateKey const& other) const
+      {
+        if (this == &other)
+          return (true);
+
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        // Compare the public components because it is sufficient to
+        // uniquely distinguish keys.
+        return (::EVP_PKEY_cmp(this->_key.get(), other._key.get()) == 1);
+      }
+
+      /*--------------.
+      | Serialization |
+      `--------------*/
+
+      PrivateKey::PrivateKey(elle::serialization::SerializerIn& serializer)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Allocate the EVP key to receive the deserialized's EC structure.
+        this->_key.reset(::EVP_PKEY_new());
+
+        // Set the EVP key as being of type EC.
+        if (::EVP_PKEY_set_type(this->_key.get(), EVP_PKEY_EC) <= 0)
+          throw Error(
+            elle::sprintf("unable to set the EVP key's type: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        this->serialize(serializer);
+
+        this->_check();
+      }
+
+      void
+      PrivateKey::serialize(elle::serialization::Serializer& serializer)
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+
+        cryptography::serialize<privatekey::Serialization>(
+          serializer,
+          this->_key->pkey.ec);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+
+        serializer.serialize("digest algorithm", this->_digest_algorithm);
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      PrivateKey::print(std::ostream& stream) const
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+
+        // Only the public point is represented so as not to leak the
+        // private scalar in the logs.
+        stream << "("
+               << this->curve()
+               << ", "
+               << low::EC_KEY_point2hex(this->_key->pkey.ec)
+               << ")";
+
+        stream << "["
+               << this->_digest_algorithm
+               << "]";
+      }
+    }
+  }
+}
@@ -0,0 +1,155 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_PRIVATEKEY_HH
+# define INFINIT_CRYPTOGRAPHY_EC_PRIVATEKEY_HH
+
+# include <functional>
+# include <utility>
+
+# include <openssl/ec.h>
+# include <openssl/evp.h>
+
+# include <elle/types.hh>
+# include <elle/attribute.hh>
+# include <elle/operator.hh>
+# include <elle/serialization.hh>
+
+ELLE_OPERATOR_RELATIONALS();
+
+# include <cryptography/fwd.hh>
+# include <cryptography/types.hh>
+# include <cryptography/Oneway.hh>
+# include <cryptography/SecretKey.hh>
+# include <cryptography/ec/Curve.hh>
+# include <cryptography/ec/defaults.hh>
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// A private key in the elliptic curve asymmetric cryptosystem, used
+      /// for ECDSA signatures, ECDH key agreements and opening envelopes.
+      ///
+      /// Note that the signatures are deterministic, their nonce being
+      /// derived from the key and the message's digest, see
+      /// ec/deterministic.hh.
+      class PrivateKey:
+        public elle::Printable
+      {
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        /// Construct a private key based on the given EVP_PKEY key whose
+        /// ownership is transferred.
+        explicit
+        PrivateKey(::EVP_PKEY* key,
+                   Oneway const digest_algorithm =
+                     defaults::digest_algorithm);
+        /// Construct a private key based on the given EC key whose
+        /// ownership is transferred to the private key.
+        explicit
+        PrivateKey(::EC_KEY* ec,
+                   Oneway const digest_algorithm =
+                     defaults::digest_algorithm);
+        PrivateKey(PrivateKey const& other);
+        PrivateKey(PrivateKey&& other);
+        virtual
+        ~PrivateKey();
+
+        /*--------.
+        | Methods |
+        `--------*/
+      private:
+        /// Construct the object based on the given EC structure whose
+        /// ownership is transferred to the callee.
+        void
+        _construct(::EC_KEY* ec);
+        /// Check that the key is valid.
+        void
+        _check() const;
+      public:
+        /// Open the envelope sealed with the public key, see
+        /// PublicKey::seal().
+        elle::Buffer
+        open(elle::ConstWeakBuffer const& code) const;
+        /// Open the stream-based envelope.
+        void
+        open(std::istream& code,
+             std::ostream& plain) const;
+        /// Return a signature of the given plain text.
+        elle::Buffer
+        sign(elle::ConstWeakBuffer const& plain) const;
+        /// Sign a stream-based plain text.
+        elle::Buffer
+        sign(std::istream& plain) const;
+        /// Return the signature of the object's serialization, prefixed
+        /// with the serialization version.
+        template <typename T>
+        elle::Buffer
+        sign(T const& o) const;
+        template <typename T>
+        elle::Buffer
+        sign(T const& o, elle::Version const& version) const;
+      private:
+        /// Sign the data written by the plain function, as it is written.
+        elle::Buffer
+        _sign(std::function<void (std::ostream&)> const& plain) const;
+      public:
+        /// Compute a shared session secret key based on the peer's public
+        /// key, both keys being defined over the same curve.
+        SecretKey
+        agree(PublicKey const& peer_K) const;
+        /// Return the curve the key is defined over.
+        Curve
+        curve() const;
+        /// Return the private key's size in bytes, i.e the maximum size of
+        /// its signatures.
+        uint32_t
+        size() const;
+        /// Return the private key's length in bits.
+        uint32_t
+        length() const;
+
+        /*----------.
+        | Operators |
+        `----------*/
+      public:
+        bool
+        operator ==(PrivateKey const& other) const;
+        ELLE_OPERATOR_NO_ASSIGNMENT(PrivateKey);
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*-------------.
+        | Serializable |
+        `-------------*/
+      public:
+        PrivateKey(elle::serialization::SerializerIn& serializer);
+        void
+        serialize(elle::serialization::Serializer& serializer);
+        typedef elle::serialization_tag serialization_tag;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      private:
+        ELLE_ATTRIBUTE_R(types::EVP_PKEY, key);
+        ELLE_ATTRIBUTE_R(Oneway, digest_algorithm);
+      };
+    }
+  }
+}
+
+# include <cryptography/ec/PrivateKey.hxx>
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_PRIVATEKEY_HXX
+# define INFINIT_CRYPTOGRAPHY_EC_PRIVATEKEY_HXX
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+# include <elle/IOStream.hh>
+# include <elle/log.hh>
+# include <elle/serialization/binary.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      template <typename T>
+      elle::Buffer
+      PrivateKey::sign(T const& o) const
+      {
+        return this->sign(
+          o,
+          elle::serialization::_details::serialization_tag<T>::type::version);
+      }
+
+      template <>
+      inline
+      elle::Buffer
+      PrivateKey::sign<elle::Buffer>(elle::Buffer const& b) const
+      {
+        return this->sign(elle::ConstWeakBuffer(b));
+      }
+
+      template <typename T>
+      elle::Buffer
+      PrivateKey::sign(T const& o, elle::Version const& version) const
+      {
+        ELLE_LOG_COMPONENT("infinit.cryptography.ec.PrivateKey");
+        ELLE_TRACE_SCOPE("%s: sign %s", *this, o);
+        auto signature = this->_sign(
+          [&] (std::ostream& plain)
+          {
+            elle::serialization::binary::serialize(o, plain, version, false);
+          });
+        ELLE_DUMP("signature: %s", signature);
+        ELLE_DUMP("version: %s", version);
+        elle::Buffer res;
+        {
+          elle::IOStream output(res.ostreambuf());
+          elle::serialization::binary::serialize(version, output, false);
+          output.write(reinterpret_cast<char const*>(signature.contents()),
+                       signature.size());
+        }
+        return res;
+      }
+    }
+  }
+}
+
+//
+// ---------- Hash ------------------------------------------------------------
+//
+
+namespace std
+{
+  template <>
+  struct hash<infinit::cryptography::ec::PrivateKey>
+  {
+    size_t
+    operator ()(infinit::cryptography::ec::PrivateKey const& value) const
+    {
+      std::stringstream stream;
+      {
+        elle::serialization::binary::SerializerOut output(stream);
+        output.serialize("value", value);
+      }
+
+      size_t result = std::hash<std::string>()(stream.str());
+
+      return (result);
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,330 @@
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/err.h>
+
+#include <sstream>
+
+#include <elle/Error.hh>
+#include <elle/IOStream.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+#include <elle/serialization/binary.hh>
+
+#include <cryptography/ec/PublicKey.hh>
+#include <cryptography/ec/PrivateKey.hh>
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/ec/der.hh>
+#include <cryptography/ec/ecies.hh>
+#include <cryptography/ec/serialization.hh>
+#include <cryptography/ec/low.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/finally.hh>
+#include <cryptography/raw.hh>
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace publickey
+      {
+        /*--------------.
+        | Serialization |
+        `--------------*/
+
+        struct Serialization:
+          public ec::serialization::EC
+        {
+          static
+          elle::Buffer
+          encode(::EC_KEY* ec)
+          {
+            return der::encode_public(ec);
+          }
+
+          static
+          ::EC_KEY*
+          decode(elle::ConstWeakBuffer const& buffer)
+          {
+            return der::decode_public(buffer);
+          }
+        };
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      PublicKey::PublicKey(PrivateKey const& k)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Set the key parameters.
+        this->_digest_algorithm = k.digest_algorithm();
+
+        // Extract the public key only.
+        ::EC_KEY* _ec = low::EC_KEY_priv2pub(k.key().get()->pkey.ec);
+
+        ELLE_ASSERT_NEQ(::EC_KEY_get0_public_key(_ec), nullptr);
+        ELLE_ASSERT_EQ(::EC_KEY_get0_private_key(_ec), nullptr);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(_ec);
+
+        // Construct the public key based on the given EC structure whose
+        // ownership is retained.
+        this->_construct(_ec);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_ec);
+
+        this->_check();
+      }
+
+      PublicKey::PublicKey(::EVP_PKEY* key,
+                           Oneway const digest_algorithm):
+        _key(key),
+        _digest_algorithm(digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(key, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        if (::EVP_PKEY_type(this->_key->type) != EVP_PKEY_EC)
+          throw Error(
+            elle::sprintf("the EVP_PKEY key is not of type EC: %s",
+                          ::EVP_PKEY_type(this->_key->type)));
+
+        this->_check();
+      }
+
+      PublicKey::PublicKey(::EC_KEY* ec,
+                           Oneway const digest_algorithm):
+        _digest_algorithm(digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(ec, nullptr);
+        ELLE_ASSERT_EQ(::EC_KEY_get0_private_key(ec), nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Construct the public key based on the given EC structure.
+        this->_construct(ec);
+
+        this->_check();
+      }
+
+      PublicKey::PublicKey(PublicKey const& other):
+        _digest_algorithm(other._digest_algorithm)
+      {
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Duplicate the EC structure.
+        ::EC_KEY* _ec = low::EC_KEY_dup(other._key->pkey.ec);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(_ec);
+
+        this->_construct(_ec);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_ec);
+
+        this->_check();
+      }
+
+      PublicKey::PublicKey(PublicKey&& other):
+        _key(std::move(other._key)),
+        _digest_algorithm(std::move(other._digest_algorithm))
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        this->_check();
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      void
+      PublicKey::_construct(::EC_KEY* ec)
+      {
+        // Initialise the public key structure.
+        ELLE_ASSERT_EQ(this->_key, nullptr);
+        this->_key.reset(::EVP_PKEY_new());
+
+        if (this->_key == nullptr)
+          throw Error(
+            elle::sprintf("unable to allocate the EVP_PKEY structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        // Set the EC structure into the public key.
+        if (::EVP_PKEY_assign_EC_KEY(this->_key.get(), ec) <= 0)
+          throw Error(
+            elle::sprintf("unable to assign the EC key to the EVP_PKEY "
+                          "structure: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      void
+      PublicKey::_check() const
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+        ELLE_ASSERT_NEQ(::EC_KEY_get0_public_key(this->_key->pkey.ec),
+                        nullptr);
+      }
+
+      elle::Buffer
+      PublicKey::seal(elle::ConstWeakBuffer const& plain) const
+      {
+        elle::IOStream _plain(plain.istreambuf());
+        std::stringstream _code;
+
+        this->seal(_plain, _code);
+
+        return (elle::Buffer(_code.str().data(), _code.str().length()));
+      }
+
+      void
+      PublicKey::seal(std::istream& plain,
+                      std::ostream& code) const
+      {
+        ecies::seal(this->_key->pkey.ec, plain, code);
+      }
+
+      bool
+      PublicKey::verify(elle::ConstWeakBuffer const& signature,
+                        elle::ConstWeakBuffer const& plain) const
+      {
+        elle::IOStream _plain(plain.istreambuf());
+        return (this->verify(signature, _plain));
+      }
+
+      bool
+      PublicKey::verify(elle::ConstWeakBuffer const& signature,
+                        std::istream& plain) const
+      {
+        return (raw::asymmetric::verify(
+                  this->_key.get(),
+                  oneway::resolve(this->_digest_algorithm),
+                  signature,
+                  plain));
+      }
+
+      bool
+      PublicKey::_verify(elle::ConstWeakBuffer const& signature,
+                         std::function<void (std::ostream&)> const& plain) const
+      {
+        return (raw::asymmetric::verify(
+                  this->_key.get(),
+                  oneway::resolve(this->_digest_algorithm),
+                  signature,
+                  plain));
+      }
+
+      Curve
+      PublicKey::curve() const
+      {
+        return (curve::resolve(
+                  ::EC_GROUP_get_curve_name(
+                    ::EC_KEY_get0_group(this->_key->pkey.ec))));
+      }
+
+      uint32_t
+      PublicKey::size() const
+      {
+        return (static_cast<uint32_t>(
+                  ::EVP_PKEY_size(this->_key.get())));
+      }
+
+      uint32_t
+      PublicKey::length() const
+      {
+        return (static_cast<uint32_t>(
+                  ::EVP_PKEY_bits(this->_key.get())));
+      }
+
+      /*----------.
+      | Operators |
+      `----------*/
+
+      bool
+      PublicKey::operator ==(PublicKey const& other) const
+      {
+        if (this == &other)
+          return (true);
+
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(other._key, nullptr);
+
+        return (::EVP_PKEY_cmp(this->_key.get(), other._key.get()) == 1);
+      }
+
+      /*--------------.
+      | Serialization |
+      `--------------*/
+
+      PublicKey::PublicKey(elle::serialization::SerializerIn& serializer)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Allocate the EVP key to receive the deserialized's EC structure.
+        this->_key.reset(::EVP_PKEY_new());
+
+        // Set the EVP key as being of type EC.
+        if (::EVP_PKEY_set_type(this->_key.get(), EVP_PKEY_EC) <= 0)
+          throw Error(
+            elle::sprintf("unable to set the EVP key's type: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        this->serialize(serializer);
+
+        this->_check();
+      }
+
+      void
+      PublicKey::serialize(elle::serialization::Serializer& serializer)
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+
+        cryptography::serialize<publickey::Serialization>(
+          serializer,
+          this->_key->pkey.ec);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+
+        serializer.serialize("digest algorithm", this->_digest_algorithm);
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      PublicKey::print(std::ostream& stream) const
+      {
+        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        ELLE_ASSERT_NEQ(this->_key->pkey.ec, nullptr);
+
+        stream << "("
+               << this->curve()
+               << ", "
+               << low::EC_KEY_point2hex(this->_key->pkey.ec)
+               << ")";
+
+        stream << "["
+               << this->_digest_algorithm
+               << "]";
+      }
+    }
+  }
+}
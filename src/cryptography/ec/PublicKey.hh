@@ -0,0 +1,155 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_PUBLICKEY_HH
+# define INFINIT_CRYPTOGRAPHY_EC_PUBLICKEY_HH
+
+# include <functional>
+# include <utility>
+
+# include <openssl/ec.h>
+# include <openssl/evp.h>
+
+# include <elle/types.hh>
+# include <elle/attribute.hh>
+# include <elle/operator.hh>
+# include <elle/serialization/Serializer.hh>
+# include <elle/serialization.hh>
+
+ELLE_OPERATOR_RELATIONALS();
+
+# include <cryptography/ec/PrivateKey.hh>
+# include <cryptography/ec/Curve.hh>
+# include <cryptography/ec/defaults.hh>
+# include <cryptography/fwd.hh>
+# include <cryptography/types.hh>
+# include <cryptography/Oneway.hh>
+# include <cryptography/raw.hh>
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// Represent a public key in the elliptic curve asymmetric
+      /// cryptosystem, used for verifying ECDSA signatures and sealing
+      /// envelopes.
+      class PublicKey:
+        public elle::Printable
+      {
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        /// Construct a public key out of its private counterpart.
+        explicit
+        PublicKey(PrivateKey const& k);
+        /// Construct a public key based on the given EVP_PKEY key whose
+        /// ownership is transferred.
+        explicit
+        PublicKey(::EVP_PKEY* key,
+                  Oneway const digest_algorithm =
+                    defaults::digest_algorithm);
+        /// Construct a public key based on the given EC key whose
+        /// ownership is transferred to the public key.
+        explicit
+        PublicKey(::EC_KEY* ec,
+                  Oneway const digest_algorithm =
+                    defaults::digest_algorithm);
+        PublicKey(PublicKey const& other);
+        PublicKey(PublicKey&& other);
+        virtual
+        ~PublicKey() = default;
+
+        /*--------.
+        | Methods |
+        `--------*/
+      private:
+        /// Construct the object based on the given EC structure whose
+        /// ownership is transferred to the callee.
+        void
+        _construct(::EC_KEY* ec);
+        /// Check that the key is valid.
+        void
+        _check() const;
+      public:
+        /// Seal the plain text in an envelope that only the owner of the
+        /// private key can open, see ec/ecies.hh.
+        elle::Buffer
+        seal(elle::ConstWeakBuffer const& plain) const;
+        /// Seal the stream-based plain text in an envelope.
+        void
+        seal(std::istream& plain,
+             std::ostream& code) const;
+        /// Return true if the given signature matches with the plain text.
+        bool
+        verify(elle::ConstWeakBuffer const& signature,
+               elle::ConstWeakBuffer const& plain) const;
+        /// Verify a signature against a stream-based plain text.
+        bool
+        verify(elle::ConstWeakBuffer const& signature,
+               std::istream& plain) const;
+        /// Verify the given signature against the object's serialization,
+        /// see PrivateKey::sign().
+        template <typename T>
+        bool
+        verify(elle::ConstWeakBuffer const& signature,
+               T const& o) const;
+      private:
+        /// Verify the signature against the data written by the plain
+        /// function.
+        bool
+        _verify(elle::ConstWeakBuffer const& signature,
+                std::function<void (std::ostream&)> const& plain) const;
+      public:
+        /// Return the curve the key is defined over.
+        Curve
+        curve() const;
+        /// Return the public key's size in bytes, i.e the maximum size of
+        /// the signatures.
+        uint32_t
+        size() const;
+        /// Return the public key's length in bits.
+        uint32_t
+        length() const;
+
+        /*----------.
+        | Operators |
+        `----------*/
+      public:
+        bool
+        operator ==(PublicKey const& other) const;
+        ELLE_OPERATOR_NO_ASSIGNMENT(PublicKey);
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*--------------.
+        | Serialization |
+        `--------------*/
+      public:
+        PublicKey(elle::serialization::SerializerIn& serializer);
+        void
+        serialize(elle::serialization::Serializer& serializer);
+        typedef elle::serialization_tag serialization_tag;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      public:
+        ELLE_ATTRIBUTE_R(types::EVP_PKEY, key);
+        ELLE_ATTRIBUTE_R(Oneway, digest_algorithm);
+      };
+    }
+  }
+}
+
+# include <cryptography/ec/PublicKey.hxx>
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_PUBLICKEY_HXX
+# define INFINIT_CRYPTOGRAPHY_EC_PUBLICKEY_HXX
+
+//
+// ---------- Class -----------------------------------------------------------
+//
+
+# include <elle/log.hh>
+# include <elle/serialization/binary.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      template <>
+      inline
+      bool
+      PublicKey::verify<elle::Buffer>(elle::ConstWeakBuffer const& signature,
+                                      elle::Buffer const& plain) const
+      {
+        return this->verify(signature, elle::ConstWeakBuffer(plain));
+      }
+
+      template <typename T>
+      bool
+      PublicKey::verify(elle::ConstWeakBuffer const& signature,
+                        T const& o) const
+      {
+        ELLE_LOG_COMPONENT("infinit.cryptography.ec.PublicKey");
+        ELLE_TRACE_SCOPE("%s: verify %s", this, o);
+        auto header = raw::asymmetric::split(signature);
+        ELLE_DUMP("serialization version: %s", header.first);
+        ELLE_DUMP("signature: %s", header.second);
+        std::function<void (std::ostream&)> plain =
+          [&] (std::ostream& output)
+          {
+            elle::serialization::binary::serialize(o, output,
+                                                   header.first, false);
+          };
+        return this->_verify(header.second, plain);
+      }
+    }
+  }
+}
+
+//
+// ---------- Hash ------------------------------------------------------------
+//
+
+namespace std
+{
+  template <>
+  struct hash<infinit::cryptography::ec::PublicKey>
+  {
+    size_t
+    operator ()(infinit::cryptography::ec::PublicKey const& value) const
+    {
+      std::stringstream stream;
+      {
+        elle::serialization::binary::SerializerOut output(stream);
+        output.serialize("value", value);
+      }
+
+      size_t result = std::hash<std::string>()(stream.str());
+
+      return (result);
+    }
+  };
+}
+
+#endif
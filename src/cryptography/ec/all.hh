@@ -0,0 +1,18 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_ALL_HH
+# define INFINIT_CRYPTOGRAPHY_EC_ALL_HH
+
+# include <cryptography/ec/Curve.hh>
+# include <cryptography/ec/KeyPair.hh>
+# include <cryptography/ec/KeyPool.hh>
+# include <cryptography/ec/PrivateKey.hh>
+# include <cryptography/ec/PublicKey.hh>
+# include <cryptography/ec/pem.hh>
+# include <cryptography/ec/der.hh>
+# include <cryptography/ec/deterministic.hh>
+# include <cryptography/ec/batch.hh>
+# include <cryptography/ec/ecies.hh>
+# include <cryptography/ec/defaults.hh>
+# include <cryptography/ec/serialization.hh>
+# include <cryptography/ec/low.hh>
+
+#endif
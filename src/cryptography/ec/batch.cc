@@ -0,0 +1,111 @@
+#include <cryptography/ec/batch.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/Executor.hh>
+#include <cryptography/cryptography.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include <elle/finally.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.ec.batch");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace batch
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               unsigned int workers)
+        {
+          ELLE_TRACE_SCOPE("verify %s signatures", verifications.size());
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          if (workers == 0)
+            workers = std::max(std::thread::hardware_concurrency(), 1u);
+          workers = std::min<std::size_t>(workers, verifications.size());
+
+          // Note that std::vector<bool> cannot be written concurrently, hence
+          // the intermediate vector.
+          std::vector<char> valid(verifications.size(), false);
+          std::atomic<std::size_t> next(0);
+
+          auto work =
+            [&] ()
+            {
+              std::size_t index;
+
+              while ((index = next++) < verifications.size())
+              {
+                Verification const& verification = verifications[index];
+
+                ELLE_ASSERT_NEQ(verification.key, nullptr);
+
+                try
+                {
+                  valid[index] =
+                    verification.key->verify(verification.signature,
+                                             verification.plain);
+                }
+                catch (Error const& error)
+                {
+                  ELLE_DEBUG("unable to verify the signature %s: %s",
+                             index, error.what());
+                }
+              }
+            };
+
+          std::vector<std::future<void>> tasks;
+
+          {
+            // The tasks reference the local variables: wait for them
+            // whichever way the scope is left. Note that the tasks started
+            // once the calling thread is done find nothing left to verify.
+            elle::SafeFinally wait(
+              [&]
+              {
+                for (auto& task: tasks)
+                  task.wait();
+              });
+
+            for (unsigned int i = 1; i < workers; ++i)
+            {
+              try
+              {
+                tasks.push_back(executor::batch().submit(work));
+              }
+              catch (Error const&)
+              {
+                // The executor is at capacity, the calling thread and the
+                // submitted tasks taking care of the verifications.
+                break;
+              }
+            }
+
+            // The calling thread takes part in the verifications.
+            work();
+          }
+
+          // Report the tasks' errors.
+          for (auto& task: tasks)
+            task.get();
+
+          return (std::vector<bool>(valid.begin(), valid.end()));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_BATCH_HH
+# define INFINIT_CRYPTOGRAPHY_EC_BATCH_HH
+
+# include <vector>
+
+# include <elle/Buffer.hh>
+
+# include <cryptography/ec/PublicKey.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace batch
+      {
+        /*--------.
+        | Structs |
+        `--------*/
+
+        /// A signature to verify, the key, the signature and the plain being
+        /// referenced rather than copied: all must outlive the verification.
+        struct Verification
+        {
+          PublicKey const* key;
+          elle::ConstWeakBuffer signature;
+          elle::ConstWeakBuffer plain;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Verify the given signatures, spreading them across the given
+        /// number of workers, the calling thread and tasks of the batch
+        /// executor, see executor::batch(), the number of cores being used
+        /// should it be zero, and return whether each of them is valid, in
+        /// the same order.
+        ///
+        /// Note that a malformed signature is reported as invalid rather
+        /// than through an exception, other errors being propagated.
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               unsigned int workers = 0);
+      }
+    }
+  }
+}
+
+#endif
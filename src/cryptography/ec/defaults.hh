@@ -0,0 +1,26 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_DEFAULTS_HH
+# define INFINIT_CRYPTOGRAPHY_EC_DEFAULTS_HH
+
+# include <cryptography/Oneway.hh>
+# include <cryptography/ec/Curve.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace defaults
+      {
+        /*---------------.
+        | Default Values |
+        `---------------*/
+
+        static Curve const curve = Curve::p256;
+        static Oneway const digest_algorithm = Oneway::sha256;
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include <openssl/err.h>
+#include <openssl/x509.h>
+
+#include <cryptography/ec/der.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/finally.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace der
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        elle::Buffer
+        encode_public(::EC_KEY* ec)
+        {
+          unsigned char* _buffer = nullptr;
+
+          int _size = ::i2d_EC_PUBKEY(ec, &_buffer);
+          if (_size <= 0)
+            throw Error(
+              elle::sprintf("unable to encode DER for the EC public key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_buffer);
+
+          elle::Buffer buffer(_buffer, _size);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_buffer);
+          ::OPENSSL_free(_buffer);
+
+          return (buffer);
+        }
+
+        ::EC_KEY*
+        decode_public(elle::ConstWeakBuffer const& buffer)
+        {
+          const unsigned char* _buffer = buffer.contents();
+          long _size = buffer.size();
+
+          ::EC_KEY* ec = nullptr;
+          if ((ec = ::d2i_EC_PUBKEY(NULL, &_buffer, _size)) == NULL)
+            throw Error(
+              elle::sprintf("unable to decode DER for the EC public key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (ec);
+        }
+
+        elle::Buffer
+        encode_private(::EC_KEY* ec)
+        {
+          unsigned char* _buffer = nullptr;
+
+          int _size = ::i2d_ECPrivateKey(ec, &_buffer);
+          if (_size <= 0)
+            throw Error(
+              elle::sprintf("unable to encode the EC private key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_buffer);
+
+          elle::Buffer buffer(_buffer, _size);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_buffer);
+          ::OPENSSL_free(_buffer);
+
+          return (buffer);
+        }
+
+        ::EC_KEY*
+        decode_private(elle::ConstWeakBuffer const& buffer)
+        {
+          const unsigned char* _buffer = buffer.contents();
+          long _size = buffer.size();
+
+          ::EC_KEY* ec = nullptr;
+          if ((ec = ::d2i_ECPrivateKey(NULL, &_buffer, _size)) == NULL)
+            throw Error(
+              elle::sprintf("unable to decode the EC private key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (ec);
+        }
+      }
+    }
+  }
+}
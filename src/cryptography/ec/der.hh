@@ -0,0 +1,45 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_DER_HH
+# define INFINIT_CRYPTOGRAPHY_EC_DER_HH
+
+# include <openssl/ec.h>
+
+# include <elle/types.hh>
+# include <elle/Buffer.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// Distinguished Encoding Rules is a restricted variant of BER for
+      /// producing unequivocal transfer syntax for data structures described
+      /// by ASN.1.
+      ///
+      /// Note that the public keys are encoded as SubjectPublicKeyInfo
+      /// structures and the private keys as ECPrivateKey ones, both
+      /// embedding the curve's name.
+      namespace der
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Encode the given EC key's public part into a binary-based format.
+        elle::Buffer
+        encode_public(::EC_KEY* ec);
+        /// Decode the EC public key from a DER-based buffer.
+        ::EC_KEY*
+        decode_public(elle::ConstWeakBuffer const& buffer);
+        /// Encode the given EC key's private part into a binary-based format.
+        elle::Buffer
+        encode_private(::EC_KEY* ec);
+        /// Decode the EC private key from a DER-based buffer.
+        ::EC_KEY*
+        decode_private(elle::ConstWeakBuffer const& buffer);
+      }
+    }
+  }
+}
+
+#endif
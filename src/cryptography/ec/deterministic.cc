@@ -0,0 +1,341 @@
+#include <cryptography/ec/deterministic.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/finally.hh>
+
+#include <elle/finally.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/err.h>
+#include <openssl/hmac.h>
+
+#include <cstring>
+#include <initializer_list>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.ec.deterministic");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace deterministic
+      {
+        /*-----------------.
+        | Static Functions |
+        `-----------------*/
+
+        /// Compute the HMAC of the concatenation of the given data, writing
+        /// it in the output buffer, of the oneway's digest size, in place.
+        ///
+        /// Note that the data and the HMAC depend on the private scalar: the
+        /// intermediate buffers are allocated once and cleansed so as not
+        /// to leave copies behind, the output being possibly the key or one
+        /// of the data.
+        static
+        void
+        _hmac(::EVP_MD const* oneway,
+              elle::Buffer const& key,
+              std::initializer_list<elle::ConstWeakBuffer> data,
+              elle::Buffer& output)
+        {
+          std::size_t size = 0;
+
+          for (auto const& part: data)
+            size += part.size();
+
+          elle::Buffer input(size);
+          unsigned char _output[EVP_MAX_MD_SIZE];
+          unsigned int length(0);
+
+          elle::SafeFinally cleanse(
+            [&]
+            {
+              ::OPENSSL_cleanse(input.mutable_contents(), input.size());
+              ::OPENSSL_cleanse(_output, sizeof (_output));
+            });
+
+          std::size_t offset = 0;
+
+          for (auto const& part: data)
+          {
+            ::memcpy(input.mutable_contents() + offset,
+                     part.contents(),
+                     part.size());
+            offset += part.size();
+          }
+
+          if (::HMAC(oneway,
+                     key.contents(), key.size(),
+                     input.contents(), input.size(),
+                     _output, &length) == nullptr)
+            throw Error(
+              elle::sprintf("unable to apply the HMAC function: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          ELLE_ASSERT_EQ(length, output.size());
+
+          ::memcpy(output.mutable_contents(), _output, length);
+        }
+
+        /// Convert the bit string into a number as described in RFC 6979
+        /// section 2.3.2, keeping the leftmost bits only should the string
+        /// be longer than the group order.
+        static
+        void
+        _bits2int(elle::ConstWeakBuffer const& bits,
+                  ::BIGNUM const* order,
+                  ::BIGNUM* number)
+        {
+          if (::BN_bin2bn(bits.contents(), bits.size(), number) == nullptr)
+            throw Error(
+              elle::sprintf("unable to convert the binary data: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          int const length = bits.size() * 8;
+          int const qlength = ::BN_num_bits(order);
+
+          if (length > qlength)
+            if (::BN_rshift(number, number, length - qlength) <= 0)
+              throw Error(
+                elle::sprintf("unable to shift the number: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+        }
+
+        /// Return the big-endian representation of the number on the given
+        /// number of bytes, see RFC 6979 section 2.3.3.
+        static
+        elle::Buffer
+        _int2octets(::BIGNUM const* number,
+                    std::size_t const size)
+        {
+          std::size_t const length = BN_num_bytes(number);
+
+          ELLE_ASSERT_LTE(length, size);
+
+          elle::Buffer octets(size);
+
+          ::memset(octets.mutable_contents(), 0x0, size);
+          ::BN_bn2bin(number, octets.mutable_contents() + (size - length));
+
+          return (octets);
+        }
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        ::BIGNUM*
+        nonce(::EC_KEY* key,
+              ::EVP_MD const* oneway,
+              elle::ConstWeakBuffer const& digest)
+        {
+          ELLE_ASSERT_NEQ(key, nullptr);
+          ELLE_ASSERT_NEQ(oneway, nullptr);
+
+          ::BN_CTX* context = ::BN_CTX_new();
+          if (context == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the BN context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+          ::BIGNUM* order = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(order);
+          ::BIGNUM* h = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(h);
+          ::BIGNUM* k = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(k);
+
+          if ((order == nullptr) || (h == nullptr) || (k == nullptr))
+            throw Error(
+              elle::sprintf("unable to allocate the big numbers: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::EC_GROUP_get_order(::EC_KEY_get0_group(key),
+                                   order,
+                                   context) <= 0)
+            throw Error(
+              elle::sprintf("unable to retrieve the group order: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          std::size_t const qlength = ::BN_num_bits(order);
+          std::size_t const rlength = (qlength + 7) / 8;
+
+          // Reduce the digest modulo the order, see bits2octets().
+          _bits2int(digest, order, h);
+          if (::BN_cmp(h, order) >= 0)
+            if (::BN_sub(h, h, order) <= 0)
+              throw Error(
+                elle::sprintf("unable to reduce the digest: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          elle::Buffer x(_int2octets(::EC_KEY_get0_private_key(key),
+                                     rlength));
+          elle::Buffer h1(_int2octets(h, rlength));
+
+          // Instantiate the HMAC_DRBG, see RFC 6979 section 3.2 steps b
+          // through g.
+          std::size_t const hlength = EVP_MD_size(oneway);
+          elle::Buffer V(hlength);
+          elle::Buffer K(hlength);
+          // The candidates, made of whole HMAC outputs.
+          elle::Buffer T(((rlength + hlength - 1) / hlength) * hlength);
+
+          // Wipe the private scalar's copy along with the DRBG's state and
+          // output, whichever way the function is left.
+          elle::SafeFinally cleanse(
+            [&]
+            {
+              ::OPENSSL_cleanse(x.mutable_contents(), x.size());
+              ::OPENSSL_cleanse(V.mutable_contents(), V.size());
+              ::OPENSSL_cleanse(K.mutable_contents(), K.size());
+              ::OPENSSL_cleanse(T.mutable_contents(), T.size());
+            });
+
+          ::memset(V.mutable_contents(), 0x1, hlength);
+          ::memset(K.mutable_contents(), 0x0, hlength);
+
+          unsigned char const zero = 0x0;
+          unsigned char const one = 0x1;
+
+          _hmac(oneway, K, {V, {&zero, 1}, x, h1}, K);
+          _hmac(oneway, K, {V}, V);
+          _hmac(oneway, K, {V, {&one, 1}, x, h1}, K);
+          _hmac(oneway, K, {V}, V);
+
+          // Generate candidates until one lies in [1, q - 1], see step h.
+          while (true)
+          {
+            for (std::size_t offset = 0; offset < T.size(); offset += hlength)
+            {
+              _hmac(oneway, K, {V}, V);
+              ::memcpy(T.mutable_contents() + offset, V.contents(), hlength);
+            }
+
+            _bits2int(T, order, k);
+
+            if (!::BN_is_zero(k) && (::BN_cmp(k, order) < 0))
+              break;
+
+            _hmac(oneway, K, {V, {&zero, 1}}, K);
+            _hmac(oneway, K, {V}, V);
+          }
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(k);
+
+          return (k);
+        }
+
+        elle::Buffer
+        sign(::EC_KEY* key,
+             ::EVP_MD const* oneway,
+             elle::ConstWeakBuffer const& digest)
+        {
+          ELLE_TRACE_SCOPE("sign a digest of %s bytes", digest.size());
+
+          ELLE_ASSERT_NEQ(key, nullptr);
+
+          ::EC_GROUP const* group = ::EC_KEY_get0_group(key);
+
+          ::BN_CTX* context = ::BN_CTX_new();
+          if (context == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the BN context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+          ::BIGNUM* k = nonce(key, oneway, digest);
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(k);
+
+          BN_set_flags(k, BN_FLG_CONSTTIME);
+
+          ::BIGNUM* order = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(order);
+          ::BIGNUM* r = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(r);
+          ::BIGNUM* kinv = ::BN_new();
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN(kinv);
+
+          if ((order == nullptr) || (r == nullptr) || (kinv == nullptr))
+            throw Error(
+              elle::sprintf("unable to allocate the big numbers: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::EC_GROUP_get_order(group, order, context) <= 0)
+            throw Error(
+              elle::sprintf("unable to retrieve the group order: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Compute r = x(kG) mod q.
+          {
+            ::EC_POINT* point = ::EC_POINT_new(group);
+            if (point == nullptr)
+              throw Error(
+                elle::sprintf("unable to allocate the EC point: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+            INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_POINT(point);
+
+            if (::EC_POINT_mul(group, point, k,
+                               nullptr, nullptr, context) <= 0)
+              throw Error(
+                elle::sprintf("unable to multiply the generator: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+            if (::EC_POINT_get_affine_coordinates_GFp(group, point,
+                                                      r, nullptr,
+                                                      context) <= 0)
+              throw Error(
+                elle::sprintf("unable to retrieve the point's "
+                              "coordinates: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+          }
+
+          if (::BN_nnmod(r, r, order, context) <= 0)
+            throw Error(
+              elle::sprintf("unable to reduce the point's coordinate: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::BN_mod_inverse(kinv, k, order, context) == nullptr)
+            throw Error(
+              elle::sprintf("unable to invert the nonce: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Note that the digest is truncated to the order's length by
+          // OpenSSL, as it is when deriving the nonce.
+          ::ECDSA_SIG* signature = ::ECDSA_do_sign_ex(digest.contents(),
+                                                      digest.size(),
+                                                      kinv,
+                                                      r,
+                                                      key);
+          if (signature == nullptr)
+            throw Error(
+              elle::sprintf("unable to sign the digest: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_ECDSA_SIG(signature);
+
+          unsigned char* buffer = nullptr;
+          int size = 0;
+
+          if ((size = ::i2d_ECDSA_SIG(signature, &buffer)) <= 0)
+            throw Error(
+              elle::sprintf("unable to encode the signature: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(buffer);
+
+          return (elle::Buffer(buffer, size));
+        }
+      }
+    }
+  }
+}
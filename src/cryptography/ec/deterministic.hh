@@ -0,0 +1,48 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_DETERMINISTIC_HH
+# define INFINIT_CRYPTOGRAPHY_EC_DETERMINISTIC_HH
+
+# include <openssl/bn.h>
+# include <openssl/ec.h>
+# include <openssl/evp.h>
+
+# include <elle/Buffer.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// Deterministic ECDSA as specified by RFC 6979: the nonce is derived
+      /// from the private key and the message digest through HMAC_DRBG
+      /// rather than drawn from the random generator.
+      ///
+      /// Signing the same message twice with the same key therefore yields
+      /// the same signature, the latter being a regular ECDSA signature
+      /// verified as any other.
+      namespace deterministic
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Return the nonce for signing the given digest with the key, the
+        /// HMAC_DRBG relying on the oneway function the digest has been
+        /// computed with.
+        ///
+        /// The returned number must be released by the caller.
+        ::BIGNUM*
+        nonce(::EC_KEY* key,
+              ::EVP_MD const* oneway,
+              elle::ConstWeakBuffer const& digest);
+        /// Return the DER-encoded signature of the given digest.
+        elle::Buffer
+        sign(::EC_KEY* key,
+             ::EVP_MD const* oneway,
+             elle::ConstWeakBuffer const& digest);
+      }
+    }
+  }
+}
+
+#endif
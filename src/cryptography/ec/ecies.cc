@@ -0,0 +1,329 @@
+#include <cryptography/ec/ecies.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/aead.hh>
+#include <cryptography/constants.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/finally.hh>
+#include <cryptography/io.hh>
+
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/ecdh.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.ec.ecies");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace ecies
+      {
+        /*----------.
+        | Constants |
+        `----------*/
+
+        /// The version of the envelope format.
+        static uint8_t const _version = 1;
+        /// The label binding the derived material to this construction.
+        static char const _label[] = "infinit.cryptography.ec.ecies";
+        /// The size of the symmetric key, in bytes.
+        static std::size_t const _key_size = 32;
+
+        /*-----------------.
+        | Static Functions |
+        `-----------------*/
+
+        /// Return the compressed encoding of the point.
+        static
+        std::string
+        _encode(::EC_GROUP const* group,
+                ::EC_POINT const* point)
+        {
+          std::size_t size = ::EC_POINT_point2oct(group, point,
+                                                  POINT_CONVERSION_COMPRESSED,
+                                                  nullptr, 0, nullptr);
+          if (size == 0)
+            throw Error(
+              elle::sprintf("unable to encode the EC point: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          std::string octets(size, '\0');
+
+          if (::EC_POINT_point2oct(
+                group, point,
+                POINT_CONVERSION_COMPRESSED,
+                reinterpret_cast<unsigned char*>(&octets[0]), size,
+                nullptr) != size)
+            throw Error(
+              elle::sprintf("unable to encode the EC point: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (octets);
+        }
+
+        /// Return the HMAC-SHA256 of the data with the key.
+        static
+        std::vector<unsigned char>
+        _hmac(std::vector<unsigned char> const& key,
+              std::string const& data)
+        {
+          std::vector<unsigned char> output(EVP_MAX_MD_SIZE);
+          unsigned int size(0);
+
+          if (::HMAC(::EVP_sha256(),
+                     key.data(), key.size(),
+                     reinterpret_cast<unsigned char const*>(data.data()),
+                     data.size(),
+                     output.data(), &size) == nullptr)
+            throw Error(
+              elle::sprintf("unable to apply the HMAC function: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          output.resize(size);
+
+          return (output);
+        }
+
+        /// Derive the symmetric key followed by the nonce prefix from the
+        /// agreement between the private key and the peer's point, through
+        /// HKDF-SHA256 as specified by RFC 5869, with an empty salt and the
+        /// given context as info.
+        static
+        std::vector<unsigned char>
+        _derive(::EC_KEY* key,
+                ::EC_POINT const* peer,
+                std::string const& context)
+        {
+          ::EC_GROUP const* group = ::EC_KEY_get0_group(key);
+          std::string secret((::EC_GROUP_get_degree(group) + 7) / 8, '\0');
+
+          elle::SafeFinally cleanse(
+            [&] { ::OPENSSL_cleanse(&secret[0], secret.size()); });
+
+          int size = ::ECDH_compute_key(&secret[0], secret.size(),
+                                        peer, key, nullptr);
+          if (size <= 0)
+            throw Error(
+              elle::sprintf("unable to agree on the envelope's secret: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          secret.resize(size);
+
+          // Extract.
+          std::vector<unsigned char> prk =
+            _hmac(std::vector<unsigned char>(SHA256_DIGEST_LENGTH, 0x0),
+                  secret);
+
+          elle::SafeFinally cleanse_prk(
+            [&] { ::OPENSSL_cleanse(prk.data(), prk.size()); });
+
+          // Expand.
+          std::vector<unsigned char> material;
+          std::vector<unsigned char> block;
+          std::string info(_label, sizeof (_label) - 1);
+
+          info.append(context);
+
+          for (char i = 1; material.size() < _key_size + aead::prefix_size; ++i)
+          {
+            std::string input(block.begin(), block.end());
+
+            input.append(info);
+            input.push_back(i);
+
+            block = _hmac(prk, input);
+            material.insert(material.end(), block.begin(), block.end());
+          }
+
+          material.resize(_key_size + aead::prefix_size);
+
+          return (material);
+        }
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        void
+        seal(::EC_KEY* key,
+             std::istream& plain,
+             std::ostream& code)
+        {
+          ELLE_TRACE_SCOPE("seal an envelope");
+
+          ELLE_ASSERT_NEQ(key, nullptr);
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::EC_GROUP const* group = ::EC_KEY_get0_group(key);
+
+          // Generate the ephemeral key pair over the recipient's curve.
+          ::EC_KEY* ephemeral = ::EC_KEY_new();
+          if (ephemeral == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the EC key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(ephemeral);
+
+          if ((::EC_KEY_set_group(ephemeral, group) <= 0) ||
+              (::EC_KEY_generate_key(ephemeral) <= 0))
+            throw Error(
+              elle::sprintf("unable to generate the ephemeral key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          std::string point =
+            _encode(group, ::EC_KEY_get0_public_key(ephemeral));
+          std::string header;
+
+          header.push_back(_version);
+          header.push_back(static_cast<char>(point.size()));
+          header.append(point);
+
+          std::vector<unsigned char> material =
+            _derive(ephemeral,
+                    ::EC_KEY_get0_public_key(key),
+                    header + _encode(group, ::EC_KEY_get0_public_key(key)));
+
+          elle::SafeFinally cleanse(
+            [&] { ::OPENSSL_cleanse(material.data(), material.size()); });
+
+          io::write(code, header.data(), header.size(), "header");
+
+          // Initialize the cipher context.
+          ::EVP_CIPHER_CTX context;
+
+          ::EVP_CIPHER_CTX_init(&context);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+          if ((::EVP_EncryptInit_ex(&context, ::EVP_aes_256_gcm(), nullptr,
+                                    nullptr, nullptr) <= 0) ||
+              (::EVP_CIPHER_CTX_ctrl(&context, EVP_CTRL_GCM_SET_IVLEN,
+                                     aead::nonce_size, nullptr) <= 0) ||
+              (::EVP_EncryptInit_ex(&context, nullptr, nullptr,
+                                    material.data(), nullptr) <= 0))
+            throw Error(
+              elle::sprintf("unable to initialize the seal process: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          aead::seal(&context, material.data() + _key_size,
+                     elle::ConstWeakBuffer(header.data(), header.size()),
+                     constants::envelope_chunk_size, plain, code);
+
+          // Clean up the cipher context.
+          if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+            throw Error(
+              elle::sprintf("unable to clean the cipher context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+        }
+
+        void
+        open(::EC_KEY* key,
+             std::istream& code,
+             std::ostream& plain)
+        {
+          ELLE_TRACE_SCOPE("open an envelope");
+
+          ELLE_ASSERT_NEQ(key, nullptr);
+          ELLE_ASSERT_NEQ(::EC_KEY_get0_private_key(key), nullptr);
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::EC_GROUP const* group = ::EC_KEY_get0_group(key);
+
+          // Read the header.
+          unsigned char preamble[2];
+
+          io::read(code, preamble, sizeof (preamble), "header");
+
+          if (preamble[0] != _version)
+            throw Error(
+              elle::sprintf("unknown envelope version %s", preamble[0]));
+
+          std::string point(preamble[1], '\0');
+
+          if (point.empty())
+            throw Error("the envelope's ephemeral point is empty");
+
+          io::read(code, &point[0], point.size(), "ephemeral point");
+
+          std::string header(reinterpret_cast<char*>(preamble),
+                             sizeof (preamble));
+
+          header.append(point);
+
+          // Decode the ephemeral point, making sure it lies on the curve.
+          ::EC_POINT* ephemeral = ::EC_POINT_new(group);
+          if (ephemeral == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the EC point: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_POINT(ephemeral);
+
+          if (::EC_POINT_oct2point(
+                group, ephemeral,
+                reinterpret_cast<unsigned char const*>(point.data()),
+                point.size(),
+                nullptr) <= 0)
+            throw Error(
+              elle::sprintf("invalid ephemeral point: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          std::vector<unsigned char> material =
+            _derive(key,
+                    ephemeral,
+                    header + _encode(group, ::EC_KEY_get0_public_key(key)));
+
+          elle::SafeFinally cleanse(
+            [&] { ::OPENSSL_cleanse(material.data(), material.size()); });
+
+          // Initialize the cipher context.
+          ::EVP_CIPHER_CTX context;
+
+          ::EVP_CIPHER_CTX_init(&context);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+          if ((::EVP_DecryptInit_ex(&context, ::EVP_aes_256_gcm(), nullptr,
+                                    nullptr, nullptr) <= 0) ||
+              (::EVP_CIPHER_CTX_ctrl(&context, EVP_CTRL_GCM_SET_IVLEN,
+                                     aead::nonce_size, nullptr) <= 0) ||
+              (::EVP_DecryptInit_ex(&context, nullptr, nullptr,
+                                    material.data(), nullptr) <= 0))
+            throw Error(
+              elle::sprintf("unable to initialize the open process: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          aead::open(&context, material.data() + _key_size,
+                     elle::ConstWeakBuffer(header.data(), header.size()),
+                     constants::envelope_chunk_size, code, plain);
+
+          // Clean up the cipher context.
+          if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+            throw Error(
+              elle::sprintf("unable to clean the cipher context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+        }
+      }
+    }
+  }
+}
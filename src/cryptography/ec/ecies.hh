@@ -0,0 +1,54 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_ECIES_HH
+# define INFINIT_CRYPTOGRAPHY_EC_ECIES_HH
+
+# include <iosfwd>
+
+# include <openssl/ec.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      /// Hybrid envelopes in the style of ECIES: an ephemeral key pair is
+      /// generated over the recipient's curve for every envelope, a single
+      /// ECDH agreement against the recipient's key providing the secret
+      /// from which the symmetric key and nonce prefix are derived through
+      /// HKDF-SHA256.
+      ///
+      /// The envelope is composed of the version, the length of the
+      /// ephemeral public point and the point itself, in its compressed
+      /// form, followed by the plain split in chunks encrypted with
+      /// AES-256-GCM and authenticated one by one, the nonces being built
+      /// as for the v3 envelopes, see envelope::Format. The header is
+      /// authenticated along with every chunk.
+      ///
+      /// Over P-256, an envelope is therefore 51 bytes larger than its
+      /// plain, against the size of the modulus and more for the RSA
+      /// envelopes.
+      namespace ecies
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Seal the plain for the owner of the given key, writing the
+        /// envelope to the code's output stream.
+        void
+        seal(::EC_KEY* key,
+             std::istream& plain,
+             std::ostream& code);
+        /// Open the envelope read from the code's input stream with the
+        /// given private key, every chunk being written to the plain's
+        /// output stream once authenticated.
+        void
+        open(::EC_KEY* key,
+             std::istream& code,
+             std::ostream& plain);
+      }
+    }
+  }
+}
+
+#endif
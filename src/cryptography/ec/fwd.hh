@@ -0,0 +1,17 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_FWD_HH
+# define INFINIT_CRYPTOGRAPHY_EC_FWD_HH
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      class PrivateKey;
+      class PublicKey;
+      class KeyPair;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <cryptography/ec/low.hh>
+#include <cryptography/finally.hh>
+#include <cryptography/Error.hh>
+
+#include <elle/log.hh>
+#include <elle/Buffer.hh>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace low
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        // As for DSA, go through the public key's encoding so as to get rid
+        // of the private part.
+        ::EC_KEY*
+        EC_KEY_priv2pub(::EC_KEY* private_key)
+        {
+          ELLE_ASSERT_NEQ(private_key, nullptr);
+
+          unsigned char* buffer = nullptr;
+          int size = 0;
+
+          if ((size = ::i2d_EC_PUBKEY(private_key,
+                                      &buffer)) <= 0)
+            throw Error(
+              elle::sprintf("unable to encode the EC private key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(buffer);
+
+          const unsigned char* _buffer = buffer;
+
+          ::EC_KEY* public_key = nullptr;
+          if ((public_key = ::d2i_EC_PUBKEY(NULL,
+                                            &_buffer,
+                                            size)) == NULL)
+            throw Error(
+              elle::sprintf("unable to decode the EC private key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(public_key);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(buffer);
+          ::OPENSSL_free(buffer);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(public_key);
+
+          return (public_key);
+        }
+
+        ::EC_KEY*
+        EC_KEY_dup(::EC_KEY* key)
+        {
+          ELLE_ASSERT_NEQ(key, nullptr);
+
+          // Increase the reference counter on this object rather
+          // than duplicating the structure.
+          ::EC_KEY_up_ref(key);
+
+          return (key);
+        }
+
+        std::string
+        EC_KEY_point2hex(::EC_KEY* key)
+        {
+          ELLE_ASSERT_NEQ(key, nullptr);
+
+          char* hex = ::EC_POINT_point2hex(::EC_KEY_get0_group(key),
+                                           ::EC_KEY_get0_public_key(key),
+                                           POINT_CONVERSION_COMPRESSED,
+                                           nullptr);
+
+          if (hex == nullptr)
+            throw Error(
+              elle::sprintf("unable to represent the EC public point: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(hex);
+
+          return (std::string(hex));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_LOW_HH
+# define INFINIT_CRYPTOGRAPHY_EC_LOW_HH
+
+# include <string>
+
+# include <openssl/ec.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace low
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Return a copy of the given private key that has been transformed
+        /// into an EC public key.
+        ::EC_KEY*
+        EC_KEY_priv2pub(::EC_KEY* private_key);
+        /// Duplicate an EC key.
+        ::EC_KEY*
+        EC_KEY_dup(::EC_KEY* key);
+        /// Return the hexadecimal representation of the key's public point.
+        std::string
+        EC_KEY_point2hex(::EC_KEY* key);
+      }
+    }
+  }
+}
+
+#endif
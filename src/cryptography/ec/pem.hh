@@ -0,0 +1,73 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_PEM_HH
+# define INFINIT_CRYPTOGRAPHY_EC_PEM_HH
+
+# include <cryptography/ec/PublicKey.hh>
+# include <cryptography/ec/PrivateKey.hh>
+# include <cryptography/ec/KeyPair.hh>
+# include <cryptography/ec/defaults.hh>
+# include <cryptography/pem.hh>
+
+# include <boost/filesystem.hpp>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace pem
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Import an EC public key from a path.
+        PublicKey
+        import_K(boost::filesystem::path const& path,
+                 Oneway const digest_algorithm =
+                   defaults::digest_algorithm);
+        /// Import an EC private key from a path.
+        PrivateKey
+        import_k(boost::filesystem::path const& path,
+                 std::string const& passphrase =
+                   cryptography::pem::defaults::passphrase,
+                 Oneway const digest_algorithm =
+                   defaults::digest_algorithm);
+        /// Import an EC key pair from a path.
+        KeyPair
+        import_keypair(boost::filesystem::path const& path,
+                       std::string const& passphrase =
+                         cryptography::pem::defaults::passphrase,
+                       Oneway const digest_algorithm =
+                         defaults::digest_algorithm);
+        /// Export an EC public key.
+        void
+        export_K(PublicKey const& K,
+                 boost::filesystem::path const& path);
+        /// Export an EC private key, providing the passphrase, cipher and
+        /// mode to encrypt it with.
+        void
+        export_k(PrivateKey const& k,
+                 boost::filesystem::path const& path,
+                 std::string const& passphrase =
+                   cryptography::pem::defaults::passphrase,
+                 Cipher const& cipher =
+                   cryptography::pem::defaults::cipher,
+                 Mode const& mode =
+                   cryptography::pem::defaults::mode);
+        /// Export an EC key pair.
+        void
+        export_keypair(KeyPair const& keypair,
+                       boost::filesystem::path const& path,
+                       std::string const& passphrase =
+                         cryptography::pem::defaults::passphrase,
+                       Cipher const& cipher =
+                         cryptography::pem::defaults::cipher,
+                       Mode const& mode =
+                         cryptography::pem::defaults::mode);
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef INFINIT_CRYPTOGRAPHY_EC_SERIALIZATION_HH
+# define INFINIT_CRYPTOGRAPHY_EC_SERIALIZATION_HH
+
+# include <openssl/ec.h>
+
+# include <cryptography/serialization.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace ec
+    {
+      namespace serialization
+      {
+        /*-----------.
+        | Structures |
+        `-----------*/
+
+        struct EC
+        {
+          typedef ::EC_KEY Type;
+          static constexpr const char* identifier = "ec";
+        };
+      }
+    }
+  }
+}
+
+#endif
@@ -3,8 +3,36 @@
 #include <openssl/err.h>
 #include <openssl/hmac.h>
 #include <openssl/rand.h>
+#include <openssl/rsa.h>
+#include <openssl/sha.h>
+#include <openssl/x509.h>
+
+#if defined(INFINIT_WINDOWS)
+# include <windows.h>
+#else
+# include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <elle/Buffer.hh>
+#include <elle/assert.hh>
+#include <elle/finally.hh>
 #include <elle/log.hh>
 #include <elle/serialization/binary.hh>
 
@@ -12,117 +40,84 @@
 #include <cryptography/Oneway.hh>
 #include <cryptography/Error.hh>
 #include <cryptography/SecretKey.hh>
+#include <cryptography/aead.hh>
+#include <cryptography/context.hh>
 #include <cryptography/cryptography.hh>
 #include <cryptography/envelope.hh>
 #include <cryptography/finally.hh>
+#include <cryptography/hash.hh>
+#include <cryptography/io.hh>
 #include <cryptography/raw.hh>
 #include <cryptography/constants.hh>
 
+ELLE_LOG_COMPONENT("infinit.cryptography.envelope");
+
 namespace infinit
 {
   namespace cryptography
   {
     namespace envelope
     {
-      /*----------.
-      | Functions |
-      `----------*/
+      /*-------------.
+      | Enumerations |
+      `-------------*/
 
-      void
-      seal(::EVP_PKEY* key,
-           ::EVP_CIPHER const* cipher,
-           std::istream& plain,
-           std::ostream& code)
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Format const format)
       {
-        // Make sure the cryptographic system is set up.
-        cryptography::require();
-
-        // The following variables initialization are more complicated than
-        // necessary but have been made for the reader to understand the way
-        // the SealInit() function takes arguments, arrays and not single
-        // values.
-
-        // Create an array with a single public key since only one recipient
-        // will be allowed to decrypt the data.
-        ::EVP_PKEY* keys[1];
-        keys[0] = key;
-
-        // Create an array with a single secret key.
-        unsigned char* _secret =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(::EVP_PKEY_size(keys[0])));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_secret);
-
-        unsigned char* secrets[1];
-        secrets[0] = _secret;
-        int lengths[1];
-
-        // Prepare the memory area to receive the IV.
-        unsigned char* iv =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
-
-        // Initialize the cipher context.
-        ::EVP_CIPHER_CTX context;
-
-        ::EVP_CIPHER_CTX_init(&context);
-
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
-
-        // Initialize the envelope seal operation. This operation generates
-        // a secret key for the provided cipher, and then encrypts that key a
-        // number of times (one for each public key provided in the 'keys'
-        // array, once in our case). This operation also generates an IV and
-        // places it in 'iv'.
-        if (::EVP_SealInit(&context,
-                           cipher,
-                           secrets,
-                           lengths,
-                           iv,
-                           keys,
-                           1) <= 0)
-          throw Error(
-            elle::sprintf("unable to initialize the seal process: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-
-        ELLE_ASSERT_EQ(::EVP_PKEY_size(key), lengths[0]);
-
-        // At this point, before writing the encrypted data in the output
-        // stream, the parameters (secret and IV) need to be written for
-        // the recipient to retrieve them.
-        //
-        // We could for instance serialize the header (secret and IV) through
-        // a serialization layer on top of the output stream and then use the
-        // bare stream to output the encrypted data. Because the serialization
-        // layer may buffer, it is dangerous. Likewise, the serialization format
-        // may change in the future.
-        //
-        // For those reasons, the following simply outputs the secret and IV
-        // whose size is supposed to be known in advanced according to the
-        // cipher used.
+        switch (format)
         {
-          // Write the secret.
-          code.write(reinterpret_cast<const char *>(_secret),
-                     ::EVP_PKEY_size(key));
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to write the secret to the "
-                            "code's output stream: %s",
-                            code.rdstate()));
-
-          // Write the IV.
-          code.write(reinterpret_cast<const char *>(iv),
-                     EVP_MAX_IV_LENGTH);
-          if (!code.good())
+          case Format::v1:
+          {
+            stream << "v1";
+            break;
+          }
+          case Format::v2:
+          {
+            stream << "v2";
+            break;
+          }
+          case Format::v3:
+          {
+            stream << "v3";
+            break;
+          }
+          case Format::v4:
+          {
+            stream << "v4";
+            break;
+          }
+          default:
             throw Error(
-              elle::sprintf("unable to write the IV to the "
-                            "code's output stream: %s",
-                            code.rdstate()));
+              elle::sprintf("unknown envelope format '%s'",
+                            static_cast<int>(format)));
         }
 
+        return (stream);
+      }
+
+      /*---------------.
+      | Static Methods |
+      `---------------*/
+
+      /// The magic number versioned envelopes start with. Note that the
+      /// v1 envelopes start with a wrapped secret, the probability of it
+      /// starting with the magic number being negligible.
+      static char const _magic[8] =
+        {'\x89', 'I', 'E', 'N', 'V', '\r', '\n', '\x1a'};
+      /// The format envelopes are sealed in by default.
+      static std::atomic<Format> _format(Format::v1);
+
+      /// Encrypt the plain's stream with the initialized seal context.
+      static
+      void
+      _seal(::EVP_CIPHER_CTX* context,
+            std::istream& plain,
+            std::ostream& code)
+      {
         // Compute the block size according to the
-        int block_size = ::EVP_CIPHER_CTX_block_size(&context);
+        int block_size = ::EVP_CIPHER_CTX_block_size(context);
 
         // Encrypt the plain's stream.
         std::vector<unsigned char> _input(constants::stream_block_size);
@@ -142,7 +137,7 @@ namespace infinit
           int size_update(0);
 
           // Encrypt the input buffer.
-          if (::EVP_SealUpdate(&context,
+          if (::EVP_SealUpdate(context,
                                _output.data(),
                                &size_update,
                                _input.data(),
@@ -164,7 +159,7 @@ namespace infinit
         // Finalize the encryption process.
         int size_final(0);
 
-        if (::EVP_SealFinal(&context,
+        if (::EVP_SealFinal(context,
                             _output.data(),
                             &size_final) <= 0)
           throw Error(
@@ -179,81 +174,17 @@ namespace infinit
             elle::sprintf("unable to write the encrypted data to the "
                           "code's output stream: %s",
                           code.rdstate()));
-
-        // Clean up the cipher context.
-        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
-          throw Error(
-            elle::sprintf("unable to clean the cipher context: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
-
-        // Release the memory associated with the secret and iv.
-        ::OPENSSL_free(iv);
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(iv);
-
-        ::OPENSSL_free(_secret);
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_secret);
       }
 
+      /// Decrypt the code's stream with the initialized open context.
+      static
       void
-      open(::EVP_PKEY* key,
-           ::EVP_CIPHER const* cipher,
-           std::istream& code,
-           std::ostream& plain)
+      _open(::EVP_CIPHER_CTX* context,
+            std::istream& code,
+            std::ostream& plain)
       {
-        // Make sure the cryptographic system is set up.
-        cryptography::require();
-
-        // Start by extracting the secret and IV from the input
-        // stream.
-        unsigned char* secret =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(::EVP_PKEY_size(key)));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(secret);
-
-        unsigned char* iv =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
-
-        {
-          // Read the secret.
-          code.read(reinterpret_cast<char*>(secret), ::EVP_PKEY_size(key));
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to read the secret from the code's "
-                            "input stream: %s",
-                            code.rdstate()));
-
-          // Read the IV.
-          code.read(reinterpret_cast<char*>(iv), EVP_MAX_IV_LENGTH);
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to read the IV from the code's "
-                            "input stream: %s",
-                            code.rdstate()));
-        }
-
-        // Initialize the cipher context.
-        ::EVP_CIPHER_CTX context;
-
-        ::EVP_CIPHER_CTX_init(&context);
-
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
-
-        // Initialize the envelope open operation.
-        if (::EVP_OpenInit(&context,
-                           cipher,
-                           secret,
-                           ::EVP_PKEY_size(key),
-                           iv,
-                           key) <= 0)
-          throw Error(
-            elle::sprintf("unable to initialize the open process: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-
         // Compute the block size according to the
-        int block_size = ::EVP_CIPHER_CTX_block_size(&context);
+        int block_size = ::EVP_CIPHER_CTX_block_size(context);
 
         // Decrypt the plain's stream.
         std::vector<unsigned char> _input(constants::stream_block_size);
@@ -273,7 +204,7 @@ namespace infinit
           int size_update(0);
 
           // Decrypt the input buffer.
-          if (::EVP_OpenUpdate(&context,
+          if (::EVP_OpenUpdate(context,
                                _output.data(),
                                &size_update,
                                _input.data(),
@@ -295,7 +226,7 @@ namespace infinit
         // Finalize the decryption process.
         int size_final(0);
 
-        if (::EVP_OpenFinal(&context,
+        if (::EVP_OpenFinal(context,
                             _output.data(),
                             &size_final) <= 0)
           throw Error(
@@ -310,20 +241,1702 @@ namespace infinit
             elle::sprintf("unable to write the decrypted data to the "
                           "plain's output stream: %s",
                           plain.rdstate()));
+      }
 
-        // Clean up the cipher context.
-        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+      namespace cache
+      {
+        /*--------.
+        | Classes |
+        `--------*/
+
+        namespace
+        {
+          /// The memory the cached secrets are kept in: a page-aligned
+          /// region locked once, for its whole lifetime, so as not to be
+          /// swapped out, and divided into fixed-size slots.
+          ///
+          /// Note that the region is never unlocked piecemeal since the
+          /// memory locks are not reference-counted: unlocking the memory
+          /// of one secret would unlock the others sharing its pages.
+          class Arena
+          {
+          public:
+            /// The size of a slot, large enough for any cipher's key.
+            static std::size_t const slot = EVP_MAX_KEY_LENGTH;
+
+            Arena(std::size_t const slots):
+              _data(nullptr),
+              _size(slots * slot),
+              _locked(false)
+            {
+#if defined(INFINIT_WINDOWS)
+              this->_data = static_cast<unsigned char*>(
+                ::VirtualAlloc(nullptr, this->_size,
+                               MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+              if (this->_data == nullptr)
+                throw Error("unable to allocate memory for the cached secrets");
+
+              this->_locked = (::VirtualLock(this->_data, this->_size) != 0);
+#else
+              void* data = ::mmap(nullptr, this->_size,
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+              if (data == MAP_FAILED)
+                throw Error("unable to allocate memory for the cached secrets");
+
+              this->_data = static_cast<unsigned char*>(data);
+              this->_locked = (::mlock(this->_data, this->_size) == 0);
+#endif
+
+              // Warn once only since the limit on the locked memory is a
+              // system setting.
+              static std::atomic<bool> warned(false);
+              if (!this->_locked && !warned.exchange(true))
+                ELLE_WARN("unable to lock the memory of the cached secrets, "
+                          "which may be swapped out");
+
+              for (std::size_t i = slots; i > 0; --i)
+                this->_free.push_back(i - 1);
+            }
+
+            Arena(Arena const&) = delete;
+
+            ~Arena()
+            {
+              ::OPENSSL_cleanse(this->_data, this->_size);
+
+#if defined(INFINIT_WINDOWS)
+              if (this->_locked)
+                ::VirtualUnlock(this->_data, this->_size);
+              ::VirtualFree(this->_data, 0, MEM_RELEASE);
+#else
+              if (this->_locked)
+                ::munlock(this->_data, this->_size);
+              ::munmap(this->_data, this->_size);
+#endif
+            }
+
+            /// Return a free slot.
+            std::size_t
+            allocate()
+            {
+              ELLE_ASSERT(!this->_free.empty());
+
+              std::size_t index = this->_free.back();
+              this->_free.pop_back();
+
+              return (index);
+            }
+
+            /// Cleanse the given slot and make it available again.
+            void
+            release(std::size_t const index)
+            {
+              ::OPENSSL_cleanse(this->data(index), slot);
+              this->_free.push_back(index);
+            }
+
+            unsigned char*
+            data(std::size_t const index)
+            {
+              return (this->_data + index * slot);
+            }
+
+          private:
+            unsigned char* _data;
+            std::size_t _size;
+            bool _locked;
+            std::vector<std::size_t> _free;
+          };
+
+          struct Entry
+          {
+            /// The digest of the recipient key's fingerprint and the
+            /// wrapped secret.
+            std::string digest;
+            /// The recipient key's fingerprint, for purging.
+            std::string fingerprint;
+            /// The arena's slot holding the secret.
+            std::size_t slot;
+            std::size_t size;
+            std::chrono::steady_clock::time_point expiration;
+          };
+
+          /// The cache, the most recently used entries first.
+          struct State
+          {
+            std::mutex mutex;
+            bool enabled = false;
+            std::size_t capacity = 0;
+            std::chrono::seconds ttl = std::chrono::seconds(0);
+            std::unique_ptr<Arena> arena;
+            std::list<Entry> entries;
+            std::unordered_map<std::string,
+                               std::list<Entry>::iterator> index;
+            Statistics statistics = Statistics();
+          };
+
+          static
+          State&
+          _state()
+          {
+            static State state;
+
+            return (state);
+          }
+
+          /// Release the given entry, the state's mutex being held.
+          static
+          void
+          _erase(State& state,
+                 std::list<Entry>::iterator iterator)
+          {
+            state.arena->release(iterator->slot);
+            state.index.erase(iterator->digest);
+            state.entries.erase(iterator);
+          }
+
+          /// Release every entry, the state's mutex being held.
+          static
+          void
+          _clear(State& state)
+          {
+            while (!state.entries.empty())
+              _erase(state, state.entries.begin());
+          }
+        }
+      }
+
+      /// Unwrap the secret with the given key, as EVP_OpenInit() does, and
+      /// hand the unwrapped secret to the given function.
+      ///
+      /// Should the cache be enabled, the unwrapped secret is looked up
+      /// first so that opening the same envelope again does not pay for
+      /// the private key operation.
+      static
+      void
+      _unwrap(::EVP_PKEY* key,
+              unsigned char const* secret,
+              int const length,
+              std::function<void (unsigned char const*,
+                                  std::size_t)> const& use)
+      {
+        cache::State& state = cache::_state();
+
+        bool enabled;
+        {
+          std::lock_guard<std::mutex> lock(state.mutex);
+          enabled = state.enabled;
+        }
+
+        // Identify the secret by the recipient key along with the wrapped
+        // secret so that a hit never bypasses a key unable to unwrap it.
+        std::string fingerprint;
+        std::string digest;
+
+        if (enabled)
+        {
+          elle::Buffer _fingerprint = envelope::fingerprint(key);
+          fingerprint.assign(
+            reinterpret_cast<char const*>(_fingerprint.contents()),
+            _fingerprint.size());
+          elle::Buffer _digest = _fingerprint;
+          _digest.append(secret, length);
+          _digest = hash(_digest, Oneway::sha256);
+          digest.assign(
+            reinterpret_cast<char const*>(_digest.contents()),
+            _digest.size());
+
+          // Copy the secret out of the cache so that the cipher is not
+          // initialized in the critical section.
+          unsigned char cached[cache::Arena::slot];
+          std::size_t size = 0;
+          elle::SafeFinally cleanse(
+            [&] { ::OPENSSL_cleanse(cached, sizeof (cached)); });
+
+          {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            auto iterator = state.index.find(digest);
+
+            if (iterator != state.index.end())
+            {
+              auto entry = iterator->second;
+
+              if (entry->expiration > std::chrono::steady_clock::now())
+              {
+                state.statistics.hits++;
+                state.entries.splice(state.entries.begin(),
+                                     state.entries,
+                                     entry);
+                ::memcpy(cached, state.arena->data(entry->slot), entry->size);
+                size = entry->size;
+              }
+              else
+              {
+                state.statistics.expirations++;
+                cache::_erase(state, entry);
+              }
+            }
+
+            if (size == 0)
+              state.statistics.misses++;
+          }
+
+          if (size != 0)
+          {
+            use(cached, size);
+
+            return;
+          }
+        }
+
+        // Unwrap the secret outside the critical section.
+        std::unique_ptr<unsigned char[]> unwrapped(
+          new unsigned char[::EVP_PKEY_size(key)]);
+        elle::SafeFinally cleanse(
+          [&] { ::OPENSSL_cleanse(unwrapped.get(), ::EVP_PKEY_size(key)); });
+
+        int size = ::EVP_PKEY_decrypt_old(unwrapped.get(),
+                                          secret,
+                                          length,
+                                          key);
+        if (size <= 0)
           throw Error(
-            elle::sprintf("unable to clean the cipher context: %s",
+            elle::sprintf("unable to unwrap the secret: %s",
                           ::ERR_error_string(ERR_get_error(), nullptr)));
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
 
-        // Release the memory associated with the secret and iv.
-        OPENSSL_free(iv);
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(iv);
+        use(unwrapped.get(), size);
 
-        OPENSSL_free(secret);
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(secret);
+        if (!enabled)
+          return;
+
+        // Secrets not fitting in a slot are not cached, no cipher having
+        // such keys.
+        if (static_cast<std::size_t>(size) > cache::Arena::slot)
+          return;
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        // The cache may have been disabled or the secret inserted by
+        // another thread in the meantime.
+        if (!state.enabled || (state.index.count(digest) != 0))
+          return;
+
+        // Make room for the secret, the arena having a slot per entry.
+        while (state.entries.size() >= state.capacity)
+        {
+          state.statistics.evictions++;
+          cache::_erase(state, std::prev(state.entries.end()));
+        }
+
+        std::size_t slot = state.arena->allocate();
+        ::memcpy(state.arena->data(slot), unwrapped.get(), size);
+
+        state.entries.push_front(
+          cache::Entry{
+            digest,
+            fingerprint,
+            slot,
+            static_cast<std::size_t>(size),
+            std::chrono::steady_clock::now() + state.ttl});
+        state.index[digest] = state.entries.begin();
+      }
+
+      /// Unwrap the secret and initialize the cipher context for opening.
+      static
+      void
+      _initialize(::EVP_CIPHER_CTX* context,
+                  ::EVP_CIPHER const* cipher,
+                  unsigned char const* secret,
+                  int const length,
+                  unsigned char const* iv,
+                  ::EVP_PKEY* key)
+      {
+        _unwrap(
+          key, secret, length,
+          [&] (unsigned char const* unwrapped,
+               std::size_t const size)
+          {
+            if ((::EVP_DecryptInit_ex(context, cipher, nullptr,
+                                      nullptr, nullptr) <= 0) ||
+                (::EVP_CIPHER_CTX_set_key_length(context, size) <= 0) ||
+                (::EVP_DecryptInit_ex(context, nullptr, nullptr,
+                                      unwrapped, iv) <= 0))
+              throw Error(
+                elle::sprintf("unable to initialize the open process: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+          });
+      }
+
+      /// Write the recipients' slots, every wrapped secret being preceded
+      /// by the associated, possibly empty, key identifier.
+      static
+      void
+      _write_slots(std::ostream& code,
+                   std::vector<elle::Buffer> const& ids,
+                   std::vector<unsigned char*> const& secrets,
+                   std::vector<int> const& lengths)
+      {
+        io::write(code, ids.size(), 2, "number of recipients");
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+          if (ids[i].size() > 0xff)
+            throw Error(
+              elle::sprintf("the key identifier is too long: %s bytes",
+                            ids[i].size()));
+
+          io::write(code, ids[i].size(), 1, "key identifier length");
+          io::write(code, ids[i].contents(), ids[i].size(), "key identifier");
+          io::write(code, lengths[i], 2, "secret length");
+          io::write(code, secrets[i], lengths[i], "secret");
+        }
+      }
+
+      /// A recipient's slot: its key identifier, possibly empty, and the
+      /// secret wrapped with its key.
+      struct Slot
+      {
+        std::vector<unsigned char> id;
+        std::vector<unsigned char> secret;
+      };
+
+      /// Read the recipients' slots.
+      static
+      std::vector<Slot>
+      _parse_slots(std::istream& code)
+      {
+        std::vector<Slot> slots(io::read(code, 2, "number of recipients"));
+
+        for (auto& slot: slots)
+        {
+          slot.id.resize(io::read(code, 1, "key identifier length"));
+          io::read(code, slot.id.data(), slot.id.size(), "key identifier");
+          slot.secret.resize(io::read(code, 2, "secret length"));
+          io::read(code, slot.secret.data(), slot.secret.size(), "secret");
+        }
+
+        return (slots);
+      }
+
+      /// Return the index of the given key's slot.
+      ///
+      /// The slot whose key identifier matches the key's fingerprint is
+      /// picked, the first anonymous slot being used otherwise, so that a
+      /// single secret be unwrapped.
+      static
+      std::size_t
+      _select(::EVP_PKEY* key,
+              std::vector<Slot> const& slots)
+      {
+        elle::Buffer _fingerprint;
+        std::size_t anonymous = slots.size();
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+          auto const& id = slots[i].id;
+
+          if (id.empty())
+          {
+            if (anonymous == slots.size())
+              anonymous = i;
+
+            continue;
+          }
+
+          // Compute the fingerprint lazily since anonymous envelopes do
+          // not need it.
+          if (_fingerprint.size() == 0)
+            _fingerprint = fingerprint(key);
+
+          if ((id.size() == _fingerprint.size()) &&
+              (::memcmp(id.data(), _fingerprint.contents(), id.size()) == 0))
+            return (i);
+        }
+
+        if (anonymous == slots.size())
+          throw Error("the envelope has not been sealed for this key");
+
+        return (anonymous);
+      }
+
+      /// Pick, among the recipients' slots, the one to open along with the
+      /// key to open it with.
+      typedef
+        std::function<std::pair< ::EVP_PKEY*, std::size_t> (
+                        std::vector<Slot> const&)>
+        Selector;
+
+      /// Read the recipients' slots, returning the wrapped secret of the
+      /// selected one along with the key to unwrap it with.
+      static
+      std::vector<unsigned char>
+      _read_slots(Selector const& select,
+                  std::istream& code,
+                  ::EVP_PKEY*& key)
+      {
+        std::vector<Slot> slots = _parse_slots(code);
+        auto selection = select(slots);
+
+        ELLE_ASSERT_NEQ(selection.first, nullptr);
+        ELLE_ASSERT_LT(selection.second, slots.size());
+
+        key = selection.first;
+
+        return (std::move(slots[selection.second].secret));
+      }
+
+      /// Seal the plain in a v2 envelope for the given keys, every wrapped
+      /// secret being preceded by the associated, possibly empty, key
+      /// identifier.
+      ///
+      /// The header is composed of the magic number, the version, the
+      /// cipher's NID, the IV length and the IV, followed by the number of
+      /// recipients and their slots.
+      static
+      void
+      _seal_v2(std::vector< ::EVP_PKEY*> const& keys,
+               std::vector<elle::Buffer> const& ids,
+               ::EVP_CIPHER const* cipher,
+               std::istream& plain,
+               std::ostream& code)
+      {
+        ELLE_ASSERT_EQ(keys.size(), ids.size());
+
+        if (keys.empty())
+          throw Error("unable to seal an envelope for no recipient");
+
+        if (keys.size() > 0xffff)
+          throw Error(
+            elle::sprintf("unable to seal an envelope for more than %s "
+                          "recipients", 0xffff));
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Allocate a secret per recipient.
+        std::vector<std::vector<unsigned char>> _secrets;
+        std::vector<unsigned char*> secrets;
+        std::vector<int> lengths(keys.size());
+
+        for (auto key: keys)
+        {
+          _secrets.emplace_back(::EVP_PKEY_size(key));
+          secrets.push_back(_secrets.back().data());
+        }
+
+        std::vector<unsigned char> iv(EVP_MAX_IV_LENGTH);
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        // Generate a single secret and IV, the secret being wrapped with
+        // every one of the keys.
+        if (::EVP_SealInit(&context,
+                           cipher,
+                           secrets.data(),
+                           lengths.data(),
+                           iv.data(),
+                           const_cast< ::EVP_PKEY**>(keys.data()),
+                           keys.size()) <= 0)
+          throw Error(
+            elle::sprintf("unable to initialize the seal process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        int iv_length = ::EVP_CIPHER_iv_length(cipher);
+
+        io::write(code, _magic, sizeof (_magic), "magic number");
+        io::write(code, static_cast<uint8_t>(Format::v2), 1, "version");
+        io::write(code, ::EVP_CIPHER_nid(cipher), 2, "cipher");
+        io::write(code, iv_length, 1, "IV length");
+        io::write(code, iv.data(), iv_length, "IV");
+        _write_slots(code, ids, secrets, lengths);
+
+        // Encrypt the payload once for all the recipients.
+        _seal(&context, plain, code);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      }
+
+      /// Open a v2 envelope whose magic number and version have already
+      /// been read.
+      static
+      void
+      _open_v2(Selector const& select,
+               std::istream& code,
+               std::ostream& plain)
+      {
+        // Resolve the cipher the envelope has been sealed with.
+        uint32_t nid = io::read(code, 2, "cipher");
+        ::EVP_CIPHER const* cipher = ::EVP_get_cipherbynid(nid);
+        if (cipher == nullptr)
+          throw Error(
+            elle::sprintf("unknown envelope cipher %s", nid));
+
+        // Read the IV.
+        uint32_t iv_length = io::read(code, 1, "IV length");
+        if (iv_length != static_cast<uint32_t>(::EVP_CIPHER_iv_length(cipher)))
+          throw Error(
+            elle::sprintf("the envelope's IV length %s does not match the "
+                          "cipher's", iv_length));
+
+        std::vector<unsigned char> iv(std::max(iv_length, 1u));
+        io::read(code, iv.data(), iv_length, "IV");
+
+        ::EVP_PKEY* key = nullptr;
+        std::vector<unsigned char> secret = _read_slots(select, code, key);
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        _initialize(&context,
+                    cipher,
+                    secret.data(),
+                    secret.size(),
+                    iv.data(),
+                    key);
+
+        _open(&context, code, plain);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      }
+
+      /// The largest chunks accepted when opening, bounding the memory an
+      /// envelope can make the reader allocate.
+      static uint32_t const _chunk_size_maximum = 16 * 1024 * 1024;
+
+      /// Return the AES-GCM cipher whose key length is the given AES
+      /// cipher's, v3 envelopes being always authenticated.
+      static
+      ::EVP_CIPHER const*
+      _gcm(::EVP_CIPHER const* cipher)
+      {
+        switch (::EVP_CIPHER_nid(cipher))
+        {
+          case NID_aes_128_cbc:
+          case NID_aes_128_ecb:
+          case NID_aes_128_cfb128:
+          case NID_aes_128_ofb128:
+          case NID_aes_128_gcm:
+            return (::EVP_aes_128_gcm());
+          case NID_aes_192_cbc:
+          case NID_aes_192_ecb:
+          case NID_aes_192_cfb128:
+          case NID_aes_192_ofb128:
+          case NID_aes_192_gcm:
+            return (::EVP_aes_192_gcm());
+          case NID_aes_256_cbc:
+          case NID_aes_256_ecb:
+          case NID_aes_256_cfb128:
+          case NID_aes_256_ofb128:
+          case NID_aes_256_gcm:
+            return (::EVP_aes_256_gcm());
+          default:
+            throw Error(
+              elle::sprintf("v3 envelopes require an AES cipher, not %s",
+                            ::OBJ_nid2sn(::EVP_CIPHER_nid(cipher))));
+        }
+      }
+
+      /// Return the data authenticated along with every chunk of a v3
+      /// envelope: the magic number, the version, the cipher, the chunk
+      /// size and the nonce prefix.
+      static
+      std::string
+      _preamble(::EVP_CIPHER const* cipher,
+                uint32_t const chunk_size,
+                unsigned char const* prefix)
+      {
+        std::stringstream preamble;
+
+        io::write(preamble, _magic, sizeof (_magic), "magic number");
+        io::write(preamble, static_cast<uint8_t>(Format::v3), 1, "version");
+        io::write(preamble, ::EVP_CIPHER_nid(cipher), 2, "cipher");
+        io::write(preamble, chunk_size, 4, "chunk size");
+        io::write(preamble, aead::prefix_size, 1, "nonce prefix length");
+        io::write(preamble, prefix, aead::prefix_size, "nonce prefix");
+
+        return (preamble.str());
+      }
+
+      /// Seal the plain in a v3 envelope: the plain is split in chunks of
+      /// the given size, every one being encrypted with AES-GCM and
+      /// authenticated independently following the STREAM construction,
+      /// the nonce being made of a random prefix, the chunk counter and a
+      /// flag marking the final chunk.
+      ///
+      /// The header is composed of the preamble, see _preamble(), followed
+      /// by the recipients' slots, the chunks, each followed by its tag,
+      /// coming next.
+      static
+      void
+      _seal_v3(std::vector< ::EVP_PKEY*> const& keys,
+               std::vector<elle::Buffer> const& ids,
+               ::EVP_CIPHER const* cipher,
+               std::istream& plain,
+               std::ostream& code,
+               uint32_t const chunk_size)
+      {
+        ELLE_ASSERT_EQ(keys.size(), ids.size());
+
+        if (keys.empty())
+          throw Error("unable to seal an envelope for no recipient");
+
+        if (keys.size() > 0xffff)
+          throw Error(
+            elle::sprintf("unable to seal an envelope for more than %s "
+                          "recipients", 0xffff));
+
+        if ((chunk_size == 0) || (chunk_size > _chunk_size_maximum))
+          throw Error(
+            elle::sprintf("invalid chunk size %s", chunk_size));
+
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        cipher = _gcm(cipher);
+
+        // Generate the secret and the nonce prefix.
+        std::vector<unsigned char> secret(::EVP_CIPHER_key_length(cipher));
+        unsigned char prefix[aead::prefix_size];
+
+        elle::SafeFinally cleanse(
+          [&] { ::OPENSSL_cleanse(secret.data(), secret.size()); });
+
+        if ((::RAND_bytes(secret.data(), secret.size()) <= 0) ||
+            (::RAND_bytes(prefix, sizeof (prefix)) <= 0))
+          throw Error(
+            elle::sprintf("unable to generate the envelope's secret: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        // Wrap the secret with every one of the keys.
+        std::vector<std::vector<unsigned char>> _secrets;
+        std::vector<unsigned char*> secrets;
+        std::vector<int> lengths;
+
+        for (auto key: keys)
+        {
+          _secrets.emplace_back(::EVP_PKEY_size(key));
+          secrets.push_back(_secrets.back().data());
+
+          int length = ::EVP_PKEY_encrypt_old(secrets.back(),
+                                              secret.data(),
+                                              secret.size(),
+                                              key);
+          if (length <= 0)
+            throw Error(
+              elle::sprintf("unable to wrap the secret: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          lengths.push_back(length);
+        }
+
+        std::string preamble = _preamble(cipher, chunk_size, prefix);
+
+        io::write(code, preamble.data(), preamble.size(), "preamble");
+        _write_slots(code, ids, secrets, lengths);
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        if ((::EVP_EncryptInit_ex(&context, cipher, nullptr,
+                                  nullptr, nullptr) <= 0) ||
+            (::EVP_CIPHER_CTX_ctrl(&context, EVP_CTRL_GCM_SET_IVLEN,
+                                   aead::nonce_size, nullptr) <= 0) ||
+            (::EVP_EncryptInit_ex(&context, nullptr, nullptr,
+                                  secret.data(), nullptr) <= 0))
+          throw Error(
+            elle::sprintf("unable to initialize the seal process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        aead::seal(&context, prefix,
+                   elle::ConstWeakBuffer(preamble.data(), preamble.size()),
+                   chunk_size, plain, code);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      }
+
+      /// Open a v3 envelope whose magic number and version have already
+      /// been read.
+      ///
+      /// Every chunk is written to the plain's output stream as soon as it
+      /// has been authenticated, the memory being bounded by the chunk
+      /// size. Note that an error is reported should the envelope be
+      /// truncated, the chunks written so far being authentic but the
+      /// plain incomplete.
+      static
+      void
+      _open_v3(Selector const& select,
+               std::istream& code,
+               std::ostream& plain)
+      {
+        uint32_t nid = io::read(code, 2, "cipher");
+        ::EVP_CIPHER const* cipher = ::EVP_get_cipherbynid(nid);
+        if ((cipher == nullptr) ||
+            (EVP_CIPHER_mode(cipher) != EVP_CIPH_GCM_MODE))
+          throw Error(
+            elle::sprintf("invalid v3 envelope cipher %s", nid));
+
+        uint32_t chunk_size = io::read(code, 4, "chunk size");
+        if ((chunk_size == 0) || (chunk_size > _chunk_size_maximum))
+          throw Error(
+            elle::sprintf("invalid chunk size %s", chunk_size));
+
+        if (io::read(code, 1, "nonce prefix length") != aead::prefix_size)
+          throw Error("invalid nonce prefix length");
+
+        unsigned char prefix[aead::prefix_size];
+        io::read(code, prefix, sizeof (prefix), "nonce prefix");
+
+        std::string preamble = _preamble(cipher, chunk_size, prefix);
+        ::EVP_PKEY* key = nullptr;
+        std::vector<unsigned char> secret = _read_slots(select, code, key);
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        _unwrap(
+          key, secret.data(), secret.size(),
+          [&] (unsigned char const* unwrapped,
+               std::size_t const size)
+          {
+            if ((static_cast<int>(size) !=
+                 ::EVP_CIPHER_key_length(cipher)) ||
+                (::EVP_DecryptInit_ex(&context, cipher, nullptr,
+                                      nullptr, nullptr) <= 0) ||
+                (::EVP_CIPHER_CTX_ctrl(&context, EVP_CTRL_GCM_SET_IVLEN,
+                                       aead::nonce_size, nullptr) <= 0) ||
+                (::EVP_DecryptInit_ex(&context, nullptr, nullptr,
+                                      unwrapped, nullptr) <= 0))
+              throw Error(
+                elle::sprintf("unable to initialize the open process: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+          });
+
+        aead::open(&context, prefix,
+                   elle::ConstWeakBuffer(preamble.data(), preamble.size()),
+                   chunk_size, code, plain);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      }
+
+      /// The number of bytes OAEP adds to the plain, OpenSSL relying on
+      /// SHA-1: a byte, twice the digest and a separator byte.
+      static std::size_t const _oaep_footprint = 2 * SHA_DIGEST_LENGTH + 2;
+
+      /// Return the size of the largest plain which can be sealed in a v4
+      /// envelope for the given key.
+      static
+      std::size_t
+      _direct_capacity(::EVP_PKEY* key)
+      {
+        int size = ::EVP_PKEY_size(key);
+
+        if (size <= static_cast<int>(_oaep_footprint))
+          return (0);
+
+        return (size - _oaep_footprint);
+      }
+
+      /// Set the context up for encrypting or decrypting with OAEP.
+      static
+      void
+      _oaep(::EVP_PKEY_CTX* context)
+      {
+        if (::EVP_PKEY_CTX_set_rsa_padding(context,
+                                           RSA_PKCS1_OAEP_PADDING) <= 0)
+          throw Error(
+            elle::sprintf("unable to set the EVP_PKEY context's padding: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      /// Write the body of a v4 envelope i.e the key identifier followed by
+      /// the plain encrypted with the key.
+      static
+      void
+      _write_v4(::EVP_PKEY* key,
+                elle::ConstWeakBuffer const& plain,
+                elle::ConstWeakBuffer const& id,
+                std::ostream& code)
+      {
+        if (id.size() > 0xff)
+          throw Error(
+            elle::sprintf("the key identifier is too long: %s bytes",
+                          id.size()));
+
+        if (plain.size() > _direct_capacity(key))
+          throw Error(
+            elle::sprintf("the plain is too large to be directly encrypted: "
+                          "%s bytes", plain.size()));
+
+        elle::Buffer _code;
+
+        // Rely on the cached contexts, as the key classes do.
+        context::cache::apply(
+          key,
+          ::EVP_PKEY_encrypt_init,
+          RSA_PKCS1_OAEP_PADDING,
+          _oaep,
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            _code = raw::asymmetric::encrypt(context, plain);
+          });
+
+        io::write(code, id.size(), 1, "key identifier length");
+        io::write(code, id.contents(), id.size(), "key identifier");
+        io::write(code, _code.size(), 2, "code length");
+        io::write(code, _code.contents(), _code.size(), "code");
+      }
+
+      /// Read the body of a v4 envelope, returning the recipient's slot
+      /// i.e its key identifier along with the encrypted plain in place of
+      /// the wrapped secret.
+      static
+      Slot
+      _read_v4(std::istream& code)
+      {
+        Slot slot;
+
+        slot.id.resize(io::read(code, 1, "key identifier length"));
+        io::read(code, slot.id.data(), slot.id.size(), "key identifier");
+        slot.secret.resize(io::read(code, 2, "code length"));
+        io::read(code, slot.secret.data(), slot.secret.size(), "code");
+
+        return (slot);
+      }
+
+      /// Decrypt the plain of a v4 envelope with the given key.
+      static
+      elle::Buffer
+      _decrypt_v4(::EVP_PKEY* key,
+                  Slot const& slot)
+      {
+        elle::Buffer plain;
+
+        context::cache::apply(
+          key,
+          ::EVP_PKEY_decrypt_init,
+          RSA_PKCS1_OAEP_PADDING,
+          _oaep,
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            plain = raw::asymmetric::decrypt(
+              context,
+              elle::ConstWeakBuffer(slot.secret.data(), slot.secret.size()));
+          });
+
+        return (plain);
+      }
+
+      /// Seal the plain in a v4 envelope: the magic number and the version
+      /// are followed by the key identifier and the plain encrypted with
+      /// the key.
+      static
+      void
+      _seal_v4(::EVP_PKEY* key,
+               elle::ConstWeakBuffer const& plain,
+               elle::ConstWeakBuffer const& id,
+               std::ostream& code)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Encrypt first so that nothing is written should the plain not
+        // fit in the key's modulus.
+        std::stringstream body;
+
+        _write_v4(key, plain, id, body);
+
+        io::write(code, _magic, sizeof (_magic), "magic number");
+        io::write(code, static_cast<uint8_t>(Format::v4), 1, "version");
+        io::write(code, body.str().data(), body.str().size(), "body");
+      }
+
+      /// Open a v4 envelope whose magic number and version have already
+      /// been read.
+      static
+      void
+      _open_v4(Selector const& select,
+               std::istream& code,
+               std::ostream& plain)
+      {
+        std::vector<Slot> slots;
+        slots.push_back(_read_v4(code));
+
+        auto selection = select(slots);
+
+        ELLE_ASSERT_NEQ(selection.first, nullptr);
+
+        elle::Buffer _plain = _decrypt_v4(selection.first, slots.front());
+        elle::SafeFinally cleanse(
+          [&] { ::OPENSSL_cleanse(_plain.mutable_contents(), _plain.size()); });
+
+        io::write(plain, _plain.contents(), _plain.size(), "plain");
+      }
+
+      namespace
+      {
+        /// A stream buffer handing out the given bytes, read ahead, before
+        /// the rest of the given stream.
+        class Prefixed:
+          public std::streambuf
+        {
+        public:
+          Prefixed(std::vector<char>& head,
+                   std::istream& rest):
+            _rest(rest)
+          {
+            this->setg(head.data(), head.data(), head.data() + head.size());
+          }
+
+        protected:
+          int_type
+          underflow() override
+          {
+            if (this->gptr() < this->egptr())
+              return (traits_type::to_int_type(*this->gptr()));
+
+            this->_rest.read(this->_buffer, sizeof (this->_buffer));
+            if (this->_rest.bad())
+              throw Error(
+                elle::sprintf("unable to read the plain's input stream: %s",
+                              this->_rest.rdstate()));
+
+            if (this->_rest.gcount() == 0)
+              return (traits_type::eof());
+
+            this->setg(this->_buffer,
+                       this->_buffer,
+                       this->_buffer + this->_rest.gcount());
+
+            return (traits_type::to_int_type(*this->gptr()));
+          }
+
+        private:
+          std::istream& _rest;
+          char _buffer[constants::stream_block_size];
+        };
+      }
+
+      /// Open a versioned envelope whose magic number has already been
+      /// read.
+      static
+      void
+      _open_versioned(Selector const& select,
+                      std::istream& code,
+                      std::ostream& plain)
+      {
+        uint32_t version = io::read(code, 1, "version");
+
+        switch (version)
+        {
+          case static_cast<uint8_t>(Format::v2):
+          {
+            _open_v2(select, code, plain);
+            break;
+          }
+          case static_cast<uint8_t>(Format::v3):
+          {
+            _open_v3(select, code, plain);
+            break;
+          }
+          case static_cast<uint8_t>(Format::v4):
+          {
+            _open_v4(select, code, plain);
+            break;
+          }
+          default:
+            throw Error(
+              elle::sprintf("unknown envelope version %s", version));
+        }
+      }
+
+      /// Seal the plain in a v1 envelope i.e the wrapped secret followed
+      /// by the IV and the code, the reader being expected to know the
+      /// cipher.
+      static
+      void
+      _seal_v1(::EVP_PKEY* key,
+               ::EVP_CIPHER const* cipher,
+               std::istream& plain,
+               std::ostream& code)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // The following variables initialization are more complicated than
+        // necessary but have been made for the reader to understand the way
+        // the SealInit() function takes arguments, arrays and not single
+        // values.
+
+        // Create an array with a single public key since only one recipient
+        // will be allowed to decrypt the data.
+        ::EVP_PKEY* keys[1];
+        keys[0] = key;
+
+        // Create an array with a single secret key.
+        unsigned char* _secret =
+          reinterpret_cast<unsigned char*>(
+            ::OPENSSL_malloc(::EVP_PKEY_size(keys[0])));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_secret);
+
+        unsigned char* secrets[1];
+        secrets[0] = _secret;
+        int lengths[1];
+
+        // Prepare the memory area to receive the IV.
+        unsigned char* iv =
+          reinterpret_cast<unsigned char*>(
+            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        // Initialize the envelope seal operation. This operation generates
+        // a secret key for the provided cipher, and then encrypts that key a
+        // number of times (one for each public key provided in the 'keys'
+        // array, once in our case). This operation also generates an IV and
+        // places it in 'iv'.
+        if (::EVP_SealInit(&context,
+                           cipher,
+                           secrets,
+                           lengths,
+                           iv,
+                           keys,
+                           1) <= 0)
+          throw Error(
+            elle::sprintf("unable to initialize the seal process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        ELLE_ASSERT_EQ(::EVP_PKEY_size(key), lengths[0]);
+
+        // At this point, before writing the encrypted data in the output
+        // stream, the parameters (secret and IV) need to be written for
+        // the recipient to retrieve them.
+        //
+        // We could for instance serialize the header (secret and IV) through
+        // a serialization layer on top of the output stream and then use the
+        // bare stream to output the encrypted data. Because the serialization
+        // layer may buffer, it is dangerous. Likewise, the serialization format
+        // may change in the future.
+        //
+        // For those reasons, the following simply outputs the secret and IV
+        // whose size is supposed to be known in advanced according to the
+        // cipher used.
+        {
+          // Write the secret.
+          code.write(reinterpret_cast<const char *>(_secret),
+                     ::EVP_PKEY_size(key));
+          if (!code.good())
+            throw Error(
+              elle::sprintf("unable to write the secret to the "
+                            "code's output stream: %s",
+                            code.rdstate()));
+
+          // Write the IV.
+          code.write(reinterpret_cast<const char *>(iv),
+                     EVP_MAX_IV_LENGTH);
+          if (!code.good())
+            throw Error(
+              elle::sprintf("unable to write the IV to the "
+                            "code's output stream: %s",
+                            code.rdstate()));
+        }
+
+        _seal(&context, plain, code);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+
+        // Release the memory associated with the secret and iv.
+        ::OPENSSL_free(iv);
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(iv);
+
+        ::OPENSSL_free(_secret);
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_secret);
+      }
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      void
+      format(Format const format)
+      {
+        _format.store(format);
+      }
+
+      Format
+      format()
+      {
+        return (_format.load());
+      }
+
+      void
+      seal(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code)
+      {
+        seal(key, cipher, plain, code, _format.load());
+      }
+
+      void
+      seal(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code,
+           Format const format,
+           elle::ConstWeakBuffer const& id)
+      {
+        switch (format)
+        {
+          case Format::v1:
+          {
+            if (id.size() != 0)
+              throw Error("v1 envelopes cannot embed a key identifier");
+
+            _seal_v1(key, cipher, plain, code);
+            break;
+          }
+          case Format::v2:
+          {
+            std::vector<elle::Buffer> ids;
+            ids.emplace_back(id.contents(), id.size());
+
+            _seal_v2({key}, ids, cipher, plain, code);
+            break;
+          }
+          case Format::v3:
+          {
+            std::vector<elle::Buffer> ids;
+            ids.emplace_back(id.contents(), id.size());
+
+            _seal_v3({key}, ids, cipher, plain, code,
+                     constants::envelope_chunk_size);
+            break;
+          }
+          case Format::v4:
+          {
+            // Read ahead one byte more than a v4 envelope can hold to know
+            // whether the plain fits.
+            std::size_t capacity = _direct_capacity(key);
+            std::vector<char> head(capacity + 1);
+
+            plain.read(head.data(), head.size());
+            if (plain.bad())
+              throw Error(
+                elle::sprintf("unable to read the plain's input stream: %s",
+                              plain.rdstate()));
+
+            head.resize(plain.gcount());
+
+            elle::SafeFinally cleanse(
+              [&] { ::OPENSSL_cleanse(head.data(), head.size()); });
+
+            if (head.size() <= capacity)
+            {
+              _seal_v4(key,
+                       elle::ConstWeakBuffer(head.data(), head.size()),
+                       id,
+                       code);
+              break;
+            }
+
+            // Seal the larger plains in a v2 envelope, the bytes read ahead
+            // coming first.
+            Prefixed buffer(head, plain);
+            std::istream _plain(&buffer);
+            std::vector<elle::Buffer> ids;
+            ids.emplace_back(id.contents(), id.size());
+
+            _seal_v2({key}, ids, cipher, _plain, code);
+            break;
+          }
+          default:
+            throw Error(
+              elle::sprintf("unknown envelope format '%s'",
+                            static_cast<int>(format)));
+        }
+      }
+
+      void
+      seal(std::vector< ::EVP_PKEY*> const& keys,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code,
+           Format const format)
+      {
+        std::vector<elle::Buffer> ids;
+
+        for (auto key: keys)
+          ids.push_back(fingerprint(key));
+
+        switch (format)
+        {
+          case Format::v2:
+          {
+            _seal_v2(keys, ids, cipher, plain, code);
+            break;
+          }
+          case Format::v3:
+          {
+            _seal_v3(keys, ids, cipher, plain, code,
+                     constants::envelope_chunk_size);
+            break;
+          }
+          default:
+            throw Error(
+              elle::sprintf("envelopes for several recipients cannot be "
+                            "sealed in the %s format", format));
+        }
+      }
+
+      void
+      rewrap(::EVP_PKEY* from,
+             ::EVP_PKEY* to,
+             ::EVP_CIPHER const* cipher,
+             std::istream& header_in,
+             std::ostream& header_out)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Unwrap the secret with the former key and wrap it with the new
+        // one, the payload being left untouched.
+        auto rewrap = [&] (std::vector<unsigned char> const& secret)
+          {
+            std::vector<unsigned char> wrapped(::EVP_PKEY_size(to));
+            int size = 0;
+
+            _unwrap(from, secret.data(), secret.size(),
+                    [&] (unsigned char const* unwrapped,
+                         std::size_t const length)
+                    {
+                      size = ::EVP_PKEY_encrypt_old(wrapped.data(),
+                                                    unwrapped,
+                                                    length,
+                                                    to);
+                    });
+
+            if (size <= 0)
+              throw Error(
+                elle::sprintf("unable to wrap the secret: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+            wrapped.resize(size);
+
+            return (wrapped);
+          };
+
+        ELLE_ASSERT_GTE(::EVP_PKEY_size(from),
+                        static_cast<int>(sizeof (_magic)));
+
+        std::vector<unsigned char> secret(::EVP_PKEY_size(from));
+
+        io::read(header_in, secret.data(), sizeof (_magic), "secret");
+
+        if (::memcmp(secret.data(), _magic, sizeof (_magic)) != 0)
+        {
+          // A v1 header, made of the wrapped secret and the IV.
+          io::read(header_in,
+                   secret.data() + sizeof (_magic),
+                   secret.size() - sizeof (_magic),
+                   "secret");
+
+          // As _seal_v1() and open(), regardless of the cipher's IV length.
+          std::vector<unsigned char> iv(EVP_MAX_IV_LENGTH);
+          io::read(header_in, iv.data(), iv.size(), "IV");
+
+          std::vector<unsigned char> wrapped = rewrap(secret);
+
+          if (static_cast<int>(wrapped.size()) != ::EVP_PKEY_size(to))
+            throw Error("unable to rewrap a v1 envelope's secret");
+
+          io::write(header_out, wrapped.data(), wrapped.size(), "secret");
+          io::write(header_out, iv.data(), iv.size(), "IV");
+
+          return;
+        }
+
+        io::write(header_out, _magic, sizeof (_magic), "magic number");
+
+        // Copy the preamble as is, v3 envelopes authenticating it.
+        uint32_t version = io::read(header_in, 1, "version");
+        io::write(header_out, version, 1, "version");
+
+        auto copy = [&] (std::size_t const bytes,
+                         char const* what)
+          {
+            uint32_t value = io::read(header_in, bytes, what);
+            io::write(header_out, value, bytes, what);
+
+            return (value);
+          };
+
+        switch (version)
+        {
+          case static_cast<uint8_t>(Format::v2):
+          {
+            copy(2, "cipher");
+
+            std::vector<unsigned char> iv(copy(1, "IV length"));
+            io::read(header_in, iv.data(), iv.size(), "IV");
+            io::write(header_out, iv.data(), iv.size(), "IV");
+
+            break;
+          }
+          case static_cast<uint8_t>(Format::v3):
+          {
+            copy(2, "cipher");
+            copy(4, "chunk size");
+
+            std::vector<unsigned char> prefix(copy(1, "nonce prefix length"));
+            io::read(header_in, prefix.data(), prefix.size(), "nonce prefix");
+            io::write(header_out, prefix.data(), prefix.size(), "nonce prefix");
+
+            break;
+          }
+          case static_cast<uint8_t>(Format::v4):
+          {
+            // Having no payload, the envelope is re-encrypted as a whole.
+            std::vector<Slot> slots;
+            slots.push_back(_read_v4(header_in));
+
+            Slot const& slot = slots[_select(from, slots)];
+            elle::Buffer plain = _decrypt_v4(from, slot);
+            elle::SafeFinally cleanse(
+              [&] { ::OPENSSL_cleanse(plain.mutable_contents(),
+                                      plain.size()); });
+
+            elle::Buffer id;
+            if (!slot.id.empty())
+              id = fingerprint(to);
+
+            _write_v4(to, plain, id, header_out);
+
+            return;
+          }
+          default:
+            throw Error(
+              elle::sprintf("unknown envelope version %s", version));
+        }
+
+        // Replace the former key's slot, the other recipients' slots being
+        // kept.
+        std::vector<Slot> slots = _parse_slots(header_in);
+        Slot& slot = slots[_select(from, slots)];
+
+        slot.secret = rewrap(slot.secret);
+
+        if (!slot.id.empty())
+        {
+          elle::Buffer id = fingerprint(to);
+
+          slot.id.assign(id.contents(), id.contents() + id.size());
+        }
+
+        std::vector<elle::Buffer> ids;
+        std::vector<unsigned char*> secrets;
+        std::vector<int> lengths;
+
+        for (auto& slot: slots)
+        {
+          ids.emplace_back(slot.id.data(), slot.id.size());
+          secrets.push_back(slot.secret.data());
+          lengths.push_back(slot.secret.size());
+        }
+
+        _write_slots(header_out, ids, secrets, lengths);
+      }
+
+      void
+      open(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& code,
+           std::ostream& plain)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        ELLE_ASSERT_GTE(::EVP_PKEY_size(key),
+                        static_cast<int>(sizeof (_magic)));
+
+        // Start by extracting the secret and IV from the input
+        // stream.
+        unsigned char* secret =
+          reinterpret_cast<unsigned char*>(
+            ::OPENSSL_malloc(::EVP_PKEY_size(key)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(secret);
+
+        // Distinguish the versioned envelopes through their magic number,
+        // the bytes read being otherwise the v1 secret's first ones.
+        io::read(code, secret, sizeof (_magic), "secret");
+
+        if (::memcmp(secret, _magic, sizeof (_magic)) == 0)
+        {
+          _open_versioned(
+            [key] (std::vector<Slot> const& slots)
+            {
+              return (std::make_pair(key, _select(key, slots)));
+            },
+            code,
+            plain);
+
+          return;
+        }
+
+        unsigned char* iv =
+          reinterpret_cast<unsigned char*>(
+            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
+
+        {
+          // Read the rest of the secret.
+          code.read(reinterpret_cast<char*>(secret) + sizeof (_magic),
+                    ::EVP_PKEY_size(key) - sizeof (_magic));
+          if (!code.good())
+            throw Error(
+              elle::sprintf("unable to read the secret from the code's "
+                            "input stream: %s",
+                            code.rdstate()));
+
+          // Read the IV.
+          code.read(reinterpret_cast<char*>(iv), EVP_MAX_IV_LENGTH);
+          if (!code.good())
+            throw Error(
+              elle::sprintf("unable to read the IV from the code's "
+                            "input stream: %s",
+                            code.rdstate()));
+        }
+
+        // Initialize the cipher context.
+        ::EVP_CIPHER_CTX context;
+
+        ::EVP_CIPHER_CTX_init(&context);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+
+        // Initialize the envelope open operation.
+        _initialize(&context,
+                    cipher,
+                    secret,
+                    ::EVP_PKEY_size(key),
+                    iv,
+                    key);
+
+        _open(&context, code, plain);
+
+        // Clean up the cipher context.
+        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
+          throw Error(
+            elle::sprintf("unable to clean the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
+
+        // Release the memory associated with the secret and iv.
+        OPENSSL_free(iv);
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(iv);
+
+        OPENSSL_free(secret);
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(secret);
+      }
+
+      void
+      open(std::function< ::EVP_PKEY* (elle::ConstWeakBuffer const&)> const&
+             lookup,
+           std::istream& code,
+           std::ostream& plain)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        char magic[sizeof (_magic)];
+
+        io::read(code, magic, sizeof (magic), "magic number");
+        if (::memcmp(magic, _magic, sizeof (_magic)) != 0)
+          throw Error("the envelope carries no key identifier, v1 envelopes "
+                      "must be opened with the recipient's key");
+
+        _open_versioned(
+          [&lookup] (std::vector<Slot> const& slots)
+          {
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+              if (slots[i].id.empty())
+                continue;
+
+              ::EVP_PKEY* key =
+                lookup(elle::ConstWeakBuffer(slots[i].id.data(),
+                                             slots[i].id.size()));
+
+              if (key != nullptr)
+                return (std::make_pair(key, i));
+            }
+
+            throw Error("the envelope has not been sealed for any of the "
+                        "keys");
+          },
+          code,
+          plain);
+      }
+
+      elle::Buffer
+      fingerprint(::EVP_PKEY* key)
+      {
+        unsigned char* _buffer = nullptr;
+
+        int _size = ::i2d_PUBKEY(key, &_buffer);
+        if (_size <= 0)
+          throw Error(
+            elle::sprintf("unable to encode the public key: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_buffer);
+
+        return (hash(elle::ConstWeakBuffer(_buffer, _size), Oneway::sha256));
+      }
+
+      namespace cache
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        void
+        enable(std::size_t const capacity,
+               std::chrono::seconds const ttl)
+        {
+          ELLE_ASSERT_GT(capacity, 0u);
+
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          // The arena is sized for the capacity, the secrets being
+          // released should the capacity change.
+          if ((state.arena == nullptr) || (state.capacity != capacity))
+          {
+            if (state.arena != nullptr)
+              _clear(state);
+
+            state.arena.reset(new Arena(capacity));
+          }
+
+          state.enabled = true;
+          state.capacity = capacity;
+          state.ttl = ttl;
+        }
+
+        void
+        disable()
+        {
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          state.enabled = false;
+          state.index.clear();
+          state.entries.clear();
+          // Cleanse, unlock and release the whole region at once.
+          state.arena.reset();
+        }
+
+        bool
+        enabled()
+        {
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          return (state.enabled);
+        }
+
+        void
+        purge()
+        {
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          if (state.arena != nullptr)
+            _clear(state);
+        }
+
+        void
+        purge(::EVP_PKEY* key)
+        {
+          elle::Buffer _fingerprint = envelope::fingerprint(key);
+          std::string fingerprint(
+            reinterpret_cast<char const*>(_fingerprint.contents()),
+            _fingerprint.size());
+
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          for (auto iterator = state.entries.begin();
+               iterator != state.entries.end();)
+          {
+            auto entry = iterator++;
+
+            if (entry->fingerprint == fingerprint)
+              _erase(state, entry);
+          }
+        }
+
+        Statistics
+        statistics()
+        {
+          State& state = _state();
+          std::lock_guard<std::mutex> lock(state.mutex);
+
+          Statistics statistics = state.statistics;
+          statistics.size = state.entries.size();
+
+          return (statistics);
+        }
       }
     }
   }
@@ -7,10 +7,15 @@
 
 # include <elle/types.hh>
 # include <elle/fwd.hh>
+# include <elle/Buffer.hh>
 
 # include <openssl/evp.h>
 
+# include <chrono>
+# include <functional>
+# include <iosfwd>
 # include <memory>
+# include <vector>
 
 //
 // ---------- Asymmetric ------------------------------------------------------
@@ -25,22 +30,194 @@ namespace infinit
     /// to handle larger amount of data than the asymmetric keys support.
     namespace envelope
     {
+      /*-------------.
+      | Enumerations |
+      `-------------*/
+
+      /// The envelope formats.
+      ///
+      /// v1 envelopes are composed of the wrapped secret, the IV and the
+      /// code, the reader having to know the cipher. v2 envelopes start
+      /// with a header holding a magic number, the version, the cipher's
+      /// identifier, the IV length and the IV followed by the wrapped
+      /// secret(s), every one optionally tagged with the identifier of the
+      /// recipient key.
+      ///
+      /// v3 envelopes share the v2 header but split the plain in chunks,
+      /// see constants::envelope_chunk_size, encrypted with AES-GCM and
+      /// authenticated one by one, the last one being marked as final so
+      /// that a truncation be detected. Every chunk can therefore be handed
+      /// to the consumer as soon as it has been opened.
+      ///
+      /// v4 envelopes hold, after the magic number and the version, the
+      /// optional identifier of the recipient key and the plain directly
+      /// encrypted with this key with OAEP, sparing the generation of a
+      /// secret and the symmetric pass. Only the plains small enough to fit
+      /// in the key's modulus once padded are sealed this way, the larger
+      /// ones being sealed in v2 envelopes.
+      enum class Format
+      {
+        v1 = 1,
+        v2 = 2,
+        v3 = 3,
+        v4 = 4
+      };
+
+      std::ostream&
+      operator <<(std::ostream& stream,
+                  Format const format);
+
       /*----------.
       | Functions |
       `----------*/
 
-      /// Seal the given plain with the provided encryption key.
+      /// Set the format the envelopes are sealed in by default.
+      ///
+      /// Note that the default is v1 so that the readers can be upgraded,
+      /// opening both formats, before the writers switch to v2.
+      void
+      format(Format const format);
+      /// Return the format the envelopes are sealed in by default.
+      Format
+      format();
+      /// Seal the given plain with the provided encryption key in the
+      /// default format.
       void
       seal(::EVP_PKEY* key,
            ::EVP_CIPHER const* cipher,
            std::istream& plain,
            std::ostream& code);
-      /// Open the envelope with the provided key.
+      /// Seal the given plain with the provided encryption key in the given
+      /// format, the v2 and v3 envelopes embedding the given key
+      /// identifier, if any, so that the recipient can locate its key.
+      ///
+      /// Note that v3 envelopes rely on the AES-GCM cipher of the same key
+      /// length as the given AES cipher while the cipher is only used by v4
+      /// envelopes should the plain be too large to be directly encrypted.
+      void
+      seal(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code,
+           Format const format,
+           elle::ConstWeakBuffer const& id = elle::ConstWeakBuffer());
+      /// Seal the given plain for several recipients, the plain being
+      /// encrypted once with a secret wrapped with every one of the keys.
+      ///
+      /// Note that every wrapped secret is indexed by the fingerprint of
+      /// the key it has been wrapped with so that the recipients only
+      /// unwrap their own.
+      void
+      seal(std::vector< ::EVP_PKEY*> const& keys,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code,
+           Format const format = Format::v2);
+      /// Read the header of the envelope sealed for the former key from
+      /// the input stream and write an equivalent header to the output
+      /// stream, the secret being wrapped with the new key instead.
+      ///
+      /// Only the header is read, the input stream being left at the start
+      /// of the payload which can be copied, or kept in place, as is since
+      /// the secret is unchanged. The cipher is only needed by v1 headers,
+      /// as for open(). In envelopes sealed for several recipients, only
+      /// the former key's slot is replaced.
+      ///
+      /// Note that the header's size changes should the keys have
+      /// different sizes. Since v4 envelopes have no payload, the whole
+      /// envelope is read and re-encrypted with the new key, which fails
+      /// should the plain not fit in its modulus.
+      void
+      rewrap(::EVP_PKEY* from,
+             ::EVP_PKEY* to,
+             ::EVP_CIPHER const* cipher,
+             std::istream& header_in,
+             std::ostream& header_out);
+      /// Open the envelope with the provided key, be it sealed for this
+      /// key only or for several recipients.
+      ///
+      /// Note that the format is detected automatically, the given cipher
+      /// being ignored for the versioned envelopes which embed their own.
       void
       open(::EVP_PKEY* key,
            ::EVP_CIPHER const* cipher,
            std::istream& code,
            std::ostream& plain);
+      /// Open the envelope with the key, among several, identified by one
+      /// of its recipients' key identifiers, the lookup returning the key
+      /// associated with an identifier or null if unknown, so that no
+      /// trial decryption be needed.
+      ///
+      /// Note that only the v2, v3 and v4 envelopes sealed with a key
+      /// identifier, see fingerprint(), can be opened this way.
+      void
+      open(std::function< ::EVP_PKEY* (elle::ConstWeakBuffer const&)> const&
+             lookup,
+           std::istream& code,
+           std::ostream& plain);
+      /// Return the fingerprint identifying the given key in the envelopes
+      /// sealed for several recipients i.e the SHA-256 digest of the DER
+      /// representation of its public part.
+      elle::Buffer
+      fingerprint(::EVP_PKEY* key);
+
+      /// An opt-in cache of the unwrapped secrets so that opening the same
+      /// envelope again skips the private key operation, by far the most
+      /// expensive part of opening small envelopes.
+      ///
+      /// The secrets are identified by a digest of the recipient key's
+      /// fingerprint and the wrapped secret, kept in locked memory for at
+      /// most the configured time and evicted, least recently used first,
+      /// once the capacity is reached.
+      namespace cache
+      {
+        /*--------.
+        | Structs |
+        `--------*/
+
+        struct Statistics
+        {
+          /// The number of opens which found their secret in the cache.
+          uint64_t hits;
+          /// The number of opens which had to unwrap their secret.
+          uint64_t misses;
+          /// The number of secrets evicted to honour the capacity.
+          uint64_t evictions;
+          /// The number of secrets discarded because they had expired.
+          uint64_t expirations;
+          /// The number of secrets currently cached.
+          std::size_t size;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Enable the cache, or reconfigure it, keeping at most capacity
+        /// secrets, each for at most ttl.
+        ///
+        /// Note that the locked memory is allocated for the capacity
+        /// upfront, the cached secrets being released should it change.
+        void
+        enable(std::size_t const capacity = 256,
+               std::chrono::seconds const ttl = std::chrono::seconds(300));
+        /// Disable the cache, releasing the cached secrets.
+        void
+        disable();
+        /// Return true if the cache is enabled.
+        bool
+        enabled();
+        /// Release every cached secret.
+        void
+        purge();
+        /// Release the secrets unwrapped with the given key, for instance
+        /// before the key is revoked.
+        void
+        purge(::EVP_PKEY* key);
+        /// Return the cache's statistics since the process started.
+        Statistics
+        statistics();
+      }
     }
   }
 }
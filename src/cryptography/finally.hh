@@ -19,6 +19,26 @@
   elle::SafeFinally _finally_##V(                               \
     [&] () { ::DSA_free(V); });                                 \
 
+/// Make it easy to free an EC key on leaving the scope.
+# define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_KEY(V)     \
+  elle::SafeFinally _finally_##V(                               \
+    [&] () { ::EC_KEY_free(V); });                              \
+
+/// Make it easy to free an EC point on leaving the scope.
+# define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EC_POINT(V)   \
+  elle::SafeFinally _finally_##V(                               \
+    [&] () { ::EC_POINT_free(V); });                            \
+
+/// Make it easy to free an ECDSA signature on leaving the scope.
+# define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_ECDSA_SIG(V)  \
+  elle::SafeFinally _finally_##V(                               \
+    [&] () { ::ECDSA_SIG_free(V); });                           \
+
+/// Make it easy to free a DSA signature on leaving the scope.
+# define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DSA_SIG(V)   \
+  elle::SafeFinally _finally_##V(                               \
+    [&] () { ::DSA_SIG_free(V); });                             \
+
 /// Make it easy to free an DH key on leaving the scope.
 # define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_DH(V)         \
   elle::SafeFinally _finally_##V(                               \
@@ -29,6 +49,11 @@
   elle::SafeFinally _finally_##V(                       \
     [&] () { ::BN_clear_free(V); });                    \
 
+/// Make it easy to free a BN_CTX.
+# define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(V)     \
+  elle::SafeFinally _finally_##V(                               \
+    [&] () { ::BN_CTX_free(V); });                              \
+
 /// Make it easy to free memory through the OpenSSL_free() function.
 # define INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(V)    \
   elle::SafeFinally _finally_##V(                               \
@@ -16,6 +16,7 @@ namespace infinit
 
 # include <cryptography/rsa/fwd.hh>
 # include <cryptography/dsa/fwd.hh>
+# include <cryptography/ec/fwd.hh>
 # include <cryptography/dh/fwd.hh>
 
 #endif
@@ -7,6 +7,7 @@
 #include <cryptography/raw.hh>
 #include <cryptography/finally.hh>
 #include <cryptography/Error.hh>
+#include <cryptography/types.hh>
 
 namespace infinit
 {
@@ -14,6 +15,47 @@ namespace infinit
   {
     namespace hmac
     {
+      /*-----------------.
+      | Static Functions |
+      `-----------------*/
+
+      /// Return a MAC key based on the given string.
+      static
+      types::EVP_PKEY
+      _mac(std::string const& key)
+      {
+        types::EVP_PKEY _key(
+          ::EVP_PKEY_new_mac_key(EVP_PKEY_HMAC,
+                                 NULL,
+                                 (const unsigned char*)key.data(),
+                                 key.size()));
+
+        if (_key == nullptr)
+          throw Error(
+            elle::sprintf("unable to generate a MAC key: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+
+        return (_key);
+      }
+
+      /// Compare the digests in constant time.
+      static
+      bool
+      _compare(elle::ConstWeakBuffer const& digest,
+               elle::ConstWeakBuffer const& _digest)
+      {
+        if (digest.size() != _digest.size())
+          return (false);
+
+        // Compare using low-level OpenSSL functions to prevent timing attacks.
+        if (CRYPTO_memcmp(digest.contents(),
+                          _digest.contents(),
+                          _digest.size()) != 0)
+          return (false);
+
+        return (true);
+      }
+
       /*----------.
       | Functions |
       `----------*/
@@ -44,25 +86,10 @@ namespace infinit
       {
         ::EVP_MD const* function = oneway::resolve(oneway);
 
-        ::EVP_PKEY *_key = nullptr;
-
-        if ((_key = ::EVP_PKEY_new_mac_key(EVP_PKEY_HMAC,
-                                           NULL,
-                                           (const unsigned char*)key.data(),
-                                           key.size())) == nullptr)
-          throw Error(
-            elle::sprintf("unable to generate a MAC key: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-
-        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_EVP_PKEY(_key);
+        types::EVP_PKEY _key = _mac(key);
 
         // Apply the HMAC function with the given key.
-        elle::Buffer digest = raw::hmac::sign(_key, function, plain);
-
-        ::EVP_PKEY_free(_key);
-        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(_key);
-
-        return (digest);
+        return (raw::hmac::sign(_key.get(), function, plain));
       }
 
       bool
@@ -73,17 +100,33 @@ namespace infinit
       {
         elle::Buffer _digest = sign(plain, key, oneway);
 
-        if (digest.size() != _digest.size())
-          return (false);
+        return (_compare(digest, _digest));
+      }
 
-        // Compare using low-level OpenSSL functions to prevent timing attacks.
-        if (CRYPTO_memcmp(digest.contents(),
-                          _digest.contents(),
-                          _digest.size()) != 0)
-          return (false);
+      namespace _details
+      {
+        elle::Buffer
+        sign(std::function<void (std::ostream&)> const& plain,
+             std::string const& key,
+             Oneway const oneway)
+        {
+          ::EVP_MD const* function = oneway::resolve(oneway);
 
-        return (true);
+          types::EVP_PKEY _key = _mac(key);
+
+          return (raw::hmac::sign(_key.get(), function, plain));
+        }
+
+        bool
+        verify(elle::ConstWeakBuffer const& digest,
+               std::function<void (std::ostream&)> const& plain,
+               std::string const& key,
+               Oneway const oneway)
+        {
+          elle::Buffer _digest = sign(plain, key, oneway);
 
+          return (_compare(digest, _digest));
+        }
       }
     }
   }
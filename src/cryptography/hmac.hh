@@ -5,9 +5,11 @@
 # include <cryptography/Oneway.hh>
 
 # include <elle/types.hh>
+# include <elle/Version.hh>
 
 # include <openssl/evp.h>
 
+# include <functional>
 # include <iosfwd>
 
 namespace infinit
@@ -68,6 +70,57 @@ namespace infinit
              std::istream& plain,
              K const& key,
              Oneway const oneway);
+      /// Sign an object with a string-based key, its binary serialization in
+      /// the given version being streamed into the HMAC function rather than
+      /// built in memory.
+      template <typename T>
+      elle::Buffer
+      sign(T const& o,
+           elle::Version const& version,
+           std::string const& key,
+           Oneway const oneway);
+      /// Verify an object-based HMAC with a string-based key.
+      template <typename T>
+      bool
+      verify(elle::ConstWeakBuffer const& digest,
+             T const& o,
+             elle::Version const& version,
+             std::string const& key,
+             Oneway const oneway);
+      /// Sign an object with an asymmetric key.
+      template <typename T,
+                typename K>
+      elle::Buffer
+      sign(T const& o,
+           elle::Version const& version,
+           K const& key,
+           Oneway const oneway);
+      /// Verify an object-based HMAC with an asymmetric key.
+      template <typename T,
+                typename K>
+      bool
+      verify(elle::ConstWeakBuffer const& digest,
+             T const& o,
+             elle::Version const& version,
+             K const& key,
+             Oneway const oneway);
+
+      namespace _details
+      {
+        /// Sign the data written by the plain function with a string-based
+        /// key.
+        elle::Buffer
+        sign(std::function<void (std::ostream&)> const& plain,
+             std::string const& key,
+             Oneway const oneway);
+        /// Verify the data written by the plain function with a
+        /// string-based key.
+        bool
+        verify(elle::ConstWeakBuffer const& digest,
+               std::function<void (std::ostream&)> const& plain,
+               std::string const& key,
+               Oneway const oneway);
+      }
     }
   }
 }
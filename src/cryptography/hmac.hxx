@@ -9,6 +9,7 @@
 
 # include <elle/Buffer.hh>
 # include <elle/log.hh>
+# include <elle/serialization/binary.hh>
 
 # include <cryptography/raw.hh>
 # include <cryptography/finally.hh>
@@ -73,6 +74,84 @@ namespace infinit
                                   digest,
                                   plain));
       }
+
+      template <typename T>
+      elle::Buffer
+      sign(T const& o,
+           elle::Version const& version,
+           std::string const& key,
+           Oneway const oneway)
+      {
+        return (_details::sign(
+                  [&] (std::ostream& plain)
+                  {
+                    elle::serialization::binary::serialize(
+                      o, plain, version, false);
+                  },
+                  key,
+                  oneway));
+      }
+
+      template <typename T>
+      bool
+      verify(elle::ConstWeakBuffer const& digest,
+             T const& o,
+             elle::Version const& version,
+             std::string const& key,
+             Oneway const oneway)
+      {
+        return (_details::verify(
+                  digest,
+                  [&] (std::ostream& plain)
+                  {
+                    elle::serialization::binary::serialize(
+                      o, plain, version, false);
+                  },
+                  key,
+                  oneway));
+      }
+
+      template <typename T,
+                typename K>
+      elle::Buffer
+      sign(T const& o,
+           elle::Version const& version,
+           K const& key,
+           Oneway const oneway)
+      {
+        ::EVP_MD const* function = oneway::resolve(oneway);
+
+        return (raw::hmac::sign(
+                  key.key().get(),
+                  function,
+                  [&] (std::ostream& plain)
+                  {
+                    elle::serialization::binary::serialize(
+                      o, plain, version, false);
+                  }));
+      }
+
+      template <typename T,
+                typename K>
+      bool
+      verify(elle::ConstWeakBuffer const& digest,
+             T const& o,
+             elle::Version const& version,
+             K const& key,
+             Oneway const oneway)
+      {
+        ::EVP_MD const* function = oneway::resolve(oneway);
+
+        return (raw::hmac::verify(
+                  key.key().get(),
+                  function,
+                  digest,
+                  [&] (std::ostream& plain)
+                  {
+                    elle::serialization::binary::serialize(
+                      o, plain, version, false);
+                  }));
+      }
     }
   }
 }
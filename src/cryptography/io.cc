@@ -0,0 +1,84 @@
+#include <cryptography/io.hh>
+#include <cryptography/Error.hh>
+
+#include <elle/assert.hh>
+#include <elle/printf.hh>
+
+#include <istream>
+#include <ostream>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace io
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      void
+      write(std::ostream& stream,
+            void const* data,
+            std::size_t const size,
+            char const* what)
+      {
+        stream.write(static_cast<char const*>(data), size);
+        if (!stream.good())
+          throw Error(
+            elle::sprintf("unable to write the %s to the code's output "
+                          "stream: %s",
+                          what, stream.rdstate()));
+      }
+
+      void
+      write(std::ostream& stream,
+            uint32_t const value,
+            std::size_t const bytes,
+            char const* what)
+      {
+        unsigned char data[4];
+
+        ELLE_ASSERT_LTE(bytes, sizeof (data));
+        ELLE_ASSERT_LT(value, (uint64_t(1) << (8 * bytes)));
+
+        for (std::size_t i = 0; i < bytes; ++i)
+          data[i] = (value >> (8 * (bytes - i - 1))) & 0xff;
+
+        write(stream, data, bytes, what);
+      }
+
+      void
+      read(std::istream& stream,
+           void* data,
+           std::size_t const size,
+           char const* what)
+      {
+        stream.read(static_cast<char*>(data), size);
+        if (!stream.good())
+          throw Error(
+            elle::sprintf("unable to read the %s from the code's input "
+                          "stream: %s",
+                          what, stream.rdstate()));
+      }
+
+      uint32_t
+      read(std::istream& stream,
+           std::size_t const bytes,
+           char const* what)
+      {
+        unsigned char data[4];
+
+        ELLE_ASSERT_LTE(bytes, sizeof (data));
+
+        read(stream, data, bytes, what);
+
+        uint32_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+          value = (value << 8) | data[i];
+
+        return (value);
+      }
+    }
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef INFINIT_CRYPTOGRAPHY_IO_HH
+# define INFINIT_CRYPTOGRAPHY_IO_HH
+
+# include <elle/types.hh>
+
+# include <cstddef>
+# include <iosfwd>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /// Contain the primitives the binary formats, such as the envelopes
+    /// and the sessions, are written and read with.
+    ///
+    /// Note that the errors mention the given description of the data so
+    /// as to tell which part of the format is at fault.
+    namespace io
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Write the given bytes to the stream.
+      void
+      write(std::ostream& stream,
+            void const* data,
+            std::size_t const size,
+            char const* what);
+      /// Write the given integer in big endian on the given number of bytes,
+      /// up to four.
+      void
+      write(std::ostream& stream,
+            uint32_t const value,
+            std::size_t const bytes,
+            char const* what);
+      /// Read the given number of bytes from the stream.
+      void
+      read(std::istream& stream,
+           void* data,
+           std::size_t const size,
+           char const* what);
+      /// Read an integer written in big endian on the given number of bytes,
+      /// up to four.
+      uint32_t
+      read(std::istream& stream,
+           std::size_t const bytes,
+           char const* what);
+    }
+  }
+}
+
+#endif
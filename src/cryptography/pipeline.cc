@@ -0,0 +1,238 @@
+#include <cryptography/pipeline.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/raw.hh>
+#include <cryptography/rsa/Padding.hh>
+#include <cryptography/rsa/defaults.hh>
+
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+#include <iostream>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.pipeline");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace pipeline
+    {
+      /*--------.
+      | Classes |
+      `--------*/
+
+      namespace
+      {
+        /// A message digest fed block by block.
+        class Digest
+        {
+        public:
+          Digest(::EVP_MD const* oneway):
+            _oneway(oneway)
+          {
+            ::EVP_MD_CTX_init(&this->_context);
+
+            if (::EVP_DigestInit_ex(&this->_context, oneway, nullptr) <= 0)
+            {
+              ::EVP_MD_CTX_cleanup(&this->_context);
+
+              throw Error(
+                elle::sprintf("unable to initialize the digest process: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            }
+          }
+
+          Digest(Digest const&) = delete;
+
+          ~Digest()
+          {
+            ::EVP_MD_CTX_cleanup(&this->_context);
+          }
+
+          void
+          update(unsigned char const* data,
+                 std::size_t const size)
+          {
+            if (::EVP_DigestUpdate(&this->_context, data, size) <= 0)
+              throw Error(
+                elle::sprintf("unable to apply the digest function: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+          }
+
+          elle::Buffer
+          finalize()
+          {
+            elle::Buffer digest(::EVP_MD_size(this->_oneway));
+            unsigned int size(0);
+
+            if (::EVP_DigestFinal_ex(&this->_context,
+                                     digest.mutable_contents(),
+                                     &size) <= 0)
+              throw Error(
+                elle::sprintf("unable to finalize the digest process: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+            digest.size(size);
+
+            return (digest);
+          }
+
+        private:
+          ::EVP_MD const* _oneway;
+          ::EVP_MD_CTX _context;
+        };
+      }
+
+      /*-----------------.
+      | Static Functions |
+      `-----------------*/
+
+      /// Encipher the plain, hashing it and signing the code with the given
+      /// key in the same pass.
+      static
+      Signed
+      _encipher(SecretKey const& key,
+                ::EVP_PKEY* k,
+                ::EVP_MD const* signature,
+                std::function<void (::EVP_MD_CTX*,
+                                    ::EVP_PKEY_CTX*)> const& prolog,
+                std::istream& plain,
+                std::ostream& code,
+                Oneway const digest,
+                Cipher const cipher,
+                Mode const mode,
+                Oneway const oneway)
+      {
+        ELLE_TRACE_SCOPE("encipher, hash with %s and sign", digest);
+
+        Digest _digest(oneway::resolve(digest));
+        Signed result;
+
+        result.signature = raw::asymmetric::sign(
+          k,
+          signature,
+          [&] (std::ostream& sink)
+          {
+            // The code is written to both the output stream and the sink
+            // feeding the signature.
+            raw::symmetric::Tap plain_tap =
+              [&] (unsigned char const* data, std::size_t size)
+              {
+                _digest.update(data, size);
+              };
+            raw::symmetric::Tap code_tap =
+              [&] (unsigned char const* data, std::size_t size)
+              {
+                sink.write(reinterpret_cast<char const*>(data), size);
+              };
+
+            raw::symmetric::encipher(key.password(),
+                                     cipher::resolve(cipher, mode),
+                                     oneway::resolve(oneway),
+                                     plain,
+                                     code,
+                                     plain_tap,
+                                     code_tap);
+          },
+          prolog);
+        result.digest = _digest.finalize();
+
+        return (result);
+      }
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      Digests
+      encipher(SecretKey const& key,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest,
+               Cipher const cipher,
+               Mode const mode,
+               Oneway const oneway)
+      {
+        ELLE_TRACE_SCOPE("encipher and hash with %s", digest);
+
+        Digest _plain(oneway::resolve(digest));
+        Digest _code(oneway::resolve(digest));
+
+        raw::symmetric::Tap plain_tap =
+          [&] (unsigned char const* data, std::size_t size)
+          {
+            _plain.update(data, size);
+          };
+        raw::symmetric::Tap code_tap =
+          [&] (unsigned char const* data, std::size_t size)
+          {
+            _code.update(data, size);
+          };
+
+        raw::symmetric::encipher(key.password(),
+                                 cipher::resolve(cipher, mode),
+                                 oneway::resolve(oneway),
+                                 plain,
+                                 code,
+                                 plain_tap,
+                                 code_tap);
+
+        Digests digests;
+
+        digests.plain = _plain.finalize();
+        digests.code = _code.finalize();
+
+        return (digests);
+      }
+
+      Signed
+      encipher(SecretKey const& key,
+               rsa::PrivateKey const& k,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest,
+               Cipher const cipher,
+               Mode const mode,
+               Oneway const oneway,
+               rsa::Padding const padding,
+               Oneway const signature_oneway)
+      {
+        auto prolog =
+          [padding] (::EVP_MD_CTX*,
+                     ::EVP_PKEY_CTX* ctx)
+          {
+            rsa::padding::pad(ctx, padding);
+          };
+
+        return (_encipher(key,
+                          k.key().get(),
+                          oneway::resolve(signature_oneway),
+                          prolog,
+                          plain, code,
+                          digest, cipher, mode, oneway));
+      }
+
+      Signed
+      encipher(SecretKey const& key,
+               dsa::PrivateKey const& k,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest,
+               Cipher const cipher,
+               Mode const mode,
+               Oneway const oneway)
+      {
+        return (_encipher(key,
+                          k.key().get(),
+                          oneway::resolve(k.digest_algorithm()),
+                          nullptr,
+                          plain, code,
+                          digest, cipher, mode, oneway));
+      }
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#ifndef INFINIT_CRYPTOGRAPHY_PIPELINE_HH
+# define INFINIT_CRYPTOGRAPHY_PIPELINE_HH
+
+# include <iosfwd>
+
+# include <elle/Buffer.hh>
+# include <elle/types.hh>
+
+# include <cryptography/Cipher.hh>
+# include <cryptography/Oneway.hh>
+# include <cryptography/SecretKey.hh>
+# include <cryptography/dsa/PrivateKey.hh>
+# include <cryptography/rsa/PrivateKey.hh>
+# include <cryptography/rsa/Padding.hh>
+# include <cryptography/rsa/defaults.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    /// Fused operations reading the plain once, the encipherment, the
+    /// hashing of the plain and the hashing or signing of the code being
+    /// performed in the same pass over the data, block by block.
+    ///
+    /// The code produced is identical to the one of SecretKey::encipher(),
+    /// the digests to the ones returned by hash() and the signatures are
+    /// verified against the code as any other signature.
+    namespace pipeline
+    {
+      /*--------.
+      | Structs |
+      `--------*/
+
+      /// The digests of the plain and of the code.
+      struct Digests
+      {
+        elle::Buffer plain;
+        elle::Buffer code;
+      };
+
+      /// The digest of the plain along with the signature of the code.
+      struct Signed
+      {
+        elle::Buffer digest;
+        elle::Buffer signature;
+      };
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Encipher the plain's input stream with the secret key, writing the
+      /// code to the output stream, and return the digests of both.
+      Digests
+      encipher(SecretKey const& key,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest = Oneway::sha256,
+               Cipher const cipher = SecretKey::defaults::cipher,
+               Mode const mode = SecretKey::defaults::mode,
+               Oneway const oneway = SecretKey::defaults::oneway);
+      /// Encipher the plain's input stream with the secret key, returning
+      /// the plain's digest along with the code's signature, made with the
+      /// given padding and signature oneway as rsa::PrivateKey::sign()
+      /// does.
+      Signed
+      encipher(SecretKey const& key,
+               rsa::PrivateKey const& k,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest = Oneway::sha256,
+               Cipher const cipher = SecretKey::defaults::cipher,
+               Mode const mode = SecretKey::defaults::mode,
+               Oneway const oneway = SecretKey::defaults::oneway,
+               rsa::Padding const padding = rsa::defaults::signature_padding,
+               Oneway const signature_oneway = rsa::defaults::oneway);
+      /// Encipher the plain's input stream with the secret key, returning
+      /// the plain's digest along with the code's DSA signature.
+      Signed
+      encipher(SecretKey const& key,
+               dsa::PrivateKey const& k,
+               std::istream& plain,
+               std::ostream& code,
+               Oneway const digest = Oneway::sha256,
+               Cipher const cipher = SecretKey::defaults::cipher,
+               Mode const mode = SecretKey::defaults::mode,
+               Oneway const oneway = SecretKey::defaults::oneway);
+    }
+  }
+}
+
+#endif
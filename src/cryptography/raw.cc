@@ -19,10 +19,225 @@
 #include <openssl/hmac.h>
 #include <openssl/rand.h>
 
+#include <istream>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
 #if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
 ELLE_LOG_COMPONENT("infinit.cryptography.raw");
 #endif
 
+//
+// ---------- Streams ---------------------------------------------------------
+//
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace raw
+    {
+      /*--------.
+      | Classes |
+      `--------*/
+
+      namespace
+      {
+        /// A stream buffer forwarding the data written to it to an update
+        /// function, by blocks, so that the data can be digested, signed
+        /// etc. without ever being held in memory as a whole.
+        class Sink:
+          public std::streambuf
+        {
+        public:
+          Sink(std::function<int (unsigned char const*,
+                                  size_t)> const& update):
+            _update(update),
+            _buffer(constants::sink_block_size),
+            _failed(false)
+          {
+            this->setp(this->_buffer.data(),
+                       this->_buffer.data() + this->_buffer.size());
+          }
+
+          /// Whether the update function reported an error.
+          bool
+          failed() const
+          {
+            return (this->_failed);
+          }
+
+        protected:
+          int_type
+          overflow(int_type c) override
+          {
+            if (!this->_flush())
+              return (traits_type::eof());
+
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+              *this->pptr() = traits_type::to_char_type(c);
+              this->pbump(1);
+            }
+
+            return (traits_type::not_eof(c));
+          }
+
+          std::streamsize
+          xsputn(char const* data,
+                 std::streamsize size) override
+          {
+            // Accumulate small writes but forward large ones directly.
+            if (size < static_cast<std::streamsize>(this->_buffer.size()))
+              return (std::streambuf::xsputn(data, size));
+
+            if (!this->_flush())
+              return (0);
+
+            if (this->_update(reinterpret_cast<unsigned char const*>(data),
+                              size) <= 0)
+            {
+              this->_failed = true;
+
+              return (0);
+            }
+
+            return (size);
+          }
+
+          int
+          sync() override
+          {
+            return (this->_flush() ? 0 : -1);
+          }
+
+        private:
+          bool
+          _flush()
+          {
+            if (this->_failed)
+              return (false);
+
+            std::ptrdiff_t size = this->pptr() - this->pbase();
+
+            if ((size > 0) &&
+                (this->_update(
+                   reinterpret_cast<unsigned char const*>(this->pbase()),
+                   size) <= 0))
+            {
+              this->_failed = true;
+
+              return (false);
+            }
+
+            this->setp(this->_buffer.data(),
+                       this->_buffer.data() + this->_buffer.size());
+
+            return (true);
+          }
+
+        private:
+          std::function<int (unsigned char const*, size_t)> const& _update;
+          std::vector<char> _buffer;
+          bool _failed;
+        };
+
+        /// A stream buffer reading the given bytes in place, telling the
+        /// position reached so that the caller know how many bytes have
+        /// been consumed.
+        class Reader:
+          public std::streambuf
+        {
+        public:
+          Reader(elle::ConstWeakBuffer const& buffer)
+          {
+            char* data = reinterpret_cast<char*>(
+              const_cast<unsigned char*>(buffer.contents()));
+
+            this->setg(data, data, data + buffer.size());
+          }
+
+        protected:
+          pos_type
+          seekoff(off_type offset,
+                  std::ios_base::seekdir direction,
+                  std::ios_base::openmode which) override
+          {
+            if ((offset != 0) ||
+                (direction != std::ios_base::cur) ||
+                !(which & std::ios_base::in))
+              return (pos_type(off_type(-1)));
+
+            return (pos_type(this->gptr() - this->eback()));
+          }
+        };
+      }
+
+      /*-----------------.
+      | Static Functions |
+      `-----------------*/
+
+      /// Feed the update function with the plain's stream, block by block.
+      static
+      void
+      _feed(std::istream& plain,
+            std::function<int (unsigned char const*, size_t)> const& update,
+            char const* function)
+      {
+        std::vector<unsigned char> _input(constants::stream_block_size);
+
+        while (!plain.eof())
+        {
+          // Read the plain's input stream and put a block of data in a
+          // temporary buffer.
+          plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
+          if (plain.bad())
+            throw Error(
+              elle::sprintf("unable to read the plain's input stream: %s",
+                            plain.rdstate()));
+
+          // Update the context.
+          if (update(_input.data(), plain.gcount()) <= 0)
+            throw Error(
+              elle::sprintf("unable to apply the %s function: %s",
+                            function,
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+        }
+      }
+
+      /// Feed the update function with the data written by the plain
+      /// function.
+      static
+      void
+      _feed(std::function<void (std::ostream&)> const& plain,
+            std::function<int (unsigned char const*, size_t)> const& update,
+            char const* function)
+      {
+        Sink sink(update);
+
+        {
+          std::ostream stream(&sink);
+
+          plain(stream);
+          stream.flush();
+
+          if (sink.failed())
+            throw Error(
+              elle::sprintf("unable to apply the %s function: %s",
+                            function,
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (!stream.good())
+            throw Error(
+              elle::sprintf("unable to write the plain's data: %s",
+                            stream.rdstate()));
+        }
+      }
+    }
+  }
+}
+
 //
 // ---------- Asymmetric ------------------------------------------------------
 //
@@ -129,9 +344,7 @@ namespace infinit
           if (prolog)
             prolog(context.get());
 
-          elle::Buffer code = _apply(context.get(),
-                                     ::EVP_PKEY_encrypt,
-                                     plain);
+          elle::Buffer code = encrypt(context.get(), plain);
 
           if (epilog)
             epilog(context.get());
@@ -155,7 +368,7 @@ namespace infinit
           if (prolog)
             prolog(context.get());
 
-          elle::Buffer plain = _apply(context.get(), ::EVP_PKEY_decrypt, code);
+          elle::Buffer plain = decrypt(context.get(), code);
 
           if (epilog)
             epilog(context.get());
@@ -163,14 +376,16 @@ namespace infinit
           return (plain);
         }
 
+        template <typename P>
+        static
         elle::Buffer
-        sign(::EVP_PKEY* key,
-             ::EVP_MD const* oneway,
-             std::istream& plain,
-             std::function<void (::EVP_MD_CTX*,
-                                 ::EVP_PKEY_CTX*)> prolog,
-             std::function<void (::EVP_MD_CTX*,
-                                 ::EVP_PKEY_CTX*)> epilog)
+        _sign(::EVP_PKEY* key,
+              ::EVP_MD const* oneway,
+              P& plain,
+              std::function<void (::EVP_MD_CTX*,
+                                  ::EVP_PKEY_CTX*)> const& prolog,
+              std::function<void (::EVP_MD_CTX*,
+                                  ::EVP_PKEY_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -193,27 +408,13 @@ namespace infinit
           if (prolog)
             prolog(&context, ctx);
 
-          // Sign the plain's stream.
-          std::vector<unsigned char> _input(constants::stream_block_size);
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the signature context.
-            if (::EVP_DigestSignUpdate(&context,
-                                       _input.data(),
-                                       plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the signature function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          // Sign the plain.
+          _feed(plain,
+                [&context] (unsigned char const* data, size_t size)
+                {
+                  return (::EVP_DigestSignUpdate(&context, data, size));
+                },
+                "signature");
 
           // Finalize the signature.
           size_t size(0);
@@ -253,15 +454,17 @@ namespace infinit
           return (signature);
         }
 
+        template <typename P>
+        static
         bool
-        verify(::EVP_PKEY* key,
-               ::EVP_MD const* oneway,
-               elle::ConstWeakBuffer const& signature,
-               std::istream& plain,
-               std::function<void (::EVP_MD_CTX*,
-                                   ::EVP_PKEY_CTX*)> prolog,
-               std::function<void (::EVP_MD_CTX*,
-                                   ::EVP_PKEY_CTX*)> epilog)
+        _verify(::EVP_PKEY* key,
+                ::EVP_MD const* oneway,
+                elle::ConstWeakBuffer const& signature,
+                P& plain,
+                std::function<void (::EVP_MD_CTX*,
+                                    ::EVP_PKEY_CTX*)> const& prolog,
+                std::function<void (::EVP_MD_CTX*,
+                                    ::EVP_PKEY_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -284,27 +487,13 @@ namespace infinit
           if (prolog)
             prolog(&context, ctx);
 
-          // Verify the signature's stream.
-          std::vector<unsigned char> _input(constants::stream_block_size);
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the verify context.
-            if (::EVP_DigestVerifyUpdate(&context,
-                                         _input.data(),
-                                         plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the verify function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          // Verify the plain.
+          _feed(plain,
+                [&context] (unsigned char const* data, size_t size)
+                {
+                  return (::EVP_DigestVerifyUpdate(&context, data, size));
+                },
+                "verify");
 
           if (epilog)
             epilog(&context, ctx);
@@ -336,6 +525,79 @@ namespace infinit
           elle::unreachable();
         }
 
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::istream& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog)
+        {
+          return (_sign(key, oneway, plain, prolog, epilog));
+        }
+
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::function<void (std::ostream&)> const& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog)
+        {
+          return (_sign(key, oneway, plain, prolog, epilog));
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               std::istream& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog)
+        {
+          return (_verify(key, oneway, signature, plain, prolog, epilog));
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               std::function<void (std::ostream&)> const& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog)
+        {
+          return (_verify(key, oneway, signature, plain, prolog, epilog));
+        }
+
+        std::pair<elle::Version, elle::ConstWeakBuffer>
+        split(elle::ConstWeakBuffer const& signature)
+        {
+          // Parse the version in place, the position reached telling the
+          // size of the header so as to reference, rather than copy, the
+          // rest of the buffer.
+          Reader buffer(signature);
+          std::istream input(&buffer);
+          auto version =
+            elle::serialization::binary::deserialize<elle::Version>(input,
+                                                                    false);
+          std::streamoff size = input.tellg();
+          if ((size < 0) ||
+              (static_cast<std::size_t>(size) > signature.size()))
+            throw Error(
+              elle::sprintf("the signature is too short to embed a version: "
+                            "%s bytes", signature.size()));
+          return std::make_pair(
+            version,
+            elle::ConstWeakBuffer(signature.contents() + size,
+                                  signature.size() - size));
+        }
+
         elle::Buffer
         agree(::EVP_PKEY* own,
               ::EVP_PKEY* peer,
@@ -349,8 +611,96 @@ namespace infinit
           if (prolog)
             prolog(context.get());
 
+          elle::Buffer buffer = agree(context.get(), peer);
+
+          if (epilog)
+            epilog(context.get());
+
+          return (buffer);
+        }
+
+#if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+        elle::Buffer
+        rotate(::EVP_PKEY* key,
+               elle::ConstWeakBuffer const& seed,
+               std::function<void (::EVP_PKEY_CTX*)> prolog,
+               std::function<void (::EVP_PKEY_CTX*)> epilog)
+        {
+          // Prepare the context.
+          types::EVP_PKEY_CTX context(
+            context::create(key, ::EVP_PKEY_sign_init));
+
+          if (prolog)
+            prolog(context.get());
+
+          elle::Buffer buffer = rotate(context.get(), seed);
+
+          if (epilog)
+            epilog(context.get());
+
+          return (buffer);
+        }
+
+        elle::Buffer
+        unrotate(::EVP_PKEY* key,
+                 elle::ConstWeakBuffer const& seed,
+                 std::function<void (::EVP_PKEY_CTX*)> prolog,
+                 std::function<void (::EVP_PKEY_CTX*)> epilog)
+        {
+          // Prepare the context.
+          types::EVP_PKEY_CTX context(
+            context::create(key, ::EVP_PKEY_verify_recover_init));
+
+          if (prolog)
+            prolog(context.get());
+
+          elle::Buffer buffer = unrotate(context.get(), seed);
+
+          if (epilog)
+            epilog(context.get());
+
+          return (buffer);
+        }
+#endif
+
+        elle::Buffer
+        encrypt(::EVP_PKEY_CTX* context,
+                elle::ConstWeakBuffer const& plain)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          return (_apply(context, ::EVP_PKEY_encrypt, plain));
+        }
+
+        elle::Buffer
+        decrypt(::EVP_PKEY_CTX* context,
+                elle::ConstWeakBuffer const& code)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          return (_apply(context, ::EVP_PKEY_decrypt, code));
+        }
+
+        elle::Buffer
+        sign(::EVP_PKEY_CTX* context,
+             elle::ConstWeakBuffer const& digest)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          return (_apply(context, ::EVP_PKEY_sign, digest));
+        }
+
+        elle::Buffer
+        agree(::EVP_PKEY_CTX* context,
+              ::EVP_PKEY* peer)
+        {
+          ELLE_ASSERT_NEQ(context, nullptr);
+
           // Set the peer key.
-          if (::EVP_PKEY_derive_set_peer(context.get(), peer) <= 0)
+          if (::EVP_PKEY_derive_set_peer(context, peer) <= 0)
             throw Error(
               elle::sprintf("unable to initialize the context for "
                             "derivation: %s",
@@ -359,7 +709,7 @@ namespace infinit
           size_t size;
 
           // Compute the shared key's future length.
-          if (::EVP_PKEY_derive(context.get(), nullptr, &size) <= 0)
+          if (::EVP_PKEY_derive(context, nullptr, &size) <= 0)
             throw Error(
               elle::sprintf("unable to compute the output size of the "
                             "shared key: %s",
@@ -368,7 +718,7 @@ namespace infinit
           elle::Buffer buffer(size);
 
           // Generate the shared key.
-          if (::EVP_PKEY_derive(context.get(),
+          if (::EVP_PKEY_derive(context,
                                 buffer.mutable_contents(),
                                 &size) <= 0)
             throw Error(
@@ -379,24 +729,17 @@ namespace infinit
           buffer.size(size);
           buffer.shrink_to_fit();
 
-          if (epilog)
-            epilog(context.get());
-
           return (buffer);
         }
 
 #if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
         elle::Buffer
-        rotate(::EVP_PKEY* key,
-               elle::ConstWeakBuffer const& seed,
-               std::function<void (::EVP_PKEY_CTX*)> prolog,
-               std::function<void (::EVP_PKEY_CTX*)> epilog)
+        rotate(::EVP_PKEY_CTX* context,
+               elle::ConstWeakBuffer const& seed)
         {
           ELLE_DUMP("seed: %s", seed);
 
-          // Prepare the context.
-          types::EVP_PKEY_CTX context(
-            context::create(key, ::EVP_PKEY_sign_init));
+          ::EVP_PKEY* key = ::EVP_PKEY_CTX_get0_pkey(context);
 
           // Ensure the size of the seed equals the modulus.
           //
@@ -414,14 +757,7 @@ namespace infinit
                             ::EVP_PKEY_size(key),
                             seed.size()));
 
-          if (prolog)
-            prolog(context.get());
-
-          elle::Buffer buffer =
-            _apply(context.get(), ::EVP_PKEY_sign, seed);
-
-          if (epilog)
-            epilog(context.get());
+          elle::Buffer buffer = _apply(context, ::EVP_PKEY_sign, seed);
 
           // Make sure the seed does not grow over time.
           ELLE_ASSERT_EQ(seed.size(), buffer.size());
@@ -430,16 +766,12 @@ namespace infinit
         }
 
         elle::Buffer
-        unrotate(::EVP_PKEY* key,
-                 elle::ConstWeakBuffer const& seed,
-                 std::function<void (::EVP_PKEY_CTX*)> prolog,
-                 std::function<void (::EVP_PKEY_CTX*)> epilog)
+        unrotate(::EVP_PKEY_CTX* context,
+                 elle::ConstWeakBuffer const& seed)
         {
           ELLE_DUMP("seed: %s", seed);
 
-          // Prepare the context.
-          types::EVP_PKEY_CTX context(
-            context::create(key, ::EVP_PKEY_verify_recover_init));
+          ::EVP_PKEY* key = ::EVP_PKEY_CTX_get0_pkey(context);
 
           // As for the rotation mechanism, ensure the size of the seed
           // equals the modulus.
@@ -451,14 +783,8 @@ namespace infinit
                             ::EVP_PKEY_size(key),
                             seed.size()));
 
-          if (prolog)
-            prolog(context.get());
-
           elle::Buffer buffer =
-            _apply(context.get(), ::EVP_PKEY_verify_recover, seed);
-
-          if (epilog)
-            epilog(context.get());
+            _apply(context, ::EVP_PKEY_verify_recover, seed);
 
           // Make sure the unrotated seed has the same size as the original.
           ELLE_ASSERT_EQ(seed.size(), buffer.size());
@@ -496,14 +822,19 @@ namespace infinit
         | Functions |
         `----------*/
 
+        /// Encipher the plain text, the taps, if any, being given every
+        /// block of plain text read and of code written.
+        static
         void
-        encipher(elle::ConstWeakBuffer const& secret,
-                 ::EVP_CIPHER const* cipher,
-                 ::EVP_MD const* oneway,
-                 std::istream& plain,
-                 std::ostream& code,
-                 std::function<void (::EVP_CIPHER_CTX*)> prolog,
-                 std::function<void (::EVP_CIPHER_CTX*)> epilog)
+        _encipher(elle::ConstWeakBuffer const& secret,
+                  ::EVP_CIPHER const* cipher,
+                  ::EVP_MD const* oneway,
+                  std::istream& plain,
+                  std::ostream& code,
+                  std::function<void (::EVP_CIPHER_CTX*)> const& prolog,
+                  std::function<void (::EVP_CIPHER_CTX*)> const& epilog,
+                  Tap const& plain_tap,
+                  Tap const& code_tap)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -565,6 +896,13 @@ namespace infinit
                             "output stream: %s",
                             code.rdstate()));
 
+          if (code_tap)
+          {
+            code_tap(reinterpret_cast<unsigned char const*>(magic),
+                     sizeof (magic) - 1);
+            code_tap(salt, sizeof (salt));
+          }
+
           // Retreive the cipher-specific block size. This is the maximum size
           // that the algorithm can output on top of the encrypted input
           // plain text.
@@ -585,6 +923,9 @@ namespace infinit
                 elle::sprintf("unable to read the plain's input stream: %s",
                               plain.rdstate()));
 
+            if (plain_tap)
+              plain_tap(_input.data(), plain.gcount());
+
             int size_update(0);
 
             // Encrypt the input buffer.
@@ -605,6 +946,9 @@ namespace infinit
                 elle::sprintf("unable to write the encrypted data to the "
                               "code's output stream: %s",
                               code.rdstate()));
+
+            if (code_tap)
+              code_tap(_output.data(), size_update);
           }
 
           if (epilog)
@@ -629,6 +973,9 @@ namespace infinit
                             "code's output stream: %s",
                             code.rdstate()));
 
+          if (code_tap)
+            code_tap(_output.data(), size_final);
+
           // Clean up the cipher context.
           if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
             throw Error(
@@ -638,6 +985,32 @@ namespace infinit
           INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(context);
         }
 
+        void
+        encipher(elle::ConstWeakBuffer const& secret,
+                 ::EVP_CIPHER const* cipher,
+                 ::EVP_MD const* oneway,
+                 std::istream& plain,
+                 std::ostream& code,
+                 std::function<void (::EVP_CIPHER_CTX*)> prolog,
+                 std::function<void (::EVP_CIPHER_CTX*)> epilog)
+        {
+          _encipher(secret, cipher, oneway, plain, code,
+                    prolog, epilog, nullptr, nullptr);
+        }
+
+        void
+        encipher(elle::ConstWeakBuffer const& secret,
+                 ::EVP_CIPHER const* cipher,
+                 ::EVP_MD const* oneway,
+                 std::istream& plain,
+                 std::ostream& code,
+                 Tap const& plain_tap,
+                 Tap const& code_tap)
+        {
+          _encipher(secret, cipher, oneway, plain, code,
+                    nullptr, nullptr, plain_tap, code_tap);
+        }
+
         void
         decipher(elle::ConstWeakBuffer const& secret,
                  ::EVP_CIPHER const* cipher,
@@ -795,11 +1168,13 @@ namespace infinit
   {
     namespace raw
     {
+      template <typename P>
+      static
       elle::Buffer
-      hash(::EVP_MD const* oneway,
-           std::istream& plain,
-           std::function<void (::EVP_MD_CTX*)> prolog,
-           std::function<void (::EVP_MD_CTX*)> epilog)
+      _hash(::EVP_MD const* oneway,
+            P& plain,
+            std::function<void (::EVP_MD_CTX*)> const& prolog,
+            std::function<void (::EVP_MD_CTX*)> const& epilog)
       {
         // Make sure the cryptographic system is set up.
         cryptography::require();
@@ -820,27 +1195,13 @@ namespace infinit
         if (prolog)
           prolog(&context);
 
-        // Hash the plain's stream.
-        std::vector<unsigned char> _input(constants::stream_block_size);
-
-        while (!plain.eof())
-        {
-          // Read the plain's input stream and put a block of data in a
-          // temporary buffer.
-          plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-          if (plain.bad())
-            throw Error(
-              elle::sprintf("unable to read the plain's input stream: %s",
-                            plain.rdstate()));
-
-          // Update the digest context.
-          if (::EVP_DigestUpdate(&context,
-                                 _input.data(),
-                                 plain.gcount()) <= 0)
-            throw Error(
-              elle::sprintf("unable to apply the digest function: %s",
-                            ::ERR_error_string(ERR_get_error(), nullptr)));
-        }
+        // Hash the plain.
+        _feed(plain,
+              [&context] (unsigned char const* data, size_t size)
+              {
+                return (::EVP_DigestUpdate(&context, data, size));
+              },
+              "digest");
 
         // Allocate the output digest.
         elle::Buffer digest(EVP_MD_size(oneway));
@@ -872,6 +1233,24 @@ namespace infinit
 
         return (digest);
       }
+
+      elle::Buffer
+      hash(::EVP_MD const* oneway,
+           std::istream& plain,
+           std::function<void (::EVP_MD_CTX*)> prolog,
+           std::function<void (::EVP_MD_CTX*)> epilog)
+      {
+        return (_hash(oneway, plain, prolog, epilog));
+      }
+
+      elle::Buffer
+      hash(::EVP_MD const* oneway,
+           std::function<void (std::ostream&)> const& plain,
+           std::function<void (::EVP_MD_CTX*)> prolog,
+           std::function<void (::EVP_MD_CTX*)> epilog)
+      {
+        return (_hash(oneway, plain, prolog, epilog));
+      }
     }
   }
 }
@@ -888,12 +1267,14 @@ namespace infinit
     {
       namespace hmac
       {
+        template <typename P>
+        static
         elle::Buffer
-        sign(::EVP_PKEY* key,
-             ::EVP_MD const* oneway,
-             std::istream& plain,
-             std::function<void (::EVP_MD_CTX*)> prolog,
-             std::function<void (::EVP_MD_CTX*)> epilog)
+        _sign(::EVP_PKEY* key,
+              ::EVP_MD const* oneway,
+              P& plain,
+              std::function<void (::EVP_MD_CTX*)> const& prolog,
+              std::function<void (::EVP_MD_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -918,27 +1299,13 @@ namespace infinit
           if (prolog)
             prolog(&context);
 
-          // HMAC-sign the plain's stream.
-          std::vector<unsigned char> _input(constants::stream_block_size);
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the HMAC.
-            if (::EVP_DigestSignUpdate(&context,
-                                       _input.data(),
-                                       plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the HMAC function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          // HMAC-sign the plain.
+          _feed(plain,
+                [&context] (unsigned char const* data, size_t size)
+                {
+                  return (::EVP_DigestSignUpdate(&context, data, size));
+                },
+                "HMAC");
 
           if (epilog)
             epilog(&context);
@@ -980,13 +1347,15 @@ namespace infinit
           return (digest);
         }
 
+        template <typename P>
+        static
         bool
-        verify(::EVP_PKEY* key,
-               ::EVP_MD const* oneway,
-               elle::ConstWeakBuffer const& digest,
-               std::istream& plain,
-               std::function<void (::EVP_MD_CTX*)> prolog,
-               std::function<void (::EVP_MD_CTX*)> epilog)
+        _verify(::EVP_PKEY* key,
+                ::EVP_MD const* oneway,
+                elle::ConstWeakBuffer const& digest,
+                P& plain,
+                std::function<void (::EVP_MD_CTX*)> const& prolog,
+                std::function<void (::EVP_MD_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -1011,27 +1380,13 @@ namespace infinit
           if (prolog)
             prolog(&context);
 
-          // HMAC-verify the plain's stream against the digest.
-          std::vector<unsigned char> _input(constants::stream_block_size);
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the HMAC.
-            if (::EVP_DigestVerifyUpdate(&context,
-                                         _input.data(),
-                                         plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the HMAC function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          // HMAC-verify the plain against the digest.
+          _feed(plain,
+                [&context] (unsigned char const* data, size_t size)
+                {
+                  return (::EVP_DigestVerifyUpdate(&context, data, size));
+                },
+                "HMAC");
 
           if (epilog)
             epilog(&context);
@@ -1052,6 +1407,48 @@ namespace infinit
 
           return (true);
         }
+
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::istream& plain,
+             std::function<void (::EVP_MD_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*)> epilog)
+        {
+          return (_sign(key, oneway, plain, prolog, epilog));
+        }
+
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::function<void (std::ostream&)> const& plain,
+             std::function<void (::EVP_MD_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*)> epilog)
+        {
+          return (_sign(key, oneway, plain, prolog, epilog));
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& digest,
+               std::istream& plain,
+               std::function<void (::EVP_MD_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*)> epilog)
+        {
+          return (_verify(key, oneway, digest, plain, prolog, epilog));
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& digest,
+               std::function<void (std::ostream&)> const& plain,
+               std::function<void (::EVP_MD_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*)> epilog)
+        {
+          return (_verify(key, oneway, digest, plain, prolog, epilog));
+        }
       }
     }
   }
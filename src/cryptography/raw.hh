@@ -5,12 +5,16 @@
 # include <cryptography/Cipher.hh>
 # include <cryptography/Oneway.hh>
 
+# include <elle/Version.hh>
 # include <elle/types.hh>
 # include <elle/fwd.hh>
 
 # include <openssl/evp.h>
 
+# include <functional>
+# include <iosfwd>
 # include <memory>
+# include <utility>
 
 //
 // ---------- Asymmetric ------------------------------------------------------
@@ -64,6 +68,33 @@ namespace infinit
                                    ::EVP_PKEY_CTX*)> prolog = nullptr,
                std::function<void (::EVP_MD_CTX*,
                                    ::EVP_PKEY_CTX*)> epilog = nullptr);
+        /// Sign the data written by the plain function in the stream it is
+        /// given, the data being digested as it is written rather than
+        /// being held in memory.
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::function<void (std::ostream&)> const& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog = nullptr,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog = nullptr);
+        /// Return true if the signature is valid according to the data
+        /// written by the plain function.
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               std::function<void (std::ostream&)> const& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog = nullptr,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog = nullptr);
+        /// Split a versioned signature, as produced when signing objects,
+        /// into the serialization version it embeds and the signature
+        /// proper, the latter referencing the given buffer.
+        std::pair<elle::Version, elle::ConstWeakBuffer>
+        split(elle::ConstWeakBuffer const& signature);
         /// Agree on a shared key between two key pairs: between a one's private
         /// key and a peer's public key.
         elle::Buffer
@@ -85,6 +116,40 @@ namespace infinit
                  std::function<void (::EVP_PKEY_CTX*)> prolog = nullptr,
                  std::function<void (::EVP_PKEY_CTX*)> epilog = nullptr);
 # endif
+
+        /// The following variants operate on a context which has already
+        /// been initialized for the operation and set up, for instance
+        /// retrieved from the context cache. The context can be re-used
+        /// once the operation completes.
+
+        /// Encrypt the given plain with an encryption context.
+        elle::Buffer
+        encrypt(::EVP_PKEY_CTX* context,
+                elle::ConstWeakBuffer const& plain);
+        /// Decrypt the given code with a decryption context.
+        elle::Buffer
+        decrypt(::EVP_PKEY_CTX* context,
+                elle::ConstWeakBuffer const& code);
+        /// Sign an already computed digest with a signature context whose
+        /// signature message digest has been set to the one having
+        /// produced the digest.
+        elle::Buffer
+        sign(::EVP_PKEY_CTX* context,
+             elle::ConstWeakBuffer const& digest);
+        /// Agree on a shared key with the peer through a derivation context.
+        elle::Buffer
+        agree(::EVP_PKEY_CTX* context,
+              ::EVP_PKEY* peer);
+#if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+        /// Rotate the given seed with a signature context.
+        elle::Buffer
+        rotate(::EVP_PKEY_CTX* context,
+               elle::ConstWeakBuffer const& seed);
+        /// Unrotate the given seed with a verify-recover context.
+        elle::Buffer
+        unrotate(::EVP_PKEY_CTX* context,
+                 elle::ConstWeakBuffer const& seed);
+# endif
       }
     }
   }
@@ -103,6 +168,19 @@ namespace infinit
       /// Contain the operations related to symmetric algorithms.
       namespace symmetric
       {
+        /*------.
+        | Types |
+        `------*/
+
+        /// A function given every block of data flowing through a stage
+        /// of the encipherment so that other operations, hashing or signing
+        /// for instance, be performed in the same pass over the data.
+        typedef std::function<void (unsigned char const*, std::size_t)> Tap;
+
+        /*----------.
+        | Functions |
+        `----------*/
+
         /// Encipher the plain text according to the given secret and functions.
         void
         encipher(elle::ConstWeakBuffer const& secret,
@@ -112,6 +190,17 @@ namespace infinit
                  std::ostream& code,
                  std::function<void (::EVP_CIPHER_CTX*)> prolog = nullptr,
                  std::function<void (::EVP_CIPHER_CTX*)> epilog = nullptr);
+        /// Encipher the plain text, the plain tap being given every block
+        /// read from the plain and the code tap every block written to the
+        /// code, the magic and salt included.
+        void
+        encipher(elle::ConstWeakBuffer const& secret,
+                 ::EVP_CIPHER const* cipher,
+                 ::EVP_MD const* oneway,
+                 std::istream& plain,
+                 std::ostream& code,
+                 Tap const& plain_tap,
+                 Tap const& code_tap);
         /// Decipher the cipher text according to the given secret and
         /// functions.
         void
@@ -143,6 +232,13 @@ namespace infinit
            std::istream& plain,
            std::function<void (::EVP_MD_CTX*)> prolog = nullptr,
            std::function<void (::EVP_MD_CTX*)> epilog = nullptr);
+      /// Hash the data written by the plain function in the stream it is
+      /// given, as it is written.
+      elle::Buffer
+      hash(::EVP_MD const* oneway,
+           std::function<void (std::ostream&)> const& plain,
+           std::function<void (::EVP_MD_CTX*)> prolog = nullptr,
+           std::function<void (::EVP_MD_CTX*)> epilog = nullptr);
     }
   }
 }
@@ -174,6 +270,23 @@ namespace infinit
                std::istream& plain,
                std::function<void (::EVP_MD_CTX*)> prolog = nullptr,
                std::function<void (::EVP_MD_CTX*)> epilog = nullptr);
+        /// HMAC the data written by the plain function in the stream it is
+        /// given.
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::function<void (std::ostream&)> const& plain,
+             std::function<void (::EVP_MD_CTX*)> prolog = nullptr,
+             std::function<void (::EVP_MD_CTX*)> epilog = nullptr);
+        /// Verify a HMAC digest against the data written by the plain
+        /// function.
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& digest,
+               std::function<void (std::ostream&)> const& plain,
+               std::function<void (::EVP_MD_CTX*)> prolog = nullptr,
+               std::function<void (::EVP_MD_CTX*)> epilog = nullptr);
       }
     }
   }
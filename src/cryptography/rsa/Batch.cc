@@ -0,0 +1,271 @@
+#include <cryptography/rsa/Batch.hh>
+
+#include <openssl/rsa.h>
+#include <openssl/err.h>
+
+#include <algorithm>
+
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/context.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/hash.hh>
+#include <cryptography/raw.hh>
+#include <cryptography/rsa/Padding.hh>
+#include <cryptography/rsa/defaults.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.Batch");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      Batch::Batch(unsigned int workers):
+        _requests(nullptr),
+        _results(nullptr),
+        _remaining(0),
+        _stop(false),
+        _statistics{0, 0, std::chrono::steady_clock::duration::zero(), 0.0}
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        if (workers == 0)
+          workers = std::max(std::thread::hardware_concurrency(), 1u);
+
+        this->_preparer = std::thread([this] { this->_prepare(); });
+        for (unsigned int i = 0; i < workers; ++i)
+          this->_workers.emplace_back([this] { this->_work(); });
+      }
+
+      Batch::~Batch()
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          this->_stop = true;
+        }
+        this->_available.notify_all();
+
+        this->_preparer.join();
+        for (auto& worker: this->_workers)
+          worker.join();
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      std::vector<Batch::Result>
+      Batch::run(std::vector<Request> const& requests)
+      {
+        ELLE_TRACE_SCOPE("%s: run %s requests", *this, requests.size());
+
+        std::lock_guard<std::mutex> running(this->_running);
+        std::vector<Result> results(requests.size());
+
+        auto start = std::chrono::steady_clock::now();
+
+        if (!requests.empty())
+        {
+          std::unique_lock<std::mutex> lock(this->_mutex);
+
+          this->_requests = &requests;
+          this->_results = &results;
+          this->_digests.clear();
+          this->_digests.resize(requests.size());
+          this->_remaining = requests.size();
+
+          // Only the signature requests need to be digested beforehand,
+          // the others being ready to be processed.
+          for (std::size_t i = 0; i < requests.size(); ++i)
+          {
+            ELLE_ASSERT_NEQ(requests[i].key, nullptr);
+
+            if (requests[i].operation == Operation::sign)
+              this->_pending.push_back(i);
+            else
+              this->_ready.push_back(i);
+          }
+
+          this->_available.notify_all();
+          this->_done.wait(lock, [this] { return (this->_remaining == 0); });
+
+          this->_requests = nullptr;
+          this->_results = nullptr;
+          this->_digests.clear();
+        }
+
+        auto latency = std::chrono::steady_clock::now() - start;
+        auto seconds =
+          std::chrono::duration_cast<std::chrono::duration<double>>(
+            latency).count();
+
+        std::size_t errors = 0;
+        for (auto const& result: results)
+          if (result.error)
+            ++errors;
+
+        this->_statistics.count = requests.size();
+        this->_statistics.errors = errors;
+        this->_statistics.latency = latency;
+        this->_statistics.throughput =
+          seconds > 0 ? requests.size() / seconds : 0.0;
+
+        ELLE_DEBUG("%s: %s requests processed in %ss i.e %s per second",
+                   *this, requests.size(), seconds,
+                   this->_statistics.throughput);
+
+        return (results);
+      }
+
+      void
+      Batch::_prepare()
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        while (true)
+        {
+          this->_available.wait(
+            lock,
+            [this] { return (this->_stop || !this->_pending.empty()); });
+
+          if (this->_pending.empty())
+            return;
+
+          std::size_t index = this->_pending.front();
+          this->_pending.pop_front();
+
+          Request const& request = (*this->_requests)[index];
+
+          lock.unlock();
+
+          // Note that the digest and result slots are only ever accessed
+          // by the thread in charge of the request.
+          try
+          {
+            this->_digests[index] = hash(request.input, defaults::oneway);
+          }
+          catch (...)
+          {
+            (*this->_results)[index].error = std::current_exception();
+          }
+
+          lock.lock();
+
+          this->_ready.push_back(index);
+          this->_available.notify_all();
+        }
+      }
+
+      void
+      Batch::_work()
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        while (true)
+        {
+          this->_available.wait(
+            lock,
+            [this] { return (this->_stop || !this->_ready.empty()); });
+
+          if (this->_ready.empty())
+            return;
+
+          std::size_t index = this->_ready.front();
+          this->_ready.pop_front();
+
+          lock.unlock();
+
+          this->_process(index);
+
+          lock.lock();
+
+          if (--this->_remaining == 0)
+            this->_done.notify_all();
+        }
+      }
+
+      void
+      Batch::_process(std::size_t const index)
+      {
+        Request const& request = (*this->_requests)[index];
+        Result& result = (*this->_results)[index];
+
+        // The request could not be digested.
+        if (result.error)
+          return;
+
+        try
+        {
+          switch (request.operation)
+          {
+            case Operation::sign:
+            {
+              Padding const padding = defaults::signature_padding;
+              ::EVP_MD const* function = oneway::resolve(defaults::oneway);
+              elle::Buffer const& digest = this->_digests[index];
+
+              // Sign the digest as EVP_DigestSignFinal() would, so as to
+              // produce the same signature as PrivateKey::sign().
+              context::cache::apply(
+                request.key->key().get(),
+                ::EVP_PKEY_sign_init,
+                padding::resolve(padding) | (::EVP_MD_type(function) << 8),
+                [padding, function] (::EVP_PKEY_CTX* context)
+                {
+                  padding::pad(context, padding);
+
+                  if (EVP_PKEY_CTX_set_signature_md(context, function) <= 0)
+                    throw Error(
+                      elle::sprintf(
+                        "unable to set the EVP_PKEY context's signature "
+                        "message digest: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+                },
+                [&] (::EVP_PKEY_CTX* context)
+                {
+                  result.output = raw::asymmetric::sign(context, digest);
+                });
+
+              break;
+            }
+            case Operation::decrypt:
+            {
+              result.output = request.key->decrypt(request.input);
+
+              break;
+            }
+            case Operation::open:
+            {
+              result.output = request.key->open(request.input);
+
+              break;
+            }
+          }
+        }
+        catch (...)
+        {
+          result.error = std::current_exception();
+        }
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      Batch::print(std::ostream& stream) const
+      {
+        stream << "Batch(" << this->_workers.size() << " workers)";
+      }
+    }
+  }
+}
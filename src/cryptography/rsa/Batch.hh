@@ -0,0 +1,157 @@
+#ifndef INFINIT_CRYPTOGRAPHY_RSA_BATCH_HH
+# define INFINIT_CRYPTOGRAPHY_RSA_BATCH_HH
+
+# include <chrono>
+# include <condition_variable>
+# include <deque>
+# include <exception>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+# include <elle/Buffer.hh>
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+
+# include <cryptography/rsa/PrivateKey.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Process batches of private key operations, spreading them across a
+      /// set of worker threads.
+      ///
+      /// The signature requests are pipelined: a dedicated thread digests the
+      /// plain texts while the workers apply the private exponentiations on
+      /// the already digested ones.
+      ///
+      /// Note that the operations rely on the default settings i.e
+      /// defaults::signature_padding and defaults::oneway for signing,
+      /// defaults::encryption_padding for decrypting and
+      /// defaults::envelope_cipher/mode for opening envelopes, the results
+      /// being equivalent to the ones of the PrivateKey's methods.
+      class Batch
+        : public elle::Printable
+      {
+        /*-------------.
+        | Enumerations |
+        `-------------*/
+      public:
+        enum class Operation
+        {
+          sign,
+          decrypt,
+          open
+        };
+
+        /*--------.
+        | Structs |
+        `--------*/
+      public:
+        /// A request, the key and the input being referenced rather than
+        /// copied: both must outlive the batch's processing.
+        struct Request
+        {
+          Operation operation;
+          PrivateKey const* key;
+          elle::ConstWeakBuffer input;
+        };
+
+        /// The result of a request: either the output or the error having
+        /// prevented its computation.
+        struct Result
+        {
+          elle::Buffer output;
+          std::exception_ptr error;
+        };
+
+        /// Metrics related to the last processed batch.
+        struct Statistics
+        {
+          /// The number of requests processed.
+          std::size_t count;
+          /// The number of requests having failed.
+          std::size_t errors;
+          /// The time elapsed between the submission of the batch and its
+          /// completion.
+          std::chrono::steady_clock::duration latency;
+          /// The number of requests processed per second.
+          double throughput;
+        };
+
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        /// Construct a batch engine relying on the given number of workers,
+        /// the number of cores being used should it be zero.
+        explicit
+        Batch(unsigned int workers = 0);
+        Batch(Batch const&) = delete;
+        ~Batch();
+
+        /*--------.
+        | Methods |
+        `--------*/
+      public:
+        /// Process the given requests and return their results, in the same
+        /// order, once all of them have completed.
+        std::vector<Result>
+        run(std::vector<Request> const& requests);
+      private:
+        /// Digest the plain texts of the signature requests.
+        void
+        _prepare();
+        /// Apply the private key operations.
+        void
+        _work();
+        /// Apply the private key operation of the given request.
+        void
+        _process(std::size_t const index);
+
+        /*----------.
+        | Operators |
+        `----------*/
+      public:
+        Batch&
+        operator =(Batch const&) = delete;
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      private:
+        /// Serialize the calls to run().
+        std::mutex _running;
+        std::mutex _mutex;
+        /// Signaled whenever there are requests to digest or process.
+        std::condition_variable _available;
+        /// Signaled once the last request of a batch has been processed.
+        std::condition_variable _done;
+        /// The indexes of the requests to digest.
+        std::deque<std::size_t> _pending;
+        /// The indexes of the requests ready to be processed.
+        std::deque<std::size_t> _ready;
+        std::vector<Request> const* _requests;
+        std::vector<Result>* _results;
+        std::vector<elle::Buffer> _digests;
+        std::size_t _remaining;
+        bool _stop;
+        std::thread _preparer;
+        std::vector<std::thread> _workers;
+        ELLE_ATTRIBUTE_R(Statistics, statistics);
+      };
+    }
+  }
+}
+
+#endif
@@ -6,20 +6,33 @@
 #include <cryptography/rsa/PrivateKey.hh>
 #include <cryptography/rsa/PublicKey.hh>
 #include <cryptography/rsa/Seed.hh>
+#include <cryptography/rsa/multiprime.hh>
 #include <cryptography/types.hh>
 
 #include <elle/attribute.hh>
 #include <elle/assert.hh>
 #include <elle/log.hh>
 
+#include <openssl/bn.h>
 #include <openssl/engine.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <openssl/rsa.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
 # include <dopenssl/rsa.hh>
 #endif
 
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.KeyPair");
+
 namespace infinit
 {
   namespace cryptography
@@ -204,6 +217,140 @@ namespace infinit
     {
       namespace keypair
       {
+        /*-------------.
+        | Prime Search |
+        `-------------*/
+
+        /// The state of the concurrent searches for one of a key's primes.
+        struct Search
+        {
+          /// Set as soon as a suitable prime has been found.
+          std::atomic<bool> found{false};
+          /// Set to make every search give up, for both primes.
+          std::atomic<bool>* abort = nullptr;
+          /// The number of searches which failed.
+          unsigned int failures = 0;
+          /// The prime found, protected by the mutex.
+          types::BIGNUM prime;
+          std::mutex* mutex = nullptr;
+          std::condition_variable* condition = nullptr;
+        };
+
+        /// The callback given to BN_generate_prime_ex(), making a search
+        /// give up should the prime have been found by another one.
+        static
+        int
+        _progress(int,
+                  int,
+                  ::BN_GENCB* callback)
+        {
+          auto search = static_cast<Search*>(callback->arg);
+
+          return ((search->found || *search->abort) ? 0 : 1);
+        }
+
+        /// Search for a prime of the given length such that p - 1 be
+        /// coprime with the exponent, until found by this search or
+        /// another one.
+        static
+        void
+        _search(Search& search,
+                int const bits,
+                ::BIGNUM const* exponent)
+        {
+          try
+          {
+            types::BIGNUM prime(::BN_new());
+            types::BIGNUM p1(::BN_new());
+            types::BIGNUM inverse(::BN_new());
+            ::BN_CTX* context = ::BN_CTX_new();
+
+            INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+            if ((prime == nullptr) || (p1 == nullptr) ||
+                (inverse == nullptr) || (context == nullptr))
+              throw Error(
+                elle::sprintf("unable to allocate the prime search: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+
+            ::BN_GENCB callback;
+            BN_GENCB_set(&callback, _progress, &search);
+
+            while (!search.found && !*search.abort)
+            {
+              if (::BN_generate_prime_ex(prime.get(), bits, 0,
+                                         nullptr, nullptr,
+                                         &callback) == 0)
+              {
+                // The search has been told to give up.
+                if (search.found || *search.abort)
+                  return;
+
+                throw Error(
+                  elle::sprintf("unable to generate a prime: %s",
+                                ::ERR_error_string(ERR_get_error(),
+                                                   nullptr)));
+              }
+
+              // As OpenSSL does since CVE-2018-0737, handle the secret
+              // prime in constant time, checking that p - 1 be coprime
+              // with the exponent through the existence of an inverse
+              // since BN_gcd() has no constant-time implementation.
+              BN_set_flags(prime.get(), BN_FLG_CONSTTIME);
+
+              if (::BN_sub(p1.get(), prime.get(), ::BN_value_one()) == 0)
+                throw Error(
+                  elle::sprintf("unable to check the prime: %s",
+                                ::ERR_error_string(ERR_get_error(),
+                                                   nullptr)));
+
+              BN_set_flags(p1.get(), BN_FLG_CONSTTIME);
+
+              ::ERR_set_mark();
+
+              bool coprime =
+                ::BN_mod_inverse(inverse.get(), p1.get(), exponent,
+                                 context) != nullptr;
+
+              if (!coprime)
+              {
+                unsigned long error = ::ERR_peek_last_error();
+
+                if ((ERR_GET_LIB(error) != ERR_LIB_BN) ||
+                    (ERR_GET_REASON(error) != BN_R_NO_INVERSE))
+                  throw Error(
+                    elle::sprintf("unable to check the prime: %s",
+                                  ::ERR_error_string(ERR_get_error(),
+                                                     nullptr)));
+
+                ::ERR_pop_to_mark();
+              }
+
+              if (coprime)
+              {
+                std::lock_guard<std::mutex> lock(*search.mutex);
+
+                if (!search.found)
+                {
+                  search.prime = std::move(prime);
+                  search.found = true;
+                }
+
+                break;
+              }
+            }
+          }
+          catch (std::exception const& e)
+          {
+            ELLE_WARN("the search for a prime failed: %s", e.what());
+
+            std::lock_guard<std::mutex> lock(*search.mutex);
+            search.failures++;
+          }
+
+          search.condition->notify_all();
+        }
+
         /*----------.
         | Functions |
         `----------*/
@@ -242,6 +389,9 @@ namespace infinit
                             "be generated: %s",
                             ::ERR_error_string(ERR_get_error(), nullptr)));
 
+          // Abort the generation should the task running it be cancelled.
+          ::EVP_PKEY_CTX_set_cb(context.get(), cancellation::callback);
+
           ::EVP_PKEY* key = nullptr;
 
           // Generate the EVP key.
@@ -264,6 +414,224 @@ namespace infinit
           return (KeyPair(std::move(K), std::move(k)));
         }
 
+        KeyPair
+        generate(uint32_t const length,
+                 uint32_t const primes)
+        {
+          if ((length % 8) != 0)
+            throw Error(
+              elle::sprintf("the keypair length must be a multiple of 8"));
+
+          if (primes == 2)
+            return (generate(length));
+
+          ::RSA* rsa = multiprime::generate(length, primes);
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_RSA(rsa);
+
+          // Instanciate both a RSA public and private key based on the RSA
+          // structure.
+          PrivateKey k(rsa);
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(rsa);
+          PublicKey K(k);
+
+          return (KeyPair(std::move(K), std::move(k)));
+        }
+
+        KeyPair
+        generate_parallel(uint32_t const length,
+                          unsigned int const searches)
+        {
+          if ((length % 8) != 0)
+            throw Error(
+              elle::sprintf("the keypair length must be a multiple of 8"));
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          unsigned int const n =
+            searches != 0 ?
+            searches :
+            std::max(std::thread::hardware_concurrency() / 2, 1u);
+
+          ELLE_TRACE_SCOPE("generate a %s-bit key pair with %s searches per "
+                           "prime", length, n);
+
+          types::BIGNUM exponent(::BN_new());
+
+          if ((exponent == nullptr) ||
+              (::BN_set_word(exponent.get(), RSA_F4) == 0))
+            throw Error(
+              elle::sprintf("unable to set the public exponent: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Search for both primes, the first one being one bit longer for
+          // odd lengths, as does OpenSSL.
+          int const bits[2] = {
+            static_cast<int>((length + 1) / 2),
+            static_cast<int>(length - (length + 1) / 2)
+          };
+          std::atomic<bool> abort{false};
+          std::mutex mutex;
+          std::condition_variable condition;
+          Search primes[2];
+          std::vector<std::thread> threads;
+
+          for (auto& search: primes)
+          {
+            search.abort = &abort;
+            search.mutex = &mutex;
+            search.condition = &condition;
+          }
+
+          for (int i = 0; i < 2; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+              threads.emplace_back(
+                [&primes, &bits, &exponent, i]
+                {
+                  _search(primes[i], bits[i], exponent.get());
+                });
+
+          // Wait for both primes, polling the cancellation of the task
+          // running this generation, if any.
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (!(primes[0].found && primes[1].found))
+            {
+              if (cancellation::requested() ||
+                  (primes[0].failures == n) ||
+                  (primes[1].failures == n))
+              {
+                abort = true;
+                break;
+              }
+
+              condition.wait_for(lock, std::chrono::milliseconds(10));
+            }
+          }
+
+          for (auto& thread: threads)
+            thread.join();
+
+          if (abort)
+            throw Error(
+              elle::sprintf("unable to generate a keypair: the prime search "
+                            "has been %s",
+                            cancellation::requested() ? "cancelled" :
+                                                        "unsuccessful"));
+
+          // Assemble the key, making sure p > q as OpenSSL does.
+          ::BIGNUM* p = primes[0].prime.get();
+          ::BIGNUM* q = primes[1].prime.get();
+
+          if (::BN_cmp(p, q) == 0)
+            throw Error(
+              elle::sprintf("unable to generate a keypair: identical primes"));
+
+          if (::BN_cmp(p, q) < 0)
+            std::swap(primes[0].prime, primes[1].prime);
+
+          ::RSA* rsa = ::RSA_new();
+
+          if (rsa == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the RSA key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_RSA(rsa);
+
+          ::BN_CTX* context = ::BN_CTX_new();
+
+          if (context == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate a BN context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+          rsa->p = primes[0].prime.release();
+          rsa->q = primes[1].prime.release();
+          rsa->e = exponent.release();
+
+          types::BIGNUM p1(::BN_new());
+          types::BIGNUM q1(::BN_new());
+          types::BIGNUM phi(::BN_new());
+
+          if ((p1 == nullptr) || (q1 == nullptr) || (phi == nullptr))
+            throw Error(
+              elle::sprintf("unable to allocate the RSA key components: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Flag the secret values so that the inverses and reductions
+          // below run in constant time, as in OpenSSL's own generation.
+          BN_set_flags(rsa->p, BN_FLG_CONSTTIME);
+          BN_set_flags(rsa->q, BN_FLG_CONSTTIME);
+          BN_set_flags(p1.get(), BN_FLG_CONSTTIME);
+          BN_set_flags(q1.get(), BN_FLG_CONSTTIME);
+          BN_set_flags(phi.get(), BN_FLG_CONSTTIME);
+
+          if (((rsa->n = ::BN_new()) == nullptr) ||
+              ((rsa->dmp1 = ::BN_new()) == nullptr) ||
+              ((rsa->dmq1 = ::BN_new()) == nullptr) ||
+              (::BN_mul(rsa->n, rsa->p, rsa->q, context) == 0) ||
+              (::BN_sub(p1.get(), rsa->p, ::BN_value_one()) == 0) ||
+              (::BN_sub(q1.get(), rsa->q, ::BN_value_one()) == 0) ||
+              (::BN_mul(phi.get(), p1.get(), q1.get(), context) == 0) ||
+              ((rsa->d = ::BN_mod_inverse(nullptr, rsa->e, phi.get(),
+                                          context)) == nullptr))
+            throw Error(
+              elle::sprintf("unable to compute the RSA key components: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          BN_set_flags(rsa->d, BN_FLG_CONSTTIME);
+
+          if ((::BN_mod(rsa->dmp1, rsa->d, p1.get(), context) == 0) ||
+              (::BN_mod(rsa->dmq1, rsa->d, q1.get(), context) == 0) ||
+              ((rsa->iqmp = ::BN_mod_inverse(nullptr, rsa->q, rsa->p,
+                                             context)) == nullptr))
+            throw Error(
+              elle::sprintf("unable to compute the RSA key components: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          if (::RSA_check_key(rsa) != 1)
+            throw Error(
+              elle::sprintf("the generated RSA key is invalid: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          // Instanciate both a RSA public and private key based on the RSA
+          // structure.
+          PrivateKey k(rsa);
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(rsa);
+          PublicKey K(k);
+
+          return (KeyPair(std::move(K), std::move(k)));
+        }
+
+        std::future<KeyPair>
+        generate_async(uint32_t const length,
+                       Priority const priority,
+                       Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [length] { return (generate(length)); },
+                    priority,
+                    cancellation));
+        }
+
+#if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+        std::future<KeyPair>
+        deduce_async(Seed const& seed,
+                     Priority const priority,
+                     Cancellation const& cancellation)
+        {
+          return (executor::generation().submit(
+                    [seed] { return (KeyPair(seed)); },
+                    priority,
+                    cancellation));
+        }
+#endif
+
         namespace der
         {
           /*----------.
@@ -1,6 +1,7 @@
 #ifndef INFINIT_CRYPTOGRAPHY_RSA_KEYPAIR_HH
 # define INFINIT_CRYPTOGRAPHY_RSA_KEYPAIR_HH
 
+# include <future>
 # include <iosfwd>
 
 # include <utility>
@@ -12,6 +13,7 @@
 # include <cryptography/fwd.hh>
 # include <cryptography/Oneway.hh>
 # include <cryptography/Cipher.hh>
+# include <cryptography/Executor.hh>
 # include <cryptography/rsa/KeyPair.hh>
 # include <cryptography/rsa/PublicKey.hh>
 # include <cryptography/rsa/PrivateKey.hh>
@@ -138,6 +140,44 @@ namespace infinit
         /// Note that the length is in bits.
         KeyPair
         generate(uint32_t const length);
+        /// Generate a multi-prime key pair whose modulus is the product of
+        /// the given number of primes, speeding up the private operations.
+        ///
+        /// Note that up to three primes are supported below 4096 bits and
+        /// up to four below 8192 bits, the public key being a regular one.
+        KeyPair
+        generate(uint32_t const length,
+                 uint32_t const primes);
+        /// Generate a key pair by searching for both primes at the same
+        /// time, several speculative searches being run for each prime,
+        /// the first prime found cancelling the other searches.
+        ///
+        /// This trades CPU for a shorter and less variable latency. Should
+        /// the number of searches per prime be zero, half the hardware
+        /// threads are used. Note that this function honours the
+        /// cancellation of the executor task it is run by, if any.
+        KeyPair
+        generate_parallel(uint32_t const length,
+                          unsigned int const searches = 0);
+        /// Generate a key pair on the key generation executor, returning
+        /// a future on it.
+        ///
+        /// Note that the generation is aborted as soon as its cancellation
+        /// is requested, the future reporting a Cancelled error.
+        std::future<KeyPair>
+        generate_async(uint32_t const length,
+                       Priority const priority = Priority::normal,
+                       Cancellation const& cancellation = Cancellation());
+# if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+        /// Deduce the key pair from the given seed on the key generation
+        /// executor, returning a future on it.
+        ///
+        /// Note that the deduction can only be cancelled before it starts.
+        std::future<KeyPair>
+        deduce_async(Seed const& seed,
+                     Priority const priority = Priority::normal,
+                     Cancellation const& cancellation = Cancellation());
+# endif
 
         namespace der
         {
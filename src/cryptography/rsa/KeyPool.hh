@@ -2,10 +2,16 @@
 # define INFINIT_CRYPTOGRAPHY_RSA_KEYPOOL_HH
 
 # include <condition_variable>
+# include <memory>
 # include <thread>
 # include <vector>
 
+# include <cryptography/Pool.hh>
 # include <cryptography/rsa/KeyPair.hh>
+# include <cryptography/rsa/Reservoir.hh>
+# if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+#  include <cryptography/rsa/Seed.hh>
+# endif
 # include <elle/ProducerPool.hh>
 
 namespace infinit
@@ -24,7 +30,75 @@ namespace infinit
             max_pool_size,
             thread_count)
         {}
+
+        /// Construct a pool handing out the key pairs of the given on-disk
+        /// reservoir first, the key pairs being generated once the reservoir
+        /// is exhausted.
+        ///
+        /// Note that the reservoir is drawn from by the producer threads so
+        /// that ProducerPool::get() benefits from it as well.
+        KeyPool(int key_size,
+                int max_pool_size,
+                int thread_count,
+                std::unique_ptr<Reservoir> reservoir)
+        : KeyPool(key_size,
+                  max_pool_size,
+                  thread_count,
+                  std::shared_ptr<Reservoir>(std::move(reservoir)))
+        {}
+
+      private:
+        KeyPool(int key_size,
+                int max_pool_size,
+                int thread_count,
+                std::shared_ptr<Reservoir> reservoir)
+        : ProducerPool<KeyPair>(
+            [key_size, reservoir] () -> KeyPair
+            {
+              if (reservoir != nullptr)
+                if (std::unique_ptr<KeyPair> keypair = reservoir->take())
+                  return (std::move(*keypair));
+
+              return (keypair::generate(key_size));
+            },
+            max_pool_size,
+            thread_count)
+        , _reservoir(reservoir)
+        {}
+
+        ELLE_ATTRIBUTE_R(std::shared_ptr<Reservoir>, reservoir);
+      };
+
+      /// A pool of key pairs whose producers are scaled according to the
+      /// demand and which hands out key pairs without locking.
+      class AdaptiveKeyPool
+        : public Pool<KeyPair>
+      {
+      public:
+        AdaptiveKeyPool(uint32_t const key_size,
+                        pool::Configuration const& configuration =
+                          pool::Configuration())
+        : Pool<KeyPair>(
+            [key_size] { return keypair::generate(key_size); },
+            configuration)
+        {}
+      };
+
+# if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+      /// A pool of seeds for generating key pairs of the given length.
+      class SeedPool
+        : public Pool<Seed>
+      {
+      public:
+        SeedPool(uint32_t const length,
+                 pool::Configuration const& configuration =
+                   pool::Configuration())
+        : Pool<Seed>(
+            [length] { return seed::generate(length); },
+            configuration)
+        {}
       };
+# endif
     }
   }
 }
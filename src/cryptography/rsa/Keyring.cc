@@ -0,0 +1,127 @@
+#include <cryptography/rsa/Keyring.hh>
+
+#include <iostream>
+#include <sstream>
+
+#include <elle/IOStream.hh>
+#include <elle/log.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/envelope.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.Keyring");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Return the identifier of the given key.
+      static
+      std::string
+      _identifier(::EVP_PKEY* key)
+      {
+        elle::Buffer fingerprint = envelope::fingerprint(key);
+
+        return (
+          std::string(reinterpret_cast<char const*>(fingerprint.contents()),
+                      fingerprint.size()));
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      Keyring::Keyring()
+      {}
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      void
+      Keyring::add(PrivateKey k)
+      {
+        ELLE_TRACE_SCOPE("%s: add %s", *this, k);
+
+        std::string identifier = _identifier(k.key().get());
+
+        this->_keys.erase(identifier);
+        this->_keys.emplace(std::move(identifier), std::move(k));
+      }
+
+      bool
+      Keyring::remove(PublicKey const& K)
+      {
+        ELLE_TRACE_SCOPE("%s: remove %s", *this, K);
+
+        return (this->_keys.erase(_identifier(K.key().get())) != 0);
+      }
+
+      PrivateKey const*
+      Keyring::find(elle::ConstWeakBuffer const& id) const
+      {
+        auto iterator = this->_keys.find(
+          std::string(reinterpret_cast<char const*>(id.contents()),
+                      id.size()));
+
+        if (iterator == this->_keys.end())
+          return (nullptr);
+
+        return (&iterator->second);
+      }
+
+      std::size_t
+      Keyring::size() const
+      {
+        return (this->_keys.size());
+      }
+
+      elle::Buffer
+      Keyring::open(elle::ConstWeakBuffer const& code) const
+      {
+        elle::IOStream _code(code.istreambuf());
+        std::stringstream _plain;
+
+        this->open(_code, _plain);
+
+        elle::Buffer plain(_plain.str().data(), _plain.str().length());
+
+        return (plain);
+      }
+
+      void
+      Keyring::open(std::istream& code,
+                    std::ostream& plain) const
+      {
+        envelope::open(
+          [this] (elle::ConstWeakBuffer const& id) -> ::EVP_PKEY*
+          {
+            PrivateKey const* k = this->find(id);
+
+            if (k == nullptr)
+              return (nullptr);
+
+            return (k->key().get());
+          },
+          code,
+          plain);
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      Keyring::print(std::ostream& stream) const
+      {
+        stream << "Keyring(" << this->_keys.size() << " keys)";
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#ifndef INFINIT_CRYPTOGRAPHY_RSA_KEYRING_HH
+# define INFINIT_CRYPTOGRAPHY_RSA_KEYRING_HH
+
+# include <iosfwd>
+# include <string>
+# include <unordered_map>
+
+# include <elle/Buffer.hh>
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+
+# include <cryptography/rsa/PrivateKey.hh>
+# include <cryptography/rsa/PublicKey.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Represent a set of private keys indexed by their fingerprint, see
+      /// envelope::fingerprint(), so that the key an envelope has been
+      /// sealed for be found in constant time from the key identifiers
+      /// embedded in the envelope rather than by trying every key.
+      ///
+      /// Note that the keyring is not synchronized: keys must not be added
+      /// or removed while envelopes are being opened.
+      class Keyring:
+        public elle::Printable
+      {
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        Keyring();
+
+        /*--------.
+        | Methods |
+        `--------*/
+      public:
+        /// Add the given key, replacing the identical one, if any.
+        void
+        add(PrivateKey k);
+        /// Remove the private key associated with the given public key,
+        /// returning false if the keyring did not hold it.
+        bool
+        remove(PublicKey const& K);
+        /// Return the key whose fingerprint is the given identifier, null
+        /// if unknown.
+        PrivateKey const*
+        find(elle::ConstWeakBuffer const& id) const;
+        /// Return the number of keys.
+        std::size_t
+        size() const;
+        /// Open the envelope with the key it has been sealed for and return
+        /// the original plain text.
+        elle::Buffer
+        open(elle::ConstWeakBuffer const& code) const;
+        /// Open the envelope with the key it has been sealed for, writing
+        /// the plain text in the output stream.
+        ///
+        /// Note that the envelope must have been sealed with the key
+        /// identifiers, in the v2, v3 or v4 format, for instance through
+        /// PublicKey::seal() with _identify_ set or for several recipients.
+        void
+        open(std::istream& code,
+             std::ostream& plain) const;
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      private:
+        typedef std::unordered_map<std::string, PrivateKey> Keys;
+        ELLE_ATTRIBUTE(Keys, keys);
+      };
+    }
+  }
+}
+
+#endif
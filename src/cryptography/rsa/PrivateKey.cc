@@ -142,6 +142,11 @@ namespace infinit
         this->_check();
       }
 
+      PrivateKey::~PrivateKey()
+      {
+        context::cache::invalidate(this->_key.get());
+      }
+
       /*--------.
       | Methods |
       `--------*/
@@ -215,15 +220,22 @@ namespace infinit
       PrivateKey::decrypt(elle::ConstWeakBuffer const& code,
                           Padding const padding) const
       {
-        auto prolog =
-          [this, padding](::EVP_PKEY_CTX* context)
+        elle::Buffer plain;
+
+        context::cache::apply(
+          this->_key.get(),
+          ::EVP_PKEY_decrypt_init,
+          padding::resolve(padding),
+          [padding] (::EVP_PKEY_CTX* context)
           {
             padding::pad(context, padding);
-          };
+          },
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            plain = raw::asymmetric::decrypt(context, code);
+          });
 
-        return (raw::asymmetric::decrypt(this->_key.get(),
-                                         code,
-                                         prolog));
+        return (plain);
       }
 
       elle::Buffer
@@ -256,6 +268,25 @@ namespace infinit
                   prolog));
       }
 
+      elle::Buffer
+      PrivateKey::_sign(std::function<void (std::ostream&)> const& plain,
+                        Padding const padding,
+                        Oneway const oneway) const
+      {
+        auto prolog =
+          [this, padding](::EVP_MD_CTX* context,
+                          ::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, padding);
+          };
+
+        return (raw::asymmetric::sign(
+                  this->_key.get(),
+                  oneway::resolve(oneway),
+                  plain,
+                  prolog));
+      }
+
       uint32_t
       PrivateKey::size() const
       {
@@ -305,18 +336,23 @@ namespace infinit
       Seed
       PrivateKey::rotate(Seed const& seed) const
       {
-        auto prolog =
-          [this](::EVP_PKEY_CTX* ctx)
-          {
-            padding::pad(ctx, rsa::Padding::none);
-          };
-
         // Note that in these cases, using no RSA padding is not dangerous
         // because (1) the content being rotated is always random (2) the
         // content is always the size of the RSA key's modulus.
-        elle::Buffer buffer = raw::asymmetric::rotate(this->_key.get(),
-                                                      seed.buffer(),
-                                                      prolog);
+        elle::Buffer buffer;
+
+        context::cache::apply(
+          this->_key.get(),
+          ::EVP_PKEY_sign_init,
+          padding::resolve(rsa::Padding::none),
+          [] (::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, rsa::Padding::none);
+          },
+          [&] (::EVP_PKEY_CTX* ctx)
+          {
+            buffer = raw::asymmetric::rotate(ctx, seed.buffer());
+          });
 
         return (Seed(buffer, seed.length()));
       }
@@ -343,6 +379,7 @@ namespace infinit
       PrivateKey&
       PrivateKey::operator =(PrivateKey&& other)
       {
+        context::cache::invalidate(this->_key.get());
         this->_key = std::move(other._key);
         cryptography::require();
         this->_check();
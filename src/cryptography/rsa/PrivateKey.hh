@@ -48,7 +48,7 @@ namespace infinit
         PrivateKey(PrivateKey const& other);
         PrivateKey(PrivateKey&& other);
         virtual
-        ~PrivateKey() = default;
+        ~PrivateKey();
 
         /*--------.
         | Methods |
@@ -104,6 +104,11 @@ namespace infinit
         template <typename T>
         std::function<elle::Buffer (PrivateKey const* self)>
         _sign_async(T const& o, elle::Version const& version) const;
+        /// Sign the data written by the plain function, as it is written.
+        elle::Buffer
+        _sign(std::function<void (std::ostream&)> const& plain,
+              Padding const padding = defaults::signature_padding,
+              Oneway const oneway = defaults::oneway) const;
       public:
         /// Write the signature in the output stream given the stream-based
         /// plain text.
@@ -35,7 +35,25 @@ namespace infinit
       elle::Buffer
       PrivateKey::sign(T const& o, elle::Version const& version) const
       {
-        return this->_sign_async(o, version)(this);
+        ELLE_LOG_COMPONENT("infinit.cryptography.rsa.PrivateKey");
+        ELLE_TRACE_SCOPE("%s: sign %s", *this, o);
+        // Stream the object's serialization into the signature function
+        // rather than building it in memory first.
+        auto signature = this->_sign(
+          [&] (std::ostream& plain)
+          {
+            elle::serialization::binary::serialize(o, plain, version, false);
+          });
+        ELLE_DUMP("signature: %s", signature);
+        ELLE_DUMP("version: %s", version);
+        elle::Buffer res;
+        {
+          elle::IOStream output(res.ostreambuf());
+          elle::serialization::binary::serialize(version, output, false);
+          output.write(reinterpret_cast<char const*>(signature.contents()),
+                       signature.size());
+        }
+        return res;
       }
 
       template <typename T>
@@ -4,13 +4,16 @@
 #include <openssl/err.h>
 #include <openssl/pem.h>
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 
 #include <elle/Error.hh>
 #include <elle/Lazy.hh>
 #include <elle/finally.hh>
 #include <elle/log.hh>
 #include <elle/printf.hh>
+#include <elle/serialization/binary.hh>
 
 #include <cryptography/rsa/PublicKey.hh>
 #include <cryptography/rsa/PrivateKey.hh>
@@ -72,6 +75,62 @@ namespace infinit
 
       namespace publickey
       {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        static std::atomic<bool> _lazy(false);
+
+        void
+        lazy(bool const enabled)
+        {
+          _lazy = enabled;
+        }
+
+        bool
+        lazy()
+        {
+          return (_lazy);
+        }
+
+        elle::Buffer
+        seal(std::vector<PublicKey const*> const& recipients,
+             elle::ConstWeakBuffer const& plain,
+             Cipher const cipher,
+             Mode const mode)
+        {
+          elle::IOStream _plain(plain.istreambuf());
+          std::stringstream _code;
+
+          seal(recipients, _plain, _code, cipher, mode);
+
+          elle::Buffer code(_code.str().data(), _code.str().length());
+
+          return (code);
+        }
+
+        void
+        seal(std::vector<PublicKey const*> const& recipients,
+             std::istream& plain,
+             std::ostream& code,
+             Cipher const cipher,
+             Mode const mode)
+        {
+          std::vector< ::EVP_PKEY*> keys;
+
+          for (auto recipient: recipients)
+          {
+            ELLE_ASSERT_NEQ(recipient, nullptr);
+
+            keys.push_back(recipient->key().get());
+          }
+
+          envelope::seal(keys,
+                         cipher::resolve(cipher, mode),
+                         plain,
+                         code);
+        }
+
         /*--------------.
         | Serialization |
         `--------------*/
@@ -122,17 +181,89 @@ namespace infinit
       {}
 
       PublicKey::PublicKey(PublicKey const& other)
-        : PublicKey(low::RSA_dup(other._key->pkey.rsa))
-      {}
+        : _der(other._der.contents(), other._der.size())
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Keep the copy compact should the original be.
+        if (this->_der.size() != 0)
+          this->_materialized = false;
+        else
+        {
+          this->_key =
+            _details::build_evp(low::RSA_dup(other._key->pkey.rsa));
+          this->_check();
+        }
+      }
 
       PublicKey::PublicKey(PublicKey&& other)
-        : PublicKey(other._key.release())
-      {}
+        : _key(std::move(other._key))
+        , _der(std::move(other._der))
+        , _materialized(other._materialized.load())
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+      }
+
+      PublicKey::PublicKey(elle::Buffer&& der)
+        : _der(std::move(der))
+        , _materialized(false)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+      }
+
+      PublicKey::~PublicKey()
+      {
+        context::cache::invalidate(this->_key.get());
+      }
 
       /*--------.
       | Methods |
       `--------*/
 
+      types::EVP_PKEY const&
+      PublicKey::key() const
+      {
+        if (!this->_materialized.load(std::memory_order_acquire))
+        {
+          // Keys being rarely materialized, a single mutex is shared by all
+          // of them rather than adding one to every key.
+          static std::mutex mutex;
+          std::lock_guard<std::mutex> lock(mutex);
+
+          if (!this->_materialized.load(std::memory_order_relaxed))
+          {
+            ELLE_DEBUG("%s: materialize the key", this);
+
+            this->_key =
+              _details::build_evp(rsa::der::decode_public(this->_der));
+            this->_check();
+
+            this->_materialized.store(true, std::memory_order_release);
+          }
+        }
+
+        return (this->_key);
+      }
+
+      void
+      PublicKey::compact()
+      {
+        if (!this->_materialized)
+          return;
+
+        ELLE_DEBUG("%s: compact the key", this);
+
+        if (this->_der.size() == 0)
+          this->_der = rsa::der::encode_public(this->_key->pkey.rsa);
+
+        context::cache::invalidate(this->_key.get());
+        this->_key.reset();
+        this->_materialized = false;
+      }
+
       void
       PublicKey::_check() const
       {
@@ -172,27 +303,76 @@ namespace infinit
                       Cipher const cipher,
                       Mode const mode) const
       {
-        envelope::seal(this->_key.get(),
+        envelope::seal(this->key().get(),
                        cipher::resolve(cipher, mode),
                        plain,
                        code);
       }
 
+      elle::Buffer
+      PublicKey::seal(elle::ConstWeakBuffer const& plain,
+                      envelope::Format const format,
+                      bool const identify,
+                      Cipher const cipher,
+                      Mode const mode) const
+      {
+        ELLE_DUMP("plain: %x", plain);
+
+        elle::IOStream _plain(plain.istreambuf());
+        std::stringstream _code;
+
+        this->seal(_plain, _code,
+                   format, identify,
+                   cipher, mode);
+
+        elle::Buffer code(_code.str().data(), _code.str().length());
+
+        return (code);
+      }
+
+      void
+      PublicKey::seal(std::istream& plain,
+                      std::ostream& code,
+                      envelope::Format const format,
+                      bool const identify,
+                      Cipher const cipher,
+                      Mode const mode) const
+      {
+        elle::Buffer id;
+
+        if (identify)
+          id = envelope::fingerprint(this->key().get());
+
+        envelope::seal(this->key().get(),
+                       cipher::resolve(cipher, mode),
+                       plain,
+                       code,
+                       format,
+                       id);
+      }
+
       elle::Buffer
       PublicKey::encrypt(elle::ConstWeakBuffer const& plain,
                          Padding const padding) const
       {
         ELLE_DUMP("plain: %x", plain);
 
-        auto prolog =
-          [this, padding](::EVP_PKEY_CTX* context)
+        elle::Buffer code;
+
+        context::cache::apply(
+          this->key().get(),
+          ::EVP_PKEY_encrypt_init,
+          padding::resolve(padding),
+          [padding] (::EVP_PKEY_CTX* context)
           {
             padding::pad(context, padding);
-          };
+          },
+          [&] (::EVP_PKEY_CTX* context)
+          {
+            code = raw::asymmetric::encrypt(context, plain);
+          });
 
-        return (raw::asymmetric::encrypt(this->_key.get(),
-                                         plain,
-                                         prolog));
+        return (code);
       }
 
       bool
@@ -242,7 +422,28 @@ namespace infinit
           };
 
         return (raw::asymmetric::verify(
-                  this->_key.get(),
+                  this->key().get(),
+                  oneway::resolve(oneway),
+                  signature,
+                  plain,
+                  prolog));
+      }
+
+      bool
+      PublicKey::_verify(elle::ConstWeakBuffer const& signature,
+                         std::function<void (std::ostream&)> const& plain,
+                         Padding const padding,
+                         Oneway const oneway) const
+      {
+        auto prolog =
+          [this, padding](::EVP_MD_CTX* context,
+                          ::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, padding);
+          };
+
+        return (raw::asymmetric::verify(
+                  this->key().get(),
                   oneway::resolve(oneway),
                   signature,
                   plain,
@@ -253,14 +454,14 @@ namespace infinit
       PublicKey::size() const
       {
         return (static_cast<uint32_t>(
-                  ::EVP_PKEY_size(this->_key.get())));
+                  ::EVP_PKEY_size(this->key().get())));
       }
 
       uint32_t
       PublicKey::length() const
       {
         return (static_cast<uint32_t>(
-                  ::EVP_PKEY_bits(this->_key.get())));
+                  ::EVP_PKEY_bits(this->key().get())));
       }
 
 #if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
@@ -296,19 +497,24 @@ namespace infinit
       {
         ELLE_DUMP("seed: %x", seed);
 
-        auto prolog =
-          [this](::EVP_PKEY_CTX* ctx)
-          {
-            padding::pad(ctx, rsa::Padding::none);
-          };
-
         // The unrotate operation does not rely on padding. Not that relying on
         // textbook RSA is considered foolish. In this case however, restricting
         // the rotation/derivation to content of the size of the RSA key's
         // modulus makes it secure.
-        elle::Buffer buffer = raw::asymmetric::unrotate(this->_key.get(),
-                                                        seed.buffer(),
-                                                        prolog);
+        elle::Buffer buffer;
+
+        context::cache::apply(
+          this->key().get(),
+          ::EVP_PKEY_verify_recover_init,
+          padding::resolve(rsa::Padding::none),
+          [] (::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, rsa::Padding::none);
+          },
+          [&] (::EVP_PKEY_CTX* ctx)
+          {
+            buffer = raw::asymmetric::unrotate(ctx, seed.buffer());
+          });
 
         return (Seed(buffer, seed.length()));
       }
@@ -323,9 +529,13 @@ namespace infinit
       {
         if (this == &other)
           return (true);
-        ELLE_ASSERT_NEQ(this->_key, nullptr);
-        ELLE_ASSERT_NEQ(other._key, nullptr);
-        return (::EVP_PKEY_cmp(this->_key.get(), other._key.get()) == 1);
+        // The DER representation being canonical, compact keys can be
+        // compared without being materialized.
+        if ((this->_der.size() != 0) && (other._der.size() != 0))
+          return (this->_der == other._der);
+        ELLE_ASSERT_NEQ(this->key(), nullptr);
+        ELLE_ASSERT_NEQ(other.key(), nullptr);
+        return (::EVP_PKEY_cmp(this->key().get(), other.key().get()) == 1);
       }
 
       bool
@@ -334,6 +544,16 @@ namespace infinit
         return publickey::der::encode(*this) < publickey::der::encode(other);
       }
 
+      PublicKey&
+      PublicKey::operator =(PublicKey&& other)
+      {
+        context::cache::invalidate(this->_key.get());
+        this->_key = std::move(other._key);
+        this->_der = std::move(other._der);
+        this->_materialized = other._materialized.load();
+        return (*this);
+      }
+
       /*--------------.
       | Serialization |
       `--------------*/
@@ -343,14 +563,16 @@ namespace infinit
         // Make sure the cryptographic system is set up.
         cryptography::require();
 
-        // Allocate the EVP key to receive the deserialized's RSA structure.
-        this->_key.reset(::EVP_PKEY_new());
+        // Keep the DER representation only, the key being decoded upon
+        // first use.
+        if (publickey::lazy())
+        {
+          serializer.serialize(publickey::Serialization::identifier,
+                               this->_der);
+          this->_materialized = false;
 
-        // Set the EVP key as being of type RSA.
-        if (::EVP_PKEY_set_type(this->_key.get(), EVP_PKEY_RSA) <= 0)
-          throw Error(
-            elle::sprintf("unable to set the EVP key's type: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
+          return;
+        }
 
         this->serialize(serializer);
 
@@ -360,12 +582,44 @@ namespace infinit
       void
       PublicKey::serialize(elle::serialization::Serializer& serializer)
       {
-        ELLE_ASSERT_NEQ(this->_key, nullptr);
+        if (serializer.out())
+        {
+          // Output the DER representation as is, without materializing the
+          // key.
+          if (this->_der.size() != 0)
+          {
+            serializer.serialize(publickey::Serialization::identifier,
+                                 this->_der);
 
-        cryptography::serialize<publickey::Serialization>(
-          serializer,
-          this->_key->pkey.rsa);
-        ELLE_ASSERT_NEQ(this->_key->pkey.rsa, nullptr);
+            return;
+          }
+
+          ELLE_ASSERT_NEQ(this->_key, nullptr);
+
+          cryptography::serialize<publickey::Serialization>(
+            serializer,
+            this->_key->pkey.rsa);
+
+          return;
+        }
+
+        ::RSA* rsa = nullptr;
+
+        cryptography::serialize<publickey::Serialization>(serializer, rsa);
+        ELLE_ASSERT_NEQ(rsa, nullptr);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_RSA(rsa);
+
+        // Replace the key, be it compact or not, with a materialized one,
+        // the former DER representation being stale.
+        types::EVP_PKEY key = _details::build_evp(rsa);
+
+        INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(rsa);
+
+        context::cache::invalidate(this->_key.get());
+        this->_key = std::move(key);
+        this->_der = elle::Buffer();
+        this->_materialized = true;
       }
 
       /*----------.
@@ -375,10 +629,6 @@ namespace infinit
       void
       PublicKey::print(std::ostream& stream) const
       {
-        ELLE_ASSERT_NEQ(this->_key, nullptr);
-        ELLE_ASSERT_NEQ(this->_key->pkey.rsa, nullptr);
-        ELLE_ASSERT_NEQ(this->_key->pkey.rsa->n, nullptr);
-        ELLE_ASSERT_NEQ(this->_key->pkey.rsa->e, nullptr);
         elle::fprintf(
           stream, "PublicKey(%f)",
           elle::lazy([this] { return publickey::der::encode(*this); }));
@@ -408,12 +658,19 @@ namespace infinit
           elle::Buffer
           encode(PublicKey const& K)
           {
+            if (K._der.size() != 0)
+              return (elle::Buffer(K._der.contents(), K._der.size()));
+
             return (rsa::der::encode_public(K.key()->pkey.rsa));
           }
 
           PublicKey
           decode(elle::ConstWeakBuffer const& buffer)
           {
+            if (lazy())
+              return (PublicKey(elle::Buffer(buffer.contents(),
+                                             buffer.size())));
+
             ::RSA* rsa = rsa::der::decode_public(buffer);
 
             return (PublicKey(rsa));
@@ -1,8 +1,10 @@
 #ifndef INFINIT_CRYPTOGRAPHY_RSA_PUBLICKEY_HH
 # define INFINIT_CRYPTOGRAPHY_RSA_PUBLICKEY_HH
 
+# include <atomic>
 # include <memory>
 # include <utility>
+# include <vector>
 
 # include <openssl/evp.h>
 
@@ -17,6 +19,8 @@ ELLE_OPERATOR_RELATIONALS();
 # include <cryptography/types.hh>
 # include <cryptography/Oneway.hh>
 # include <cryptography/Cipher.hh>
+# include <cryptography/envelope.hh>
+# include <cryptography/raw.hh>
 # include <cryptography/rsa/Seed.hh>
 # include <cryptography/rsa/Padding.hh>
 # include <cryptography/rsa/defaults.hh>
@@ -27,7 +31,24 @@ namespace infinit
   {
     namespace rsa
     {
+      namespace publickey
+      {
+        namespace der
+        {
+          elle::Buffer
+          encode(PublicKey const& K);
+          PublicKey
+          decode(elle::ConstWeakBuffer const& buffer);
+        }
+      }
+
       /// Represent a public key in the RSA asymmetric cryptosystem.
+      ///
+      /// Note that a public key can be kept in a compact form i.e its DER
+      /// representation only, the OpenSSL structures being built upon the
+      /// first cryptographic operation. This is the case of the keys
+      /// deserialized or decoded from DER when publickey::lazy() is enabled
+      /// and of the keys having been compact()ed.
       class PublicKey
         : public elle::Printable
         , public std::enable_shared_from_this<PublicKey>
@@ -50,7 +71,17 @@ namespace infinit
         PublicKey(PublicKey const& other);
         PublicKey(PublicKey&& other);
         virtual
-        ~PublicKey() = default;
+        ~PublicKey();
+      private:
+        /// Construct a compact public key out of its DER representation.
+        explicit
+        PublicKey(elle::Buffer&& der);
+        friend
+        PublicKey
+        publickey::der::decode(elle::ConstWeakBuffer const& buffer);
+        friend
+        elle::Buffer
+        publickey::der::encode(PublicKey const& K);
 
         /*--------.
         | Methods |
@@ -60,7 +91,23 @@ namespace infinit
         void
         _check() const;
       public:
-        /// Encrypt the plain text and return the ciphered text in an envelope.
+        /// Return the OpenSSL representation of the key, building it should
+        /// the key be compact.
+        types::EVP_PKEY const&
+        key() const;
+        /// Release the OpenSSL representation of the key, keeping its DER
+        /// representation only until the next cryptographic operation.
+        ///
+        /// Note that this method must not be called while the key is being
+        /// used by other threads.
+        void
+        compact();
+        /// Encrypt the plain text and return the ciphered text in an envelope
+        /// of the default format, see envelope::format().
+        ///
+        /// Note that in the v4 format, plain texts small enough to fit in
+        /// the key's modulus once padded with OAEP are directly encrypted
+        /// with the key.
         virtual
         elle::Buffer
         seal(elle::ConstWeakBuffer const& plain,
@@ -72,6 +119,28 @@ namespace infinit
              std::ostream& code,
              Cipher const cipher = defaults::envelope_cipher,
              Mode const mode = defaults::envelope_mode) const;
+        /// Encrypt the plain text and return the ciphered text in an envelope
+        /// of the given format, the v2, v3 and v4 envelopes embedding the
+        /// key's fingerprint should _identify_ be true so that the recipient
+        /// can find its key in a Keyring.
+        ///
+        /// Note that the v4 format includes the plain texts directly
+        /// encrypted with the key.
+        elle::Buffer
+        seal(elle::ConstWeakBuffer const& plain,
+             envelope::Format const format,
+             bool const identify,
+             Cipher const cipher = defaults::envelope_cipher,
+             Mode const mode = defaults::envelope_mode) const;
+        /// Encrypt the stream-based plain text and seal it in an envelope
+        /// of the given format, possibly identifying the key.
+        void
+        seal(std::istream& plain,
+             std::ostream& code,
+             envelope::Format const format,
+             bool const identify,
+             Cipher const cipher = defaults::envelope_cipher,
+             Mode const mode = defaults::envelope_mode) const;
         /// Encrypt a plain text using the raw public key.
         ///
         /// WARNING: This method cannot be used to encrypt large amount of
@@ -105,6 +174,13 @@ namespace infinit
         std::pair<elle::Buffer, elle::Buffer>
         _verify_data(elle::ConstWeakBuffer const& signature,
                      T const& o) const;
+        /// Verify the signature against the data written by the plain
+        /// function, as it is written.
+        bool
+        _verify(elle::ConstWeakBuffer const& signature,
+                std::function<void (std::ostream&)> const& plain,
+                Padding const padding = defaults::signature_padding,
+                Oneway const oneway = defaults::oneway) const;
       public:
         /// Whether the given signature matches the stream-based plain.
         bool
@@ -148,7 +224,7 @@ namespace infinit
         bool
         operator <(PublicKey const& other) const;
         PublicKey&
-        operator =(PublicKey&& other) = default;
+        operator =(PublicKey&& other);
 
         /*----------.
         | Printable |
@@ -169,8 +245,13 @@ namespace infinit
         /*-----------.
         | Attributes |
         `-----------*/
-      public:
-        ELLE_ATTRIBUTE_R(types::EVP_PKEY, key);
+      private:
+        /// The OpenSSL representation, null for compact keys.
+        mutable types::EVP_PKEY _key;
+        /// The DER representation, only kept for compact keys.
+        elle::Buffer _der;
+        /// Whether the OpenSSL representation is available.
+        mutable std::atomic<bool> _materialized{true};
       };
 
       namespace _details
@@ -196,6 +277,36 @@ namespace infinit
     {
       namespace publickey
       {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Set whether the public keys deserialized or decoded from DER are
+        /// kept in their compact DER representation, the OpenSSL structures
+        /// being built upon first use. Disabled by default.
+        ///
+        /// Note that invalid representations are then only detected upon
+        /// the first cryptographic operation.
+        void
+        lazy(bool const enabled);
+        /// Return whether public keys are lazily materialized.
+        bool
+        lazy();
+        /// Seal the plain text in an envelope that every one of the given
+        /// recipients can open, the plain text being encrypted only once.
+        elle::Buffer
+        seal(std::vector<PublicKey const*> const& recipients,
+             elle::ConstWeakBuffer const& plain,
+             Cipher const cipher = defaults::envelope_cipher,
+             Mode const mode = defaults::envelope_mode);
+        /// Seal the stream-based plain text for several recipients.
+        void
+        seal(std::vector<PublicKey const*> const& recipients,
+             std::istream& plain,
+             std::ostream& code,
+             Cipher const cipher = defaults::envelope_cipher,
+             Mode const mode = defaults::envelope_mode);
+
         namespace der
         {
           /*----------.
@@ -30,8 +30,20 @@ namespace infinit
       PublicKey::verify(elle::ConstWeakBuffer const& signature,
                         T const& o) const
       {
-        auto data = this->_verify_data(signature, o);
-        return this->_verify(data.first, data.second);
+        ELLE_LOG_COMPONENT("infinit.cryptography.rsa.PublicKey");
+        ELLE_TRACE_SCOPE("%s: verify %s", this, o);
+        auto header = raw::asymmetric::split(signature);
+        ELLE_DUMP("serialization version: %s", header.first);
+        ELLE_DUMP("signature: %s", header.second);
+        // Stream the object's serialization into the verification function
+        // rather than building it in memory first.
+        std::function<void (std::ostream&)> plain =
+          [&] (std::ostream& output)
+          {
+            elle::serialization::binary::serialize(o, output,
+                                                   header.first, false);
+          };
+        return this->_verify(header.second, plain);
       }
 
       template <typename T>
@@ -53,11 +65,11 @@ namespace infinit
       {
         ELLE_LOG_COMPONENT("infinit.cryptography.rsa.PublicKey");
         ELLE_TRACE_SCOPE("%s: verify %s", this, o);
-        elle::IOStream input(signature.istreambuf());
-        auto version =
-          elle::serialization::binary::deserialize<elle::Version>(input, false);
-        auto s = elle::Buffer(std::string{std::istreambuf_iterator<char>(input),
-                                          std::istreambuf_iterator<char>()});
+        // The signature is copied and the object serialized since both must
+        // outlive the call for asynchronous verifications.
+        auto header = raw::asymmetric::split(signature);
+        auto version = header.first;
+        auto s = elle::Buffer(header.second.contents(), header.second.size());
         auto serialized =
           elle::serialization::binary::serialize(o, version, false);
         ELLE_DUMP(
@@ -0,0 +1,625 @@
+#include <cryptography/rsa/Reservoir.hh>
+
+#if defined(INFINIT_WINDOWS)
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/file.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/rsa/PrivateKey.hh>
+#include <cryptography/rsa/PublicKey.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.Reservoir");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /*----------.
+      | Constants |
+      `----------*/
+
+      /// The magic number starting the records file.
+      static char const _magic[4] = { 'I', 'R', 'S', 'V' };
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      static
+      void
+      _raise(std::string const& message,
+             std::string const& path)
+      {
+#if defined(INFINIT_WINDOWS)
+        throw Error(
+          elle::sprintf("%s '%s': error %s", message, path, ::GetLastError()));
+#else
+        throw Error(
+          elle::sprintf("%s '%s': %s", message, path, ::strerror(errno)));
+#endif
+      }
+
+      static
+      void
+      _encode(std::string& output,
+              uint64_t value,
+              uint32_t const bytes)
+      {
+        for (uint32_t i = 0; i < bytes; ++i)
+          output.push_back(
+            static_cast<char>((value >> (8 * (bytes - i - 1))) & 0xff));
+      }
+
+      static
+      uint64_t
+      _decode(char const* input,
+              uint32_t const bytes)
+      {
+        uint64_t value = 0;
+
+        for (uint32_t i = 0; i < bytes; ++i)
+          value = (value << 8) | static_cast<unsigned char>(input[i]);
+
+        return (value);
+      }
+
+      /// Read the whole file, returning false should it not exist.
+      static
+      bool
+      _read(std::string const& path,
+            std::string& content)
+      {
+        std::ifstream input(path, std::ios::binary);
+
+        if (!input.is_open())
+          return (false);
+
+        std::stringstream stream;
+        stream << input.rdbuf();
+        if (input.bad())
+          _raise("unable to read the file", path);
+
+        content = stream.str();
+
+        return (true);
+      }
+
+#if defined(INFINIT_WINDOWS)
+      static Reservoir::Descriptor const _invalid = INVALID_HANDLE_VALUE;
+#else
+      static Reservoir::Descriptor const _invalid = -1;
+#endif
+
+      /// Open the given file for writing: created, or truncated, should
+      /// _create_ be true and opened for appending otherwise.
+      static
+      Reservoir::Descriptor
+      _open(std::string const& path,
+            bool const create)
+      {
+#if defined(INFINIT_WINDOWS)
+        HANDLE descriptor = ::CreateFileA(path.c_str(),
+                                          GENERIC_WRITE,
+                                          FILE_SHARE_READ,
+                                          nullptr,
+                                          create ? CREATE_ALWAYS
+                                                 : OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL,
+                                          nullptr);
+#else
+        int descriptor =
+          create ?
+          ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600) :
+          ::open(path.c_str(), O_WRONLY | O_APPEND);
+#endif
+        if (descriptor == _invalid)
+          _raise("unable to open the file", path);
+
+        return (descriptor);
+      }
+
+      static
+      void
+      _close(Reservoir::Descriptor const descriptor)
+      {
+        if (descriptor == _invalid)
+          return;
+
+#if defined(INFINIT_WINDOWS)
+        ::CloseHandle(descriptor);
+#else
+        ::close(descriptor);
+#endif
+      }
+
+      /// Open, or create, the given file and lock it exclusively, raising
+      /// an error should it be locked already.
+      static
+      Reservoir::Descriptor
+      _acquire(std::string const& path)
+      {
+#if defined(INFINIT_WINDOWS)
+        HANDLE descriptor = ::CreateFileA(path.c_str(),
+                                          GENERIC_READ | GENERIC_WRITE,
+                                          FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                          nullptr,
+                                          OPEN_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL,
+                                          nullptr);
+        if (descriptor == INVALID_HANDLE_VALUE)
+          _raise("unable to open the file", path);
+
+        OVERLAPPED overlapped = {};
+
+        if (!::LockFileEx(descriptor,
+                          LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY,
+                          0, 1, 0,
+                          &overlapped))
+        {
+          bool busy = (::GetLastError() == ERROR_LOCK_VIOLATION);
+
+          ::CloseHandle(descriptor);
+
+          if (busy)
+            throw Error(
+              elle::sprintf("the reservoir '%s' is in use by another process",
+                            path));
+
+          _raise("unable to lock the file", path);
+        }
+#else
+        int descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (descriptor < 0)
+          _raise("unable to open the file", path);
+
+        if (::flock(descriptor, LOCK_EX | LOCK_NB) != 0)
+        {
+          int error = errno;
+
+          ::close(descriptor);
+
+          if (error == EWOULDBLOCK)
+            throw Error(
+              elle::sprintf("the reservoir '%s' is in use by another process",
+                            path));
+
+          errno = error;
+          _raise("unable to lock the file", path);
+        }
+#endif
+
+        return (descriptor);
+      }
+
+      static
+      void
+      _write(Reservoir::Descriptor const descriptor,
+             std::string const& data,
+             std::string const& path)
+      {
+        std::size_t offset = 0;
+
+        while (offset < data.size())
+        {
+#if defined(INFINIT_WINDOWS)
+          DWORD written = 0;
+
+          if (!::WriteFile(descriptor,
+                           data.data() + offset,
+                           static_cast<DWORD>(data.size() - offset),
+                           &written,
+                           nullptr))
+            _raise("unable to write the file", path);
+#else
+          ::ssize_t written = ::write(descriptor,
+                                      data.data() + offset,
+                                      data.size() - offset);
+
+          if (written < 0)
+          {
+            if (errno == EINTR)
+              continue;
+
+            _raise("unable to write the file", path);
+          }
+#endif
+
+          offset += written;
+        }
+      }
+
+      /// Flush the file's content to the disk.
+      static
+      void
+      _synchronize(Reservoir::Descriptor const descriptor,
+                   std::string const& path)
+      {
+#if defined(INFINIT_WINDOWS)
+        if (!::FlushFileBuffers(descriptor))
+          _raise("unable to synchronize the file", path);
+#else
+        if (::fsync(descriptor) != 0)
+          _raise("unable to synchronize the file", path);
+#endif
+      }
+
+      /// Move to the end of the file, returning its size.
+      static
+      uint64_t
+      _end(Reservoir::Descriptor const descriptor,
+           std::string const& path)
+      {
+#if defined(INFINIT_WINDOWS)
+        LARGE_INTEGER distance = {};
+        LARGE_INTEGER offset;
+
+        if (!::SetFilePointerEx(descriptor, distance, &offset, FILE_END))
+          _raise("unable to seek the file", path);
+
+        return (static_cast<uint64_t>(offset.QuadPart));
+#else
+        ::off_t offset = ::lseek(descriptor, 0, SEEK_END);
+        if (offset < 0)
+          _raise("unable to seek the file", path);
+
+        return (static_cast<uint64_t>(offset));
+#endif
+      }
+
+      /// Truncate the file to the given size, returning false on failure.
+      static
+      bool
+      _truncate(Reservoir::Descriptor const descriptor,
+                uint64_t const size)
+      {
+#if defined(INFINIT_WINDOWS)
+        LARGE_INTEGER distance;
+        distance.QuadPart = static_cast<LONGLONG>(size);
+
+        return (::SetFilePointerEx(descriptor, distance, nullptr, FILE_BEGIN) &&
+                ::SetEndOfFile(descriptor));
+#else
+        return (::ftruncate(descriptor, static_cast< ::off_t>(size)) == 0);
+#endif
+      }
+
+      /// Replace the file's content atomically by writing a temporary
+      /// file and renaming it.
+      static
+      void
+      _replace(std::string const& path,
+               std::string const& data)
+      {
+        std::string temporary = path + ".tmp";
+
+        Reservoir::Descriptor descriptor = _open(temporary, true);
+
+        try
+        {
+          _write(descriptor, data, temporary);
+          _synchronize(descriptor, temporary);
+        }
+        catch (...)
+        {
+          _close(descriptor);
+
+          throw;
+        }
+
+        _close(descriptor);
+
+#if defined(INFINIT_WINDOWS)
+        if (!::MoveFileExA(temporary.c_str(),
+                           path.c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+          _raise("unable to rename the file", temporary);
+#else
+        if (::rename(temporary.c_str(), path.c_str()) != 0)
+          _raise("unable to rename the file", temporary);
+
+        // Synchronize the directory for the rename to be durable.
+        std::string directory = ".";
+        auto separator = path.find_last_of('/');
+        if (separator != std::string::npos)
+          directory = path.substr(0, separator + 1);
+
+        int _directory = ::open(directory.c_str(), O_RDONLY);
+        if (_directory < 0)
+          _raise("unable to open the directory", directory);
+        ::fsync(_directory);
+        ::close(_directory);
+#endif
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      Reservoir::Reservoir(std::string path,
+                           SecretKey key,
+                           uint32_t const length,
+                           uint32_t const capacity):
+        _path(std::move(path)),
+        _key(std::move(key)),
+        _length(length),
+        _capacity(capacity),
+        _cursor(0),
+        _lock(_invalid),
+        _descriptor(_invalid),
+        _stop(false)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+
+        // Lock the reservoir before reading it so that no other process
+        // hands out the same key pairs.
+        this->_lock = _acquire(this->_path + ".lock");
+
+        try
+        {
+          this->_load();
+        }
+        catch (...)
+        {
+          _close(this->_descriptor);
+          _close(this->_lock);
+
+          throw;
+        }
+
+        this->_thread = std::thread([this] { this->_refill(); });
+      }
+
+      Reservoir::~Reservoir()
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          this->_stop = true;
+        }
+        this->_consumed.notify_all();
+
+        this->_thread.join();
+
+        _close(this->_descriptor);
+        // Release the lock last, the reservoir being no longer used.
+        _close(this->_lock);
+      }
+
+      /*--------.
+      | Methods |
+      `--------*/
+
+      std::unique_ptr<KeyPair>
+      Reservoir::take()
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        while (!this->_records.empty())
+        {
+          // Durably advance the cursor before handing out the key pair.
+          this->_advance(this->_cursor + 1);
+          this->_cursor += 1;
+
+          elle::Buffer record = std::move(this->_records.front());
+          this->_records.pop_front();
+
+          this->_consumed.notify_all();
+
+          try
+          {
+            PrivateKey k =
+              privatekey::der::decode(this->_key.decipher(record));
+            PublicKey K(k);
+
+            ELLE_DEBUG("%s: hand out key pair %s", *this, this->_cursor);
+
+            return (std::unique_ptr<KeyPair>(
+                      new KeyPair(std::move(K), std::move(k))));
+          }
+          catch (Error const& e)
+          {
+            ELLE_WARN("%s: discard the invalid record %s: %s",
+                      *this, this->_cursor, e.what());
+          }
+        }
+
+        return (nullptr);
+      }
+
+      void
+      Reservoir::put(KeyPair const& keypair)
+      {
+        elle::Buffer record =
+          this->_key.encipher(privatekey::der::encode(keypair.k()));
+
+        std::string data;
+        _encode(data, record.size(), 4);
+        data.append(reinterpret_cast<char const*>(record.contents()),
+                    record.size());
+
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        uint64_t offset = _end(this->_descriptor, this->_path);
+
+        try
+        {
+          _write(this->_descriptor, data, this->_path);
+          _synchronize(this->_descriptor, this->_path);
+        }
+        catch (...)
+        {
+          // Remove the partially written record so as not to corrupt the
+          // following ones.
+          if (!_truncate(this->_descriptor, offset))
+            ELLE_ERR("%s: unable to truncate the records file", *this);
+
+          throw;
+        }
+
+        this->_records.push_back(std::move(record));
+      }
+
+      std::size_t
+      Reservoir::size() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        return (this->_records.size());
+      }
+
+      void
+      Reservoir::_load()
+      {
+        ELLE_TRACE_SCOPE("%s: load", *this);
+
+        std::string content;
+
+        // Read the number of records handed out.
+        uint64_t cursor = 0;
+
+        if (_read(this->_path + ".cursor", content))
+        {
+          if (content.size() != 8)
+            throw Error(
+              elle::sprintf("invalid cursor file '%s.cursor'", this->_path));
+
+          cursor = _decode(content.data(), 8);
+        }
+
+        // Read the records, ignoring the ones handed out and the last one
+        // should it have been partially written.
+        uint64_t base = cursor;
+        std::deque<elle::Buffer> records;
+
+        if (_read(this->_path, content))
+        {
+          if ((content.size() < (sizeof (_magic) + 8)) ||
+              (::memcmp(content.data(), _magic, sizeof (_magic)) != 0))
+            throw Error(
+              elle::sprintf("invalid records file '%s'", this->_path));
+
+          base = _decode(content.data() + sizeof (_magic), 8);
+
+          uint64_t index = base;
+          std::size_t offset = sizeof (_magic) + 8;
+
+          while ((offset + 4) <= content.size())
+          {
+            std::size_t size = _decode(content.data() + offset, 4);
+
+            if ((offset + 4 + size) > content.size())
+            {
+              ELLE_WARN("%s: discard the truncated record %s", *this, index);
+              break;
+            }
+
+            if (index >= cursor)
+              records.emplace_back(content.data() + offset + 4, size);
+
+            offset += 4 + size;
+            index += 1;
+          }
+        }
+
+        // The records preceding the first one have necessarily been handed
+        // out.
+        if (cursor < base)
+          cursor = base;
+
+        ELLE_DEBUG("%s: %s records available from %s",
+                   *this, records.size(), cursor);
+
+        // Rewrite the records file with the remaining records only and
+        // starting with the cursor, before the cursor file: should a crash
+        // occur in between, both remain consistent.
+        std::string output(_magic, sizeof (_magic));
+        _encode(output, cursor, 8);
+        for (auto const& record: records)
+        {
+          _encode(output, record.size(), 4);
+          output.append(reinterpret_cast<char const*>(record.contents()),
+                        record.size());
+        }
+
+        _replace(this->_path, output);
+        this->_advance(cursor);
+
+        this->_records = std::move(records);
+        this->_cursor = cursor;
+
+        this->_descriptor = _open(this->_path, false);
+      }
+
+      void
+      Reservoir::_advance(uint64_t const cursor)
+      {
+        std::string output;
+        _encode(output, cursor, 8);
+
+        _replace(this->_path + ".cursor", output);
+      }
+
+      void
+      Reservoir::_refill()
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        while (!this->_stop)
+        {
+          if (this->_records.size() >= this->_capacity)
+          {
+            this->_consumed.wait(lock);
+
+            continue;
+          }
+
+          lock.unlock();
+
+          try
+          {
+            this->put(keypair::generate(this->_length));
+
+            lock.lock();
+          }
+          catch (std::exception const& e)
+          {
+            ELLE_ERR("%s: unable to store a new key pair: %s",
+                     *this, e.what());
+
+            lock.lock();
+
+            // Do not retry immediately.
+            this->_consumed.wait_for(lock, std::chrono::seconds(1));
+          }
+        }
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      Reservoir::print(std::ostream& stream) const
+      {
+        stream << "Reservoir(" << this->_path << ")";
+      }
+    }
+  }
+}
@@ -0,0 +1,139 @@
+#ifndef INFINIT_CRYPTOGRAPHY_RSA_RESERVOIR_HH
+# define INFINIT_CRYPTOGRAPHY_RSA_RESERVOIR_HH
+
+# include <condition_variable>
+# include <deque>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <thread>
+
+# include <elle/Buffer.hh>
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+
+# include <cryptography/SecretKey.hh>
+# include <cryptography/rsa/KeyPair.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Represent an on-disk store of pregenerated key pairs, enciphered
+      /// with a secret key, which a background thread keeps filled up to its
+      /// capacity.
+      ///
+      /// The reservoir is made of two files: the records file, at the given
+      /// path, to which the key pairs are appended and the cursor file, with
+      /// the '.cursor' extension, holding the number of key pairs ever
+      /// handed out. The cursor is durably advanced before a key pair is
+      /// handed out so that no key pair can be handed out twice, even across
+      /// crashes; at worst a key pair is lost.
+      ///
+      /// The records file starts with the index of its first record,
+      /// allowing the consumed records to be removed at startup without
+      /// having to update both files atomically.
+      ///
+      /// Note that a reservoir holds an exclusive lock on a third file, with
+      /// the '.lock' extension, for as long as it is open so that several
+      /// processes cannot hand out the same key pairs.
+      class Reservoir
+        : public elle::Printable
+      {
+        /*------.
+        | Types |
+        `------*/
+      public:
+        /// The platform's file descriptor.
+# if defined(INFINIT_WINDOWS)
+        typedef void* Descriptor;
+# else
+        typedef int Descriptor;
+# endif
+
+        /*-------------.
+        | Construction |
+        `-------------*/
+      public:
+        /// Open, or create, the reservoir at the given path whose key pairs
+        /// are enciphered with the given secret key, the background thread
+        /// generating key pairs of the given length until the reservoir
+        /// holds capacity of them.
+        ///
+        /// Note that an error is raised should the reservoir be in use by
+        /// another process.
+        Reservoir(std::string path,
+                  SecretKey key,
+                  uint32_t const length,
+                  uint32_t const capacity);
+        Reservoir(Reservoir const&) = delete;
+        ~Reservoir();
+
+        /*--------.
+        | Methods |
+        `--------*/
+      public:
+        /// Return the next key pair, never handed out before, or null
+        /// should the reservoir be empty.
+        std::unique_ptr<KeyPair>
+        take();
+        /// Durably append the given key pair to the reservoir.
+        void
+        put(KeyPair const& keypair);
+        /// Return the number of key pairs in the reservoir.
+        std::size_t
+        size() const;
+      private:
+        /// Load the reservoir's files, discarding the consumed records and
+        /// a possibly truncated last record.
+        void
+        _load();
+        /// Durably write the cursor file.
+        void
+        _advance(uint64_t const cursor);
+        /// Generate key pairs until the capacity is reached.
+        void
+        _refill();
+
+        /*----------.
+        | Operators |
+        `----------*/
+      public:
+        Reservoir&
+        operator =(Reservoir const&) = delete;
+
+        /*----------.
+        | Printable |
+        `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+        /*-----------.
+        | Attributes |
+        `-----------*/
+      private:
+        ELLE_ATTRIBUTE_R(std::string, path);
+        ELLE_ATTRIBUTE(SecretKey, key);
+        ELLE_ATTRIBUTE_R(uint32_t, length);
+        ELLE_ATTRIBUTE_R(uint32_t, capacity);
+        /// The enciphered records not handed out yet.
+        ELLE_ATTRIBUTE(std::deque<elle::Buffer>, records);
+        /// The number of records ever handed out.
+        ELLE_ATTRIBUTE(uint64_t, cursor);
+        /// The descriptor of the lock file, locked exclusively.
+        ELLE_ATTRIBUTE(Descriptor, lock);
+        /// The descriptor of the records file, opened for appending.
+        ELLE_ATTRIBUTE(Descriptor, descriptor);
+        ELLE_ATTRIBUTE(bool, stop);
+        mutable std::mutex _mutex;
+        std::condition_variable _consumed;
+        std::thread _thread;
+      };
+    }
+  }
+}
+
+#endif
@@ -1,10 +1,13 @@
 #ifndef INFINIT_CRYPTOGRAPHY_RSA_ALL_HH
 # define INFINIT_CRYPTOGRAPHY_RSA_ALL_HH
 
+# include <cryptography/rsa/Batch.hh>
 # include <cryptography/rsa/KeyPair.hh>
+# include <cryptography/rsa/Keyring.hh>
 # include <cryptography/rsa/Padding.hh>
 # include <cryptography/rsa/PrivateKey.hh>
 # include <cryptography/rsa/PublicKey.hh>
+# include <cryptography/rsa/Reservoir.hh>
 # if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
 #  include <cryptography/rsa/Seed.hh>
 # endif
@@ -13,6 +16,8 @@
 # include <cryptography/rsa/der.hh>
 # include <cryptography/rsa/defaults.hh>
 # include <cryptography/rsa/low.hh>
+# include <cryptography/rsa/multiprime.hh>
 # include <cryptography/rsa/serialization.hh>
+# include <cryptography/rsa/session.hh>
 
 #endif
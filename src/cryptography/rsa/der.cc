@@ -1,10 +1,13 @@
 #include <cryptography/Error.hh>
 #include <cryptography/finally.hh>
 #include <cryptography/rsa/der.hh>
+#include <cryptography/rsa/multiprime.hh>
 
 #include <openssl/err.h>
 #include <openssl/x509.h>
 
+#include <vector>
+
 namespace infinit
 {
   namespace cryptography
@@ -13,6 +16,209 @@ namespace infinit
     {
       namespace der
       {
+        /*---------------.
+        | Static Methods |
+        `---------------*/
+
+        /// The ASN.1 tags of the RSAPrivateKey structure's elements.
+        static unsigned char const _integer = 0x02;
+        static unsigned char const _sequence = 0x30;
+
+        /// Append an element, composed of the given tag and content, to the
+        /// buffer.
+        static
+        void
+        _write(elle::Buffer& buffer,
+               unsigned char const tag,
+               elle::ConstWeakBuffer const& content)
+        {
+          std::vector<unsigned char> header{tag};
+
+          if (content.size() < 0x80)
+            header.push_back(static_cast<unsigned char>(content.size()));
+          else
+          {
+            std::vector<unsigned char> length;
+
+            for (auto size = content.size(); size != 0; size >>= 8)
+              length.insert(length.begin(),
+                            static_cast<unsigned char>(size & 0xff));
+
+            header.push_back(static_cast<unsigned char>(0x80 | length.size()));
+            header.insert(header.end(), length.begin(), length.end());
+          }
+
+          buffer.append(header.data(), header.size());
+          buffer.append(content.contents(), content.size());
+        }
+
+        /// Append the given non-negative integer to the buffer.
+        static
+        void
+        _write(elle::Buffer& buffer,
+               ::BIGNUM const* bn)
+        {
+          // Prepend a zero byte should the most significant bit be set, so
+          // that the integer be not interpreted as negative.
+          int bytes = ::BN_num_bytes(bn);
+          bool pad = (::BN_num_bits(bn) % 8) == 0;
+          elle::Buffer content(bytes + (pad ? 1 : 0));
+
+          content.mutable_contents()[0] = 0;
+          ::BN_bn2bin(bn, content.mutable_contents() + (pad ? 1 : 0));
+
+          _write(buffer, _integer, content);
+        }
+
+        /// Read the element of the given tag, returning its content.
+        static
+        elle::ConstWeakBuffer
+        _read(elle::ConstWeakBuffer& buffer,
+              unsigned char const tag)
+        {
+          unsigned char const* p = buffer.contents();
+          std::size_t size = buffer.size();
+
+          if ((size < 2) || (p[0] != tag))
+            throw Error("unable to decode the RSA private key: unexpected "
+                        "element");
+
+          std::size_t length = p[1];
+          std::size_t offset = 2;
+
+          if (length & 0x80)
+          {
+            std::size_t bytes = length & 0x7f;
+
+            if ((bytes == 0) || (bytes > sizeof (std::size_t)) ||
+                (size < offset + bytes))
+              throw Error("unable to decode the RSA private key: invalid "
+                          "length");
+
+            length = 0;
+            for (std::size_t i = 0; i < bytes; ++i)
+              length = (length << 8) | p[offset++];
+          }
+
+          if (length > size - offset)
+            throw Error("unable to decode the RSA private key: truncated "
+                        "element");
+
+          buffer = elle::ConstWeakBuffer(p + offset + length,
+                                         size - offset - length);
+
+          return (elle::ConstWeakBuffer(p + offset, length));
+        }
+
+        /// Read an integer.
+        static
+        types::BIGNUM
+        _read(elle::ConstWeakBuffer& buffer)
+        {
+          elle::ConstWeakBuffer content = _read(buffer, _integer);
+          types::BIGNUM bn(::BN_bin2bn(content.contents(),
+                                       content.size(),
+                                       nullptr));
+
+          if (bn == nullptr)
+            throw Error(
+              elle::sprintf("unable to decode the RSA private key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (bn);
+        }
+
+        /// Encode a multi-prime key as a version 1 RSAPrivateKey structure
+        /// including the otherPrimeInfos, see RFC 8017 appendix A.1.2.
+        static
+        elle::Buffer
+        _encode_multiprime(::RSA* rsa,
+                           multiprime::Primes const& primes)
+        {
+          elle::Buffer content;
+          elle::Buffer version;
+          version.append("\x01", 1);
+
+          _write(content, _integer, version);
+          for (::BIGNUM const* bn: {rsa->n, rsa->e, rsa->d, rsa->p, rsa->q,
+                                    rsa->dmp1, rsa->dmq1, rsa->iqmp})
+            _write(content, bn);
+
+          elle::Buffer others;
+          for (auto const& prime: primes)
+          {
+            elle::Buffer other;
+
+            _write(other, prime.prime.get());
+            _write(other, prime.exponent.get());
+            _write(other, prime.coefficient.get());
+
+            _write(others, _sequence, other);
+          }
+          _write(content, _sequence, others);
+
+          elle::Buffer buffer;
+          _write(buffer, _sequence, content);
+
+          return (buffer);
+        }
+
+        /// Decode a version 1 RSAPrivateKey structure, returning null should
+        /// the given key be a version 0 one.
+        static
+        ::RSA*
+        _decode_multiprime(elle::ConstWeakBuffer const& buffer)
+        {
+          elle::ConstWeakBuffer input(buffer);
+          elle::ConstWeakBuffer content = _read(input, _sequence);
+          types::BIGNUM version = _read(content);
+
+          if (::BN_is_zero(version.get()))
+            return (nullptr);
+
+          if (!::BN_is_one(version.get()))
+            throw Error("unable to decode the RSA private key: unknown "
+                        "version");
+
+          ::RSA* rsa = ::RSA_new();
+
+          if (rsa == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the RSA key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_RSA(rsa);
+
+          for (::BIGNUM** bn: {&rsa->n, &rsa->e, &rsa->d, &rsa->p, &rsa->q,
+                               &rsa->dmp1, &rsa->dmq1, &rsa->iqmp})
+            *bn = _read(content).release();
+
+          elle::ConstWeakBuffer others = _read(content, _sequence);
+          multiprime::Primes primes;
+
+          while (others.size() != 0)
+          {
+            elle::ConstWeakBuffer other = _read(others, _sequence);
+            multiprime::Prime prime;
+
+            prime.prime = _read(other);
+            prime.exponent = _read(other);
+            prime.coefficient = _read(other);
+
+            primes.push_back(std::move(prime));
+          }
+
+          if (primes.empty())
+            throw Error("unable to decode the RSA private key: missing "
+                        "additional primes");
+
+          multiprime::attach(rsa, std::move(primes));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(rsa);
+
+          return (rsa);
+        }
+
         /*----------.
         | Functions |
         `----------*/
@@ -56,6 +262,9 @@ namespace infinit
         elle::Buffer
         encode_private(::RSA* rsa)
         {
+          if (auto primes = multiprime::primes(rsa))
+            return (_encode_multiprime(rsa, *primes));
+
           unsigned char* _buffer = nullptr;
 
           int _size = ::i2d_RSAPrivateKey(rsa, &_buffer);
@@ -77,6 +286,9 @@ namespace infinit
         ::RSA*
         decode_private(elle::ConstWeakBuffer const& buffer)
         {
+          if (::RSA* rsa = _decode_multiprime(buffer))
+            return (rsa);
+
           const unsigned char* _buffer = buffer.contents();
           long _size = buffer.size();
 
@@ -0,0 +1,435 @@
+#include <cryptography/rsa/multiprime.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/Executor.hh>
+#include <cryptography/cryptography.hh>
+#include <cryptography/finally.hh>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.multiprime");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace multiprime
+      {
+        /*-------.
+        | Method |
+        `-------*/
+
+        /// Release the primes attached to a RSA structure being freed.
+        static
+        void
+        _free(void*,
+              void* pointer,
+              ::CRYPTO_EX_DATA*,
+              int,
+              long,
+              void*)
+        {
+          delete static_cast<Primes*>(pointer);
+        }
+
+        /// Return the index of the RSA structures' extra data holding the
+        /// additional primes.
+        static
+        int
+        _index()
+        {
+          static int const index =
+            ::RSA_get_ex_new_index(0, nullptr, nullptr, nullptr, _free);
+
+          if (index < 0)
+            throw Error(
+              elle::sprintf("unable to allocate the RSA extra data index: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          return (index);
+        }
+
+        /// Compute r0 = I^d mod n through the multi-prime CRT, see RFC 8017
+        /// section 5.1.2, for keys having additional primes attached.
+        static
+        int
+        _mod_exp(::BIGNUM* r0,
+                 ::BIGNUM const* I,
+                 ::RSA* rsa,
+                 ::BN_CTX* context)
+        {
+          Primes const* others = primes(rsa);
+
+          if (others == nullptr)
+            return (::RSA_PKCS1_SSLeay()->rsa_mod_exp(r0, I, rsa, context));
+
+          ::BN_CTX_start(context);
+
+          elle::SafeFinally end([&] () { ::BN_CTX_end(context); });
+
+          ::BIGNUM* c = ::BN_CTX_get(context);
+          ::BIGNUM* m = ::BN_CTX_get(context);
+          ::BIGNUM* h = ::BN_CTX_get(context);
+          ::BIGNUM* R = ::BN_CTX_get(context);
+          ::BIGNUM* verification = ::BN_CTX_get(context);
+
+          if (verification == nullptr)
+            return (0);
+
+          // The exponentiation modulo a prime, the input being reduced in
+          // constant time as OpenSSL does, the prime being secret.
+          auto exponentiate =
+            [&] (::BIGNUM* result,
+                 ::BIGNUM const* exponent,
+                 ::BIGNUM const* prime)
+            {
+              ::BIGNUM local;
+
+              ::BN_init(&local);
+              BN_with_flags(&local, prime, BN_FLG_CONSTTIME);
+
+              return ((::BN_mod(c, I, &local, context) != 0) &&
+                      (::BN_mod_exp_mont_consttime(
+                         result, c, exponent, prime, context, nullptr) != 0));
+            };
+
+          // m_2 = c^dQ mod q, m_1 = c^dP mod p, h = (m_1 - m_2) * qInv mod p
+          // and m = m_2 + q * h.
+          if (!exponentiate(m, rsa->dmq1, rsa->q) ||
+              !exponentiate(h, rsa->dmp1, rsa->p) ||
+              (::BN_mod_sub(h, h, m, rsa->p, context) == 0) ||
+              (::BN_mod_mul(h, h, rsa->iqmp, rsa->p, context) == 0) ||
+              (::BN_mul(r0, rsa->q, h, context) == 0) ||
+              (::BN_add(r0, r0, m) == 0) ||
+              (::BN_mul(R, rsa->p, rsa->q, context) == 0))
+            return (0);
+
+          // For every additional prime r_i: m_i = c^d_i mod r_i,
+          // h = (m_i - m) * t_i mod r_i, m = m + R * h and R = R * r_i.
+          for (auto const& other: *others)
+          {
+            if (!exponentiate(m, other.exponent.get(), other.prime.get()) ||
+                (::BN_mod_sub(h, m, r0, other.prime.get(), context) == 0) ||
+                (::BN_mod_mul(h, h, other.coefficient.get(),
+                              other.prime.get(), context) == 0) ||
+                (::BN_mul(h, R, h, context) == 0) ||
+                (::BN_add(r0, r0, h) == 0) ||
+                (::BN_mul(R, R, other.prime.get(), context) == 0))
+              return (0);
+          }
+
+          // Verify the result so as not to leak the primes should a fault
+          // have occured, falling back to the plain exponentiation.
+          if ((::BN_mod_exp(verification, r0, rsa->e, rsa->n, context) == 0) ||
+              (::BN_mod(c, I, rsa->n, context) == 0))
+            return (0);
+
+          if (::BN_cmp(verification, c) != 0)
+          {
+            ELLE_WARN("the multi-prime exponentiation is invalid, fall back "
+                      "to the plain one");
+
+            // As the exponentiations above, run in constant time so as not
+            // to leak the private exponent.
+            return (::BN_mod_exp_mont_consttime(
+                      r0, c, rsa->d, rsa->n, context, nullptr));
+          }
+
+          return (1);
+        }
+
+        /// Return the RSA method relying on the additional primes.
+        static
+        ::RSA_METHOD const*
+        _method()
+        {
+          static ::RSA_METHOD const method = []
+            {
+              ::RSA_METHOD method = *::RSA_PKCS1_SSLeay();
+
+              method.name = "infinit multi-prime RSA";
+              method.rsa_mod_exp = _mod_exp;
+
+              return (method);
+            }();
+
+          return (&method);
+        }
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        Primes const*
+        primes(::RSA* rsa)
+        {
+          ELLE_ASSERT_NEQ(rsa, nullptr);
+
+          return (static_cast<Primes const*>(
+                    ::RSA_get_ex_data(rsa, _index())));
+        }
+
+        void
+        attach(::RSA* rsa,
+               Primes primes)
+        {
+          ELLE_ASSERT_NEQ(rsa, nullptr);
+          ELLE_ASSERT(!primes.empty());
+          ELLE_ASSERT_EQ(multiprime::primes(rsa), nullptr);
+
+          std::unique_ptr<Primes> _primes(new Primes(std::move(primes)));
+
+          if (::RSA_set_ex_data(rsa, _index(), _primes.get()) == 0)
+            throw Error(
+              elle::sprintf("unable to attach the additional primes: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          _primes.release();
+
+          if (::RSA_set_method(rsa, _method()) == 0)
+            throw Error(
+              elle::sprintf("unable to set the multi-prime RSA method: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+        }
+
+        /// Return the maximum number of primes for a key of the given
+        /// length, as recommended by OpenSSL.
+        static
+        uint32_t
+        _capacity(uint32_t const length)
+        {
+          if (length < 1024)
+            return (2);
+          else if (length < 4096)
+            return (3);
+          else if (length < 8192)
+            return (4);
+          else
+            return (5);
+        }
+
+        /// The callback given to BN_generate_prime_ex() aborting the
+        /// generation should the task running it be cancelled.
+        static
+        int
+        _progress(int,
+                  int,
+                  ::BN_GENCB*)
+        {
+          return (cancellation::requested() ? 0 : 1);
+        }
+
+        ::RSA*
+        generate(uint32_t const length,
+                 uint32_t const count)
+        {
+          if ((count < 2) || (count > _capacity(length)))
+            throw Error(
+              elle::sprintf("invalid number of primes %s for a %s-bit key, "
+                            "at most %s are supported",
+                            count, length, _capacity(length)));
+
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+
+          ::BN_CTX* context = ::BN_CTX_new();
+
+          if (context == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate a BN context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_BN_CTX(context);
+
+          auto allocate = [] ()
+            {
+              types::BIGNUM bn(::BN_new());
+
+              if (bn == nullptr)
+                throw Error(
+                  elle::sprintf("unable to allocate a big number: %s",
+                                ::ERR_error_string(ERR_get_error(),
+                                                   nullptr)));
+
+              return (bn);
+            };
+          auto check = [] (int const result)
+            {
+              if (result == 0)
+                throw Error(
+                  elle::sprintf("unable to compute the RSA key "
+                                "components: %s",
+                                ::ERR_error_string(ERR_get_error(),
+                                                   nullptr)));
+            };
+
+          types::BIGNUM e = allocate();
+          check(::BN_set_word(e.get(), RSA_F4));
+
+          ::BN_GENCB callback;
+          BN_GENCB_set(&callback, _progress, nullptr);
+
+          std::vector<types::BIGNUM> factors;
+          types::BIGNUM n = allocate();
+          types::BIGNUM p1 = allocate();
+          types::BIGNUM inverse = allocate();
+
+          // Generate the primes until their product has the requested
+          // length, the primes being distinct and such that r_i - 1 be
+          // coprime with the exponent.
+          do
+          {
+            factors.clear();
+            check(::BN_one(n.get()));
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+              int const bits = length / count + (i < length % count ? 1 : 0);
+              types::BIGNUM prime = allocate();
+
+              while (true)
+              {
+                if (::BN_generate_prime_ex(prime.get(), bits, 0,
+                                           nullptr, nullptr,
+                                           &callback) == 0)
+                  throw Error(
+                    elle::sprintf("unable to generate a prime: %s",
+                                  ::ERR_error_string(ERR_get_error(),
+                                                     nullptr)));
+
+                // Handle the secret prime in constant time, checking that
+                // r - 1 be coprime with the exponent through the existence
+                // of an inverse, see the parallel generation in KeyPair.cc.
+                BN_set_flags(prime.get(), BN_FLG_CONSTTIME);
+
+                check(::BN_sub(p1.get(), prime.get(), ::BN_value_one()));
+
+                BN_set_flags(p1.get(), BN_FLG_CONSTTIME);
+
+                ::ERR_set_mark();
+
+                bool coprime =
+                  ::BN_mod_inverse(inverse.get(), p1.get(), e.get(),
+                                   context) != nullptr;
+
+                if (!coprime)
+                {
+                  unsigned long error = ::ERR_peek_last_error();
+
+                  if ((ERR_GET_LIB(error) != ERR_LIB_BN) ||
+                      (ERR_GET_REASON(error) != BN_R_NO_INVERSE))
+                    throw Error(
+                      elle::sprintf("unable to check the prime: %s",
+                                    ::ERR_error_string(ERR_get_error(),
+                                                       nullptr)));
+
+                  ::ERR_pop_to_mark();
+                }
+
+                bool distinct = true;
+                for (auto const& factor: factors)
+                  if (::BN_cmp(factor.get(), prime.get()) == 0)
+                    distinct = false;
+
+                if (coprime && distinct)
+                  break;
+              }
+
+              check(::BN_mul(n.get(), n.get(), prime.get(), context));
+              factors.push_back(std::move(prime));
+            }
+          } while (::BN_num_bits(n.get()) != static_cast<int>(length));
+
+          // d = e^-1 mod phi with phi = (r_1 - 1) * ... * (r_u - 1).
+          types::BIGNUM phi = allocate();
+          types::BIGNUM r1 = allocate();
+
+          BN_set_flags(phi.get(), BN_FLG_CONSTTIME);
+          BN_set_flags(r1.get(), BN_FLG_CONSTTIME);
+
+          check(::BN_one(phi.get()));
+          for (auto const& factor: factors)
+          {
+            check(::BN_sub(r1.get(), factor.get(), ::BN_value_one()));
+            check(::BN_mul(phi.get(), phi.get(), r1.get(), context));
+          }
+
+          types::BIGNUM d(::BN_mod_inverse(nullptr, e.get(), phi.get(),
+                                           context));
+          check(d != nullptr);
+
+          BN_set_flags(d.get(), BN_FLG_CONSTTIME);
+
+          // Compute the CRT exponent d mod (r - 1).
+          auto exponent = [&] (::BIGNUM const* prime)
+            {
+              types::BIGNUM result = allocate();
+
+              check(::BN_sub(r1.get(), prime, ::BN_value_one()));
+              check(::BN_mod(result.get(), d.get(), r1.get(), context));
+
+              return (result);
+            };
+
+          ::RSA* rsa = ::RSA_new();
+
+          if (rsa == nullptr)
+            throw Error(
+              elle::sprintf("unable to allocate the RSA key: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ACTION_FREE_RSA(rsa);
+
+          rsa->dmp1 = exponent(factors[0].get()).release();
+          rsa->dmq1 = exponent(factors[1].get()).release();
+          rsa->iqmp = ::BN_mod_inverse(nullptr, factors[1].get(),
+                                       factors[0].get(), context);
+          check(rsa->iqmp != nullptr);
+
+          // The additional primes' exponents and coefficients, R being the
+          // product of the preceding primes.
+          Primes others;
+          types::BIGNUM R = allocate();
+
+          BN_set_flags(R.get(), BN_FLG_CONSTTIME);
+
+          check(::BN_mul(R.get(), factors[0].get(), factors[1].get(),
+                         context));
+
+          for (uint32_t i = 2; i < count; ++i)
+          {
+            Prime other;
+
+            other.exponent = exponent(factors[i].get());
+            other.coefficient.reset(
+              ::BN_mod_inverse(nullptr, R.get(), factors[i].get(), context));
+            check(other.coefficient != nullptr);
+            check(::BN_mul(R.get(), R.get(), factors[i].get(), context));
+            other.prime = std::move(factors[i]);
+
+            others.push_back(std::move(other));
+          }
+
+          rsa->n = n.release();
+          rsa->e = e.release();
+          rsa->d = d.release();
+          rsa->p = factors[0].release();
+          rsa->q = factors[1].release();
+
+          if (!others.empty())
+            attach(rsa, std::move(others));
+
+          INFINIT_CRYPTOGRAPHY_FINALLY_ABORT(rsa);
+
+          return (rsa);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef INFINIT_CRYPTOGRAPHY_RSA_MULTIPRIME_HH
+# define INFINIT_CRYPTOGRAPHY_RSA_MULTIPRIME_HH
+
+# include <vector>
+
+# include <elle/types.hh>
+
+# include <cryptography/types.hh>
+
+# include <openssl/rsa.h>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Multi-prime RSA keys, see RFC 8017, whose modulus is the product of
+      /// more than two primes, making the private operations faster since
+      /// every CRT exponentiation is performed on a smaller modulus.
+      ///
+      /// Such keys are represented by a regular RSA structure whose p, q,
+      /// dmp1, dmq1 and iqmp hold the first two primes' components, the
+      /// additional primes being attached to the structure and used by a
+      /// dedicated RSA method. Note that the public key is unaffected.
+      namespace multiprime
+      {
+        /*--------.
+        | Structs |
+        `--------*/
+
+        /// An additional prime along with its CRT exponent and coefficient,
+        /// i.e the OtherPrimeInfo structure of RFC 8017.
+        struct Prime
+        {
+          /// The prime r_i.
+          types::BIGNUM prime;
+          /// The exponent d mod (r_i - 1).
+          types::BIGNUM exponent;
+          /// The coefficient (r_1 * ... * r_(i-1))^-1 mod r_i.
+          types::BIGNUM coefficient;
+        };
+
+        typedef std::vector<Prime> Primes;
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Return the additional primes of the given key, null being
+        /// returned for a regular two-prime key.
+        Primes const*
+        primes(::RSA* rsa);
+        /// Attach the given additional primes to the key, which takes
+        /// ownership of them, making the private operations rely on them.
+        void
+        attach(::RSA* rsa,
+               Primes primes);
+        /// Generate a RSA key of the given length whose modulus is the
+        /// product of the given number of primes.
+        ///
+        /// Note that the length is in bits.
+        ::RSA*
+        generate(uint32_t const length,
+                 uint32_t const count);
+      }
+    }
+  }
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <cryptography/rsa/pem.hh>
 #include <cryptography/rsa/PublicKey.hh>
 #include <cryptography/rsa/PrivateKey.hh>
+#include <cryptography/rsa/multiprime.hh>
 #include <cryptography/Error.hh>
 #include <cryptography/finally.hh>
 #include <cryptography/cryptography.hh>
@@ -86,6 +87,10 @@ namespace infinit
                  Cipher const& cipher,
                  Mode const& mode)
         {
+          // OpenSSL would only export the first two primes.
+          if (multiprime::primes(k.key()->pkey.rsa) != nullptr)
+            throw Error("unable to export a multi-prime RSA key in PEM");
+
           cryptography::pem::export_private(k.key().get(),
                                             path,
                                             passphrase,
@@ -0,0 +1,326 @@
+#include <cryptography/rsa/session.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <elle/IOStream.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <cryptography/Error.hh>
+#include <cryptography/io.hh>
+#include <cryptography/random.hh>
+#include <cryptography/rsa/Padding.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.rsa.session");
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace session
+      {
+        /*----------.
+        | Constants |
+        `----------*/
+
+        /// The magic number every message starts with.
+        static char const _magic[8] =
+          {'\x89', 'I', 'S', 'E', 'S', '\r', '\n', '\x1a'};
+        /// The type of the message starting a session, carrying the wrapped
+        /// secret.
+        static uint8_t const _opening = 1;
+        /// The type of the messages referencing an existing session.
+        static uint8_t const _continuation = 2;
+        /// The size of the session identifiers, in bytes.
+        static uint32_t const _identifier_size = 16;
+        /// The size of the session secrets, in bytes.
+        static uint32_t const _secret_size = 32;
+
+        /*-------------.
+        | Construction |
+        `-------------*/
+
+        Rotation::Rotation(uint32_t const messages,
+                           std::chrono::seconds const period):
+          messages(messages),
+          period(period)
+        {
+          if (this->messages == 0)
+            throw Error("a session must be used for one message at least");
+
+          if ((this->period.count() < 0) ||
+              (this->period.count() > 0xffffffff))
+            throw Error(
+              elle::sprintf("invalid session period %s",
+                            this->period.count()));
+        }
+
+        /*-------------.
+        | Construction |
+        `-------------*/
+
+        Sealer::Sealer(PublicKey K,
+                       Rotation const& rotation,
+                       Cipher const cipher,
+                       Mode const mode):
+          _K(std::move(K)),
+          _rotation(rotation),
+          _cipher(cipher),
+          _mode(mode),
+          _messages(0)
+        {}
+
+        /*--------.
+        | Methods |
+        `--------*/
+
+        elle::Buffer
+        Sealer::seal(elle::ConstWeakBuffer const& plain)
+        {
+          elle::IOStream _plain(plain.istreambuf());
+          std::stringstream _code;
+
+          this->seal(_plain, _code);
+
+          return (elle::Buffer(_code.str().data(), _code.str().length()));
+        }
+
+        void
+        Sealer::seal(std::istream& plain,
+                     std::ostream& code)
+        {
+          // Keep the lock while sealing so that the session's first message
+          // be written before the messages referencing it.
+          std::lock_guard<std::mutex> lock(this->_mutex);
+
+          auto now = std::chrono::steady_clock::now();
+
+          if (this->_identifier.empty() ||
+              (this->_messages >= this->_rotation.messages) ||
+              (now >= this->_expiration))
+          {
+            elle::Buffer secret =
+              random::generate<elle::Buffer>(_secret_size);
+            elle::Buffer identifier =
+              random::generate<elle::Buffer>(_identifier_size);
+
+            this->_wrapped = this->_K.encrypt(secret, Padding::oaep);
+            this->_secret.reset(new SecretKey(std::move(secret)));
+            this->_identifier = identifier.string();
+            this->_messages = 0;
+            this->_expiration = now + this->_rotation.period;
+
+            ELLE_DEBUG("%s: start session %x", *this, identifier);
+          }
+
+          io::write(code, _magic, sizeof (_magic), "magic number");
+
+          if (this->_messages == 0)
+          {
+            io::write(code, _opening, 1, "message type");
+            io::write(code,
+                      this->_identifier.data(), this->_identifier.size(),
+                      "session identifier");
+            io::write(code, static_cast<uint32_t>(this->_cipher), 1,
+                      "cipher");
+            io::write(code, static_cast<uint32_t>(this->_mode), 1, "mode");
+            io::write(code,
+                      static_cast<uint32_t>(this->_rotation.period.count()),
+                      4, "session period");
+            io::write(code, this->_wrapped.size(), 2, "secret length");
+            io::write(code,
+                      this->_wrapped.contents(), this->_wrapped.size(),
+                      "secret");
+          }
+          else
+          {
+            io::write(code, _continuation, 1, "message type");
+            io::write(code,
+                      this->_identifier.data(), this->_identifier.size(),
+                      "session identifier");
+          }
+
+          this->_secret->encipher(plain, code, this->_cipher, this->_mode);
+
+          this->_messages++;
+        }
+
+        void
+        Sealer::reset()
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+
+          this->_identifier.clear();
+          this->_secret.reset();
+        }
+
+        /*----------.
+        | Printable |
+        `----------*/
+
+        void
+        Sealer::print(std::ostream& stream) const
+        {
+          stream << "Sealer(" << this->_K << ")";
+        }
+
+        /*-------------.
+        | Construction |
+        `-------------*/
+
+        Opener::Opener(PrivateKey k,
+                       std::size_t const capacity,
+                       std::chrono::seconds const tolerance):
+          _k(std::move(k)),
+          _capacity(capacity),
+          _tolerance(tolerance)
+        {
+          if (this->_capacity == 0)
+            throw Error("an opener must keep one session at least");
+
+          if (this->_tolerance.count() < 0)
+            throw Error("an opener's tolerance cannot be negative");
+        }
+
+        /*--------.
+        | Methods |
+        `--------*/
+
+        elle::Buffer
+        Opener::open(elle::ConstWeakBuffer const& code)
+        {
+          elle::IOStream _code(code.istreambuf());
+          std::stringstream _plain;
+
+          this->open(_code, _plain);
+
+          return (elle::Buffer(_plain.str().data(), _plain.str().length()));
+        }
+
+        void
+        Opener::open(std::istream& code,
+                     std::ostream& plain)
+        {
+          char magic[sizeof (_magic)];
+
+          io::read(code, magic, sizeof (magic), "magic number");
+          if (::memcmp(magic, _magic, sizeof (_magic)) != 0)
+            throw Error("the code is not a session message");
+
+          uint32_t type = io::read(code, 1, "message type");
+          std::string identifier(_identifier_size, '\0');
+
+          io::read(code, &identifier[0], identifier.size(),
+                   "session identifier");
+
+          auto now = std::chrono::steady_clock::now();
+          Session session;
+
+          if (type == _opening)
+          {
+            session.cipher = static_cast<Cipher>(io::read(code, 1, "cipher"));
+            session.mode = static_cast<Mode>(io::read(code, 1, "mode"));
+
+            std::chrono::seconds period(io::read(code, 4, "session period"));
+
+            elle::Buffer wrapped(io::read(code, 2, "secret length"));
+            io::read(code, wrapped.mutable_contents(), wrapped.size(),
+                     "secret");
+
+            // Unwrap the secret outside the critical section, this being
+            // the expensive part.
+            session.secret =
+              std::make_shared<SecretKey>(
+                this->_k.decrypt(wrapped, Padding::oaep));
+            // Expire the session as the sealer does, allowing for the
+            // continuations to be delivered later than the first message.
+            session.expiration = now + period + this->_tolerance;
+
+            std::lock_guard<std::mutex> lock(this->_mutex);
+
+            if (this->_sessions.size() >= this->_capacity)
+            {
+              // Discard the expired sessions, then the oldest one.
+              for (auto iterator = this->_sessions.begin();
+                   iterator != this->_sessions.end();)
+              {
+                if (iterator->second.expiration <= now)
+                  iterator = this->_sessions.erase(iterator);
+                else
+                  ++iterator;
+              }
+
+              if (this->_sessions.size() >= this->_capacity)
+                this->_sessions.erase(
+                  std::min_element(
+                    this->_sessions.begin(),
+                    this->_sessions.end(),
+                    [] (Sessions::value_type const& a,
+                        Sessions::value_type const& b)
+                    {
+                      return (a.second.expiration < b.second.expiration);
+                    }));
+            }
+
+            this->_sessions[identifier] = session;
+          }
+          else if (type == _continuation)
+          {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+
+            auto iterator = this->_sessions.find(identifier);
+
+            if (iterator == this->_sessions.end())
+              throw Error("unknown session, its first message may have "
+                          "been lost or opened by another opener");
+
+            if (iterator->second.expiration <= now)
+            {
+              this->_sessions.erase(iterator);
+
+              throw Error("the session has expired");
+            }
+
+            session = iterator->second;
+          }
+          else
+            throw Error(elle::sprintf("unknown session message type %s",
+                                      type));
+
+          session.secret->decipher(code, plain, session.cipher, session.mode);
+        }
+
+        void
+        Opener::clear()
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+
+          this->_sessions.clear();
+        }
+
+        std::size_t
+        Opener::size() const
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+
+          return (this->_sessions.size());
+        }
+
+        /*----------.
+        | Printable |
+        `----------*/
+
+        void
+        Opener::print(std::ostream& stream) const
+        {
+          stream << "Opener(" << this->_k << ")";
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,210 @@
+#ifndef INFINIT_CRYPTOGRAPHY_RSA_SESSION_HH
+# define INFINIT_CRYPTOGRAPHY_RSA_SESSION_HH
+
+# include <chrono>
+# include <iosfwd>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <unordered_map>
+
+# include <elle/Buffer.hh>
+# include <elle/Printable.hh>
+# include <elle/attribute.hh>
+# include <elle/types.hh>
+
+# include <cryptography/Cipher.hh>
+# include <cryptography/SecretKey.hh>
+# include <cryptography/rsa/PrivateKey.hh>
+# include <cryptography/rsa/PublicKey.hh>
+
+namespace infinit
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Sealing sessions amortize the public key operation of the envelopes
+      /// over many messages sent to the same recipient: a secret is wrapped
+      /// with the recipient's public key once, in the session's first
+      /// message, the following messages only referencing the session
+      /// through its identifier and paying for the symmetric encryption
+      /// only.
+      ///
+      /// Every message is composed of a magic number, the message type,
+      /// the session identifier and, for the first message only, the
+      /// cipher, the mode, the session's period and the wrapped secret,
+      /// followed by the plain enciphered with the session's secret, see
+      /// SecretKey.
+      ///
+      /// Note that the messages must be opened in order, since a message
+      /// referencing a session cannot be opened before the session's first
+      /// message. A sealer can be reset should a message be lost.
+      namespace session
+      {
+        /*--------.
+        | Structs |
+        `--------*/
+
+        /// The limits after which a session is replaced with a new one,
+        /// whichever is reached first.
+        struct Rotation
+        {
+          Rotation(uint32_t const messages = 1024,
+                   std::chrono::seconds const period = std::chrono::hours(1));
+
+          /// The number of messages sealed in a session.
+          uint32_t messages;
+          /// The time during which a session is used.
+          std::chrono::seconds period;
+        };
+
+        /*--------.
+        | Classes |
+        `--------*/
+
+        /// Seal messages for a recipient.
+        class Sealer:
+          public elle::Printable
+        {
+          /*-------------.
+          | Construction |
+          `-------------*/
+        public:
+          Sealer(PublicKey K,
+                 Rotation const& rotation = Rotation(),
+                 Cipher const cipher = SecretKey::defaults::cipher,
+                 Mode const mode = SecretKey::defaults::mode);
+          Sealer(Sealer const&) = delete;
+
+          /*--------.
+          | Methods |
+          `--------*/
+        public:
+          /// Seal the plain and return the message.
+          elle::Buffer
+          seal(elle::ConstWeakBuffer const& plain);
+          /// Seal the plain's input stream, writing the message to the
+          /// code's output stream.
+          void
+          seal(std::istream& plain,
+               std::ostream& code);
+          /// Discard the current session so that the next message start a
+          /// new one.
+          void
+          reset();
+
+          /*----------.
+          | Operators |
+          `----------*/
+        public:
+          Sealer&
+          operator =(Sealer const&) = delete;
+
+          /*----------.
+          | Printable |
+          `----------*/
+        public:
+          void
+          print(std::ostream& stream) const override;
+
+          /*-----------.
+          | Attributes |
+          `-----------*/
+        private:
+          ELLE_ATTRIBUTE_R(PublicKey, K);
+          ELLE_ATTRIBUTE_R(Rotation, rotation);
+          ELLE_ATTRIBUTE_R(Cipher, cipher);
+          ELLE_ATTRIBUTE_R(Mode, mode);
+          /// The current session's identifier, empty if none.
+          ELLE_ATTRIBUTE(std::string, identifier);
+          ELLE_ATTRIBUTE(std::unique_ptr<SecretKey>, secret);
+          /// The session's wrapped secret, sent with the first message.
+          ELLE_ATTRIBUTE(elle::Buffer, wrapped);
+          ELLE_ATTRIBUTE(uint32_t, messages);
+          ELLE_ATTRIBUTE(std::chrono::steady_clock::time_point, expiration);
+          mutable std::mutex _mutex;
+        };
+
+        /// Open the messages sealed for a private key, keeping the sessions
+        /// so that the secret be unwrapped once per session.
+        class Opener:
+          public elle::Printable
+        {
+          /*-------------.
+          | Construction |
+          `-------------*/
+        public:
+          /// Construct an opener keeping at most capacity sessions, the
+          /// least recently started ones being evicted should the capacity
+          /// be reached.
+          ///
+          /// Note that the sealer alone determines the session's length:
+          /// every session is forgotten once the period its first message
+          /// carries elapsed, extended with the given tolerance so that
+          /// the messages sealed near the end of the session but delivered
+          /// later than the first one can still be opened.
+          Opener(PrivateKey k,
+                 std::size_t const capacity = 64,
+                 std::chrono::seconds const tolerance =
+                   std::chrono::minutes(5));
+          Opener(Opener const&) = delete;
+
+          /*--------.
+          | Methods |
+          `--------*/
+        public:
+          /// Open the message and return the plain.
+          elle::Buffer
+          open(elle::ConstWeakBuffer const& code);
+          /// Open the message read from the code's input stream, writing
+          /// the plain to the output stream.
+          void
+          open(std::istream& code,
+               std::ostream& plain);
+          /// Forget every session.
+          void
+          clear();
+          /// Return the number of sessions kept.
+          std::size_t
+          size() const;
+
+          /*----------.
+          | Operators |
+          `----------*/
+        public:
+          Opener&
+          operator =(Opener const&) = delete;
+
+          /*----------.
+          | Printable |
+          `----------*/
+        public:
+          void
+          print(std::ostream& stream) const override;
+
+          /*-----------.
+          | Attributes |
+          `-----------*/
+        private:
+          struct Session
+          {
+            std::shared_ptr<SecretKey> secret;
+            Cipher cipher;
+            Mode mode;
+            std::chrono::steady_clock::time_point expiration;
+          };
+          typedef std::unordered_map<std::string, Session> Sessions;
+
+          ELLE_ATTRIBUTE_R(PrivateKey, k);
+          ELLE_ATTRIBUTE_R(std::size_t, capacity);
+          ELLE_ATTRIBUTE_R(std::chrono::seconds, tolerance);
+          ELLE_ATTRIBUTE(Sessions, sessions);
+          mutable std::mutex _mutex;
+        };
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "cryptography.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <cryptography/Executor.hh>
+#include <cryptography/dh/KeyPair.hh>
+#include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/rsa/KeyPair.hh>
+
+/*-------.
+| Submit |
+`-------*/
+
+static
+void
+test_submit()
+{
+  infinit::cryptography::Executor executor(1);
+
+  // Block the single thread so that the following tasks be queued.
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool release = false;
+  auto blocker = executor.submit(
+    [&]
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&] { return (release); });
+    });
+
+  std::vector<int> order;
+  std::vector<std::future<void>> futures;
+  auto task = [&order] (int const value)
+  {
+    return ([&order, value] { order.push_back(value); });
+  };
+
+  futures.push_back(
+    executor.submit(task(1), infinit::cryptography::Priority::low));
+  futures.push_back(
+    executor.submit(task(2), infinit::cryptography::Priority::normal));
+  futures.push_back(
+    executor.submit(task(3), infinit::cryptography::Priority::high));
+  futures.push_back(
+    executor.submit(task(4), infinit::cryptography::Priority::high));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  condition.notify_one();
+
+  blocker.get();
+  for (auto& future: futures)
+    future.get();
+
+  BOOST_CHECK((order == std::vector<int>{3, 4, 2, 1}));
+
+  // Errors are transmitted through the future.
+  auto failure = executor.submit(
+    []() -> int
+    {
+      throw infinit::cryptography::Error("failure");
+    });
+  BOOST_CHECK_THROW(failure.get(), infinit::cryptography::Error);
+
+  BOOST_CHECK_EQUAL(executor.submit([] { return (42); }).get(), 42);
+}
+
+/*-------.
+| Cancel |
+`-------*/
+
+static
+void
+test_cancel()
+{
+  // Cancelled before starting.
+  {
+    infinit::cryptography::Cancellation cancellation;
+    cancellation.cancel();
+
+    bool executed = false;
+    auto future = infinit::cryptography::executor::generation().submit(
+      [&executed] { executed = true; },
+      infinit::cryptography::Priority::normal,
+      cancellation);
+
+    BOOST_CHECK_THROW(future.get(), infinit::cryptography::Cancelled);
+    BOOST_CHECK(!executed);
+  }
+
+  // Cancelled while generating a key large enough for the cancellation to
+  // be requested before it completes.
+  {
+    infinit::cryptography::Cancellation cancellation;
+    auto future =
+      infinit::cryptography::rsa::keypair::generate_async(
+        8192,
+        infinit::cryptography::Priority::high,
+        cancellation);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cancellation.cancel();
+
+    BOOST_CHECK_THROW(future.get(), infinit::cryptography::Cancelled);
+  }
+}
+
+/*---------.
+| Generate |
+`---------*/
+
+static
+void
+test_generate()
+{
+  auto rsa = infinit::cryptography::rsa::keypair::generate_async(1024);
+  auto dsa = infinit::cryptography::dsa::keypair::generate_async(1024);
+  auto dh = infinit::cryptography::dh::keypair::generate_async(
+    infinit::cryptography::Priority::low);
+
+  BOOST_CHECK_EQUAL(rsa.get().length(), 1024);
+  BOOST_CHECK_EQUAL(dsa.get().length(), 1024);
+  dh.get();
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("Executor");
+
+  suite->add(BOOST_TEST_CASE(test_submit));
+  suite->add(BOOST_TEST_CASE(test_cancel));
+  suite->add(BOOST_TEST_CASE(test_generate));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
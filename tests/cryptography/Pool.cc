@@ -0,0 +1,187 @@
+#include "cryptography.hh"
+
+#include <atomic>
+#include <set>
+#include <thread>
+
+#include <cryptography/Pool.hh>
+#include <cryptography/Queue.hh>
+#include <cryptography/SecretKeyPool.hh>
+#include <cryptography/dh/KeyPool.hh>
+#include <cryptography/dsa/KeyPool.hh>
+#include <cryptography/rsa/KeyPool.hh>
+
+static elle::Buffer const _message("pool party");
+
+/*------.
+| Queue |
+`------*/
+
+static
+void
+test_queue()
+{
+  infinit::cryptography::Queue<int> queue(100);
+
+  BOOST_CHECK_EQUAL(queue.capacity(), 128);
+  BOOST_CHECK(queue.pop() == nullptr);
+
+  // Fill the queue up.
+  for (int i = 0; i < 128; ++i)
+  {
+    std::unique_ptr<int> value(new int(i));
+    BOOST_CHECK(queue.push(value));
+    BOOST_CHECK(value == nullptr);
+  }
+  {
+    std::unique_ptr<int> value(new int(128));
+    BOOST_CHECK(!queue.push(value));
+    BOOST_CHECK(value != nullptr);
+  }
+  for (int i = 0; i < 128; ++i)
+    BOOST_CHECK_EQUAL(*queue.pop(), i);
+  BOOST_CHECK(queue.pop() == nullptr);
+
+  // Concurrent producers and consumers: every value is received once.
+  int const count = 10000;
+  std::atomic<int> received(0);
+  std::vector<std::atomic<int>> seen(4 * count);
+  std::vector<std::thread> threads;
+
+  for (int p = 0; p < 4; ++p)
+    threads.emplace_back(
+      [&, p]
+      {
+        for (int i = 0; i < count; ++i)
+        {
+          std::unique_ptr<int> value(new int(p * count + i));
+          while (!queue.push(value))
+            std::this_thread::yield();
+        }
+      });
+  for (int c = 0; c < 4; ++c)
+    threads.emplace_back(
+      [&]
+      {
+        while (received < 4 * count)
+        {
+          if (auto value = queue.pop())
+          {
+            seen[*value]++;
+            received++;
+          }
+          else
+            std::this_thread::yield();
+        }
+      });
+  for (auto& thread: threads)
+    thread.join();
+
+  for (auto const& s: seen)
+    BOOST_CHECK_EQUAL(s.load(), 1);
+}
+
+/*-----.
+| Pool |
+`-----*/
+
+static
+void
+test_pool()
+{
+  std::atomic<int> counter(0);
+  infinit::cryptography::pool::Configuration configuration;
+  configuration.capacity = 8;
+  configuration.minimum_threads = 1;
+  configuration.maximum_threads = 4;
+  configuration.period = std::chrono::milliseconds(20);
+
+  infinit::cryptography::Pool<int> pool(
+    [&counter]
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      return (counter++);
+    },
+    configuration);
+
+  // Values are never handed out twice.
+  std::set<int> values;
+  for (int i = 0; i < 64; ++i)
+    BOOST_CHECK(values.insert(pool.get()).second);
+
+  auto metrics = pool.metrics();
+  BOOST_CHECK_EQUAL(metrics.hits + metrics.misses, 64);
+  BOOST_CHECK_GE(metrics.threads, 1);
+  BOOST_CHECK_LE(metrics.threads, 4);
+  BOOST_TEST_MESSAGE(metrics);
+}
+
+static
+void
+test_keypool()
+{
+  infinit::cryptography::pool::Configuration configuration;
+  configuration.capacity = 2;
+  configuration.maximum_threads = 2;
+
+  infinit::cryptography::rsa::AdaptiveKeyPool pool(512, configuration);
+
+  for (int i = 0; i < 4; ++i)
+    BOOST_CHECK_EQUAL(pool.get().k().length(), 512);
+}
+
+static
+void
+test_pools()
+{
+  infinit::cryptography::pool::Configuration configuration;
+  configuration.capacity = 2;
+  configuration.maximum_threads = 2;
+
+  {
+    infinit::cryptography::dsa::KeyPool pool(
+      1024, infinit::cryptography::Oneway::sha256, configuration);
+    auto keypair = pool.get();
+    auto signature = keypair.k().sign(_message);
+    BOOST_CHECK(keypair.K().verify(signature, _message));
+  }
+
+  {
+    infinit::cryptography::dh::KeyPool pool(configuration);
+    auto keypair1 = pool.get();
+    auto keypair2 = pool.get();
+    BOOST_CHECK(keypair1.k().agree(keypair2.K()) ==
+                keypair2.k().agree(keypair1.K()));
+  }
+
+  {
+    infinit::cryptography::SecretKeyPool pool(256, configuration);
+    auto key = pool.get();
+    BOOST_CHECK_EQUAL(key.decipher(key.encipher(_message)), _message);
+    BOOST_CHECK(!(pool.get() == key));
+  }
+
+#if defined(INFINIT_CRYPTOGRAPHY_ROTATION)
+  {
+    infinit::cryptography::rsa::SeedPool pool(1024, configuration);
+    auto seed = pool.get();
+    BOOST_CHECK_EQUAL(seed.length(), 1024);
+  }
+#endif
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("Pool");
+
+  suite->add(BOOST_TEST_CASE(test_queue));
+  suite->add(BOOST_TEST_CASE(test_pool));
+  suite->add(BOOST_TEST_CASE(test_keypool));
+  suite->add(BOOST_TEST_CASE(test_pools));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
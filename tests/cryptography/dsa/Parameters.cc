@@ -0,0 +1,136 @@
+#include "../cryptography.hh"
+
+#include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/dsa/KeyPool.hh>
+#include <cryptography/dsa/Parameters.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/random.hh>
+
+#include <elle/serialization/json.hh>
+
+/*---------.
+| Generate |
+`---------*/
+
+static
+void
+test_generate()
+{
+  uint32_t const length = RUNNING_ON_VALGRIND ? 512 : 1024;
+
+  infinit::cryptography::dsa::Parameters parameters =
+    infinit::cryptography::dsa::parameters::generate(length);
+
+  BOOST_CHECK_EQUAL(parameters.length(), length);
+}
+
+/*---------.
+| Standard |
+`---------*/
+
+static
+void
+test_standard()
+{
+  auto parameters1 = infinit::cryptography::dsa::parameters::standard(1024);
+
+  BOOST_CHECK_EQUAL(parameters1.length(), 1024);
+  BOOST_CHECK_EQUAL(parameters1.order(), 160);
+
+  auto parameters2 = infinit::cryptography::dsa::parameters::standard(2048);
+
+  BOOST_CHECK_EQUAL(parameters2.length(), 2048);
+  BOOST_CHECK_EQUAL(parameters2.order(), 256);
+
+  BOOST_CHECK_NE(parameters1, parameters2);
+  BOOST_CHECK_EQUAL(parameters2,
+                    infinit::cryptography::dsa::parameters::standard(2048));
+
+  BOOST_CHECK_THROW(infinit::cryptography::dsa::parameters::standard(3072),
+                    infinit::cryptography::Error);
+}
+
+/*-------.
+| Shared |
+`-------*/
+
+static
+void
+test_shared()
+{
+  auto parameters = infinit::cryptography::dsa::parameters::standard(2048);
+
+  auto keypair1 = infinit::cryptography::dsa::keypair::generate(parameters);
+  auto keypair2 =
+    infinit::cryptography::dsa::keypair::generate_async(parameters).get();
+
+  BOOST_CHECK_NE(keypair1, keypair2);
+  BOOST_CHECK_EQUAL(keypair1.length(), 2048);
+
+  // The key pairs share the parameters.
+  BOOST_CHECK_EQUAL(::EVP_PKEY_cmp_parameters(keypair1.k().key().get(),
+                                              parameters.key().get()), 1);
+  BOOST_CHECK_EQUAL(::EVP_PKEY_cmp_parameters(keypair2.K().key().get(),
+                                              parameters.key().get()), 1);
+
+  elle::Buffer plain =
+    infinit::cryptography::random::generate<elle::Buffer>(512);
+  elle::Buffer signature = keypair1.k().sign(plain);
+
+  BOOST_CHECK(keypair1.K().verify(signature, plain));
+  BOOST_CHECK(!keypair2.K().verify(signature, plain));
+
+  // Pool of key pairs sharing the parameters.
+  infinit::cryptography::dsa::KeyPool pool(parameters);
+  auto keypair3 = pool.get();
+
+  BOOST_CHECK_EQUAL(::EVP_PKEY_cmp_parameters(keypair3.k().key().get(),
+                                              parameters.key().get()), 1);
+}
+
+/*----------.
+| Serialize |
+`----------*/
+
+static
+void
+test_serialize()
+{
+  auto parameters1 = infinit::cryptography::dsa::parameters::standard(1024);
+
+  std::stringstream stream;
+  {
+    typename elle::serialization::json::SerializerOut output(stream);
+    parameters1.serialize(output);
+  }
+
+  typename elle::serialization::json::SerializerIn input(stream);
+  infinit::cryptography::dsa::Parameters parameters2(input);
+
+  BOOST_CHECK_EQUAL(parameters1, parameters2);
+
+  // Copy.
+  infinit::cryptography::dsa::Parameters parameters3(parameters2);
+
+  BOOST_CHECK_EQUAL(parameters1, parameters3);
+
+  auto keypair = infinit::cryptography::dsa::keypair::generate(parameters3);
+
+  BOOST_CHECK_EQUAL(keypair.length(), 1024);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("dsa/Parameters");
+
+  suite->add(BOOST_TEST_CASE(test_generate));
+  suite->add(BOOST_TEST_CASE(test_standard));
+  suite->add(BOOST_TEST_CASE(test_shared));
+  suite->add(BOOST_TEST_CASE(test_serialize));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
@@ -3,10 +3,16 @@
 #include <cryptography/dsa/PrivateKey.hh>
 #include <cryptography/dsa/PublicKey.hh>
 #include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/dsa/Parameters.hh>
 
 #include <elle/printf.hh>
 #include <elle/serialization/json.hh>
 
+#include <openssl/crypto.h>
+#include <openssl/dsa.h>
+
+#include <set>
+
 /*----------.
 | Represent |
 `----------*/
@@ -143,6 +149,69 @@ test_serialize()
   }
 }
 
+/*------------.
+| Precompute |
+`------------*/
+
+static
+void
+test_precompute()
+{
+  infinit::cryptography::dsa::KeyPair keypair =
+    infinit::cryptography::dsa::keypair::generate(
+      infinit::cryptography::dsa::parameters::standard(2048));
+
+  infinit::cryptography::dsa::PrivateKey k(keypair.k());
+
+  k.precompute();
+
+  elle::ConstWeakBuffer plain("token", 5);
+
+  // Sign more than the pool holds so that both the precomputed nonces
+  // and the ones generated on the caller's behalf are exercised.
+  std::vector<elle::Buffer> signatures;
+
+  for (uint32_t i = 0; i < 128; i++)
+  {
+    elle::Buffer signature = k.sign(plain);
+
+    BOOST_CHECK_EQUAL(keypair.K().verify(signature, plain), true);
+
+    signatures.push_back(std::move(signature));
+  }
+
+  // Every nonce being used once, no two signatures should share their r.
+  std::set<std::string> rs;
+
+  for (auto const& signature: signatures)
+  {
+    unsigned char const* buffer = signature.contents();
+    ::DSA_SIG* _signature = ::d2i_DSA_SIG(nullptr, &buffer, signature.size());
+
+    BOOST_REQUIRE(_signature != nullptr);
+
+    char* r = ::BN_bn2hex(_signature->r);
+
+    BOOST_REQUIRE(r != nullptr);
+    BOOST_CHECK(rs.insert(r).second);
+
+    ::OPENSSL_free(r);
+    ::DSA_SIG_free(_signature);
+  }
+
+  BOOST_CHECK_EQUAL(rs.size(), signatures.size());
+
+  // A copy does not inherit the precomputation but signs all the same.
+  infinit::cryptography::dsa::PrivateKey copy(k);
+
+  BOOST_CHECK_EQUAL(keypair.K().verify(copy.sign(plain), plain), true);
+
+  // A moved key carries the precomputation along.
+  infinit::cryptography::dsa::PrivateKey moved(std::move(k));
+
+  BOOST_CHECK_EQUAL(keypair.K().verify(moved.sign(plain), plain), true);
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -156,6 +225,7 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_construct));
   suite->add(BOOST_TEST_CASE(test_compare));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_precompute));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
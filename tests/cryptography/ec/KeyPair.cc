@@ -0,0 +1,364 @@
+#include "../cryptography.hh"
+
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/ec/PublicKey.hh>
+#include <cryptography/ec/PrivateKey.hh>
+#include <cryptography/ec/pem.hh>
+#include <cryptography/Oneway.hh>
+#include <cryptography/Cipher.hh>
+#include <cryptography/Error.hh>
+#include <cryptography/random.hh>
+
+#include <elle/printf.hh>
+#include <elle/types.hh>
+#include <elle/filesystem/TemporaryFile.hh>
+#include <elle/serialization/json.hh>
+
+ELLE_LOG_COMPONENT("infinit.cryptography.test");
+
+/*---------.
+| Generate |
+`---------*/
+
+static
+infinit::cryptography::ec::KeyPair
+_test_generate(infinit::cryptography::ec::Curve const curve,
+               infinit::cryptography::Oneway const digest_algorithm)
+{
+  infinit::cryptography::ec::KeyPair keypair =
+    infinit::cryptography::ec::keypair::generate(curve,
+                                                 digest_algorithm);
+
+  return (keypair);
+}
+
+static
+void
+test_generate()
+{
+  {
+    auto keypair = _test_generate(infinit::cryptography::ec::Curve::p256,
+                                  infinit::cryptography::Oneway::sha256);
+
+    BOOST_CHECK_EQUAL(keypair.K().curve(),
+                      infinit::cryptography::ec::Curve::p256);
+    BOOST_CHECK_EQUAL(keypair.k().curve(),
+                      infinit::cryptography::ec::Curve::p256);
+    BOOST_CHECK_EQUAL(keypair.length(), 256);
+  }
+
+  {
+    auto keypair = _test_generate(infinit::cryptography::ec::Curve::p384,
+                                  infinit::cryptography::Oneway::sha384);
+
+    BOOST_CHECK_EQUAL(keypair.K().curve(),
+                      infinit::cryptography::ec::Curve::p384);
+    BOOST_CHECK_EQUAL(keypair.length(), 384);
+  }
+
+  {
+    auto keypair = infinit::cryptography::ec::keypair::generate_async().get();
+
+    BOOST_CHECK_EQUAL(keypair.K().curve(),
+                      infinit::cryptography::ec::defaults::curve);
+  }
+}
+
+/*----------.
+| Construct |
+`----------*/
+
+static
+void
+test_construct()
+{
+  infinit::cryptography::ec::KeyPair keypair1 =
+    _test_generate(infinit::cryptography::ec::Curve::p256,
+                   infinit::cryptography::Oneway::sha256);
+
+  // KeyPair copy.
+  infinit::cryptography::ec::KeyPair keypair2(keypair1);
+
+  BOOST_CHECK_EQUAL(keypair1, keypair2);
+
+  // KeyPair move.
+  infinit::cryptography::ec::KeyPair keypair3(std::move(keypair1));
+
+  BOOST_CHECK_EQUAL(keypair2, keypair3);
+
+  // Attributes copy.
+  infinit::cryptography::ec::KeyPair keypair4(keypair2.K(), keypair2.k());
+
+  BOOST_CHECK_EQUAL(keypair2, keypair4);
+
+  // Attributes move.
+  infinit::cryptography::ec::PublicKey K(keypair3.K());
+  infinit::cryptography::ec::PrivateKey k(keypair3.k());
+
+  infinit::cryptography::ec::KeyPair keypair5(std::move(K), std::move(k));
+
+  BOOST_CHECK_EQUAL(keypair2, keypair5);
+  BOOST_CHECK_EQUAL(keypair4, keypair5);
+}
+
+/*--------.
+| Operate |
+`--------*/
+
+static
+void
+_test_operate(infinit::cryptography::ec::KeyPair const& keypair)
+{
+  // Sign a plain text.
+  {
+    elle::Buffer input =
+      infinit::cryptography::random::generate<elle::Buffer>(1493);
+    elle::Buffer signature = keypair.k().sign(input);
+
+    BOOST_CHECK_LE(signature.size(), keypair.k().size());
+    BOOST_CHECK_EQUAL(keypair.K().verify(signature, input), true);
+
+    input.mutable_contents()[0] ^= 0x01;
+
+    BOOST_CHECK_EQUAL(keypair.K().verify(signature, input), false);
+  }
+}
+
+static
+void
+test_operate()
+{
+  for (auto curve: {infinit::cryptography::ec::Curve::p256,
+                    infinit::cryptography::ec::Curve::p384})
+  {
+    infinit::cryptography::ec::KeyPair keypair =
+      _test_generate(curve,
+                     infinit::cryptography::Oneway::sha256);
+
+    _test_operate(keypair);
+  }
+}
+
+/*------.
+| Agree |
+`------*/
+
+static
+void
+test_agree()
+{
+  for (auto curve: {infinit::cryptography::ec::Curve::p256,
+                    infinit::cryptography::ec::Curve::p384})
+  {
+    auto keypair1 = infinit::cryptography::ec::keypair::generate(curve);
+    auto keypair2 = infinit::cryptography::ec::keypair::generate(curve);
+    auto keypair3 = infinit::cryptography::ec::keypair::generate(curve);
+
+    infinit::cryptography::SecretKey secret1 =
+      keypair1.k().agree(keypair2.K());
+    infinit::cryptography::SecretKey secret2 =
+      keypair2.k().agree(keypair1.K());
+    infinit::cryptography::SecretKey secret3 =
+      keypair1.k().agree(keypair3.K());
+
+    BOOST_CHECK_EQUAL(secret1, secret2);
+    BOOST_CHECK_NE(secret1, secret3);
+  }
+
+  // The keys must be defined over the same curve.
+  {
+    auto keypair1 = infinit::cryptography::ec::keypair::generate(
+      infinit::cryptography::ec::Curve::p256);
+    auto keypair2 = infinit::cryptography::ec::keypair::generate(
+      infinit::cryptography::ec::Curve::p384);
+
+    BOOST_CHECK_THROW(keypair1.k().agree(keypair2.K()),
+                      infinit::cryptography::Error);
+  }
+}
+
+/*-----.
+| Seal |
+`-----*/
+
+static
+void
+test_seal()
+{
+  for (auto curve: {infinit::cryptography::ec::Curve::p256,
+                    infinit::cryptography::ec::Curve::p384})
+  {
+    auto keypair = infinit::cryptography::ec::keypair::generate(curve);
+
+    // Small and chunked plain texts.
+    for (auto size: {0, 1, 117, 65536, 3 * 65536 + 17})
+    {
+      elle::Buffer plain =
+        infinit::cryptography::random::generate<elle::Buffer>(size);
+      elle::Buffer code = keypair.K().seal(plain);
+
+      BOOST_CHECK_EQUAL(keypair.k().open(code), plain);
+    }
+
+    // Every envelope relies on a fresh ephemeral key.
+    elle::Buffer plain =
+      infinit::cryptography::random::generate<elle::Buffer>(64);
+    elle::Buffer code1 = keypair.K().seal(plain);
+    elle::Buffer code2 = keypair.K().seal(plain);
+
+    BOOST_CHECK_NE(code1, code2);
+    if (curve == infinit::cryptography::ec::Curve::p256)
+      BOOST_CHECK_EQUAL(code1.size(), plain.size() + 51);
+
+    // The envelope is authenticated.
+    code1.mutable_contents()[code1.size() - 1] ^= 0x01;
+    BOOST_CHECK_THROW(keypair.k().open(code1),
+                      infinit::cryptography::Error);
+
+    // Only the recipient can open it.
+    auto other = infinit::cryptography::ec::keypair::generate(curve);
+
+    BOOST_CHECK_THROW(other.k().open(code2),
+                      infinit::cryptography::Error);
+  }
+}
+
+/*--------.
+| Signing |
+`--------*/
+
+class Signed
+{
+public:
+  Signed(int i, int j)
+    : _i(i)
+    , _j(j)
+  {}
+
+  void
+  serialize(elle::serialization::Serializer& s, elle::Version const& v)
+  {
+    s.serialize("i", this->_i);
+    if (v >= elle::Version(0, 1, 0))
+      s.serialize("j", this->_j);
+  }
+
+  ELLE_ATTRIBUTE_R(int, i);
+  ELLE_ATTRIBUTE_R(int, j);
+
+  struct serialization_tag {
+    static elle::Version version;
+  };
+};
+
+elle::Version Signed::serialization_tag::version{0,1,0};
+
+static
+void
+test_signing()
+{
+  Signed s(1, 2);
+  Signed s2(1, 3);
+  infinit::cryptography::ec::KeyPair keys =
+    infinit::cryptography::ec::keypair::generate();
+  ELLE_LOG("sign with legacy version")
+  {
+    auto signature = keys.k().sign(s, elle::Version(0, 0, 0));
+    BOOST_CHECK(keys.K().verify(signature, s));
+    BOOST_CHECK(keys.K().verify(signature, s2));
+  }
+  ELLE_LOG("sign with new version")
+  {
+    auto signature = keys.k().sign(s);
+    BOOST_CHECK(keys.K().verify(signature, s));
+    BOOST_CHECK(!keys.K().verify(signature, s2));
+  }
+}
+
+/*----------.
+| Serialize |
+`----------*/
+
+static
+void
+test_serialize()
+{
+  infinit::cryptography::ec::KeyPair keypair1 =
+    _test_generate(infinit::cryptography::ec::Curve::p384,
+                   infinit::cryptography::Oneway::sha512);
+
+  std::stringstream stream;
+  {
+    typename elle::serialization::json::SerializerOut output(stream);
+    keypair1.serialize(output);
+  }
+
+  typename elle::serialization::json::SerializerIn input(stream);
+  infinit::cryptography::ec::KeyPair keypair2(input);
+
+  BOOST_CHECK_EQUAL(keypair1, keypair2);
+  BOOST_CHECK_EQUAL(keypair2.K().curve(),
+                    infinit::cryptography::ec::Curve::p384);
+  BOOST_CHECK_EQUAL(keypair2.K().digest_algorithm(),
+                    infinit::cryptography::Oneway::sha512);
+
+  _test_operate(keypair2);
+}
+
+/*----.
+| PEM |
+`----*/
+
+static
+void
+test_pem()
+{
+  infinit::cryptography::ec::KeyPair keypair =
+    infinit::cryptography::ec::keypair::generate();
+
+  elle::filesystem::TemporaryFile path("path");
+
+  std::string const passphrase = "Dave";
+
+  infinit::cryptography::ec::pem::export_keypair(
+    keypair,
+    path.path(),
+    passphrase,
+    infinit::cryptography::Cipher::aes256,
+    infinit::cryptography::Mode::cbc);
+
+  BOOST_CHECK_THROW(
+    infinit::cryptography::ec::pem::import_k(path.path(),
+                                             "wrong passphrase"),
+    infinit::cryptography::Error);
+
+  infinit::cryptography::ec::PrivateKey k =
+    infinit::cryptography::ec::pem::import_k(path.path(),
+                                             passphrase);
+
+  BOOST_CHECK_EQUAL(keypair.k(), k);
+
+  infinit::cryptography::ec::PublicKey K(k);
+
+  BOOST_CHECK_EQUAL(keypair.K(), K);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("ec/KeyPair");
+
+  suite->add(BOOST_TEST_CASE(test_generate));
+  suite->add(BOOST_TEST_CASE(test_construct));
+  suite->add(BOOST_TEST_CASE(test_operate));
+  suite->add(BOOST_TEST_CASE(test_agree));
+  suite->add(BOOST_TEST_CASE(test_seal));
+  suite->add(BOOST_TEST_CASE(test_signing));
+  suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_pem));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
@@ -0,0 +1,180 @@
+#include "../cryptography.hh"
+
+#include <chrono>
+#include <functional>
+
+#include <cryptography/random.hh>
+#include <cryptography/dh/KeyPair.hh>
+#include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/rsa/KeyPair.hh>
+
+#include <elle/printf.hh>
+
+/*----------.
+| Utilities |
+`----------*/
+
+static uint32_t const _iterations = RUNNING_ON_VALGRIND ? 2 : 100;
+
+/// Return the average duration of the operation, in microseconds.
+static
+double
+_measure(std::function<void ()> const& operation)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t i = 0; i < _iterations; ++i)
+    operation();
+
+  std::chrono::duration<double, std::micro> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  return (elapsed.count() / _iterations);
+}
+
+/// Measure and report the signature and verification of the plain with
+/// the given key pair.
+template <typename K>
+static
+void
+_benchmark(std::string const& name,
+           K const& keypair,
+           elle::ConstWeakBuffer const& plain)
+{
+  elle::Buffer signature = keypair.k().sign(plain);
+
+  BOOST_CHECK(keypair.K().verify(signature, plain));
+
+  double sign = _measure([&] { keypair.k().sign(plain); });
+  double verify = _measure([&] { keypair.K().verify(signature, plain); });
+
+  elle::printf("[benchmark] %-12s sign: %10.1fus verify: %10.1fus "
+               "signature: %s bytes\n",
+               name, sign, verify, signature.size());
+}
+
+/*-----------.
+| Signatures |
+`-----------*/
+
+static
+void
+test_signatures()
+{
+  elle::Buffer plain =
+    infinit::cryptography::random::generate<elle::Buffer>(1024);
+
+  _benchmark("ECDSA P-256",
+             infinit::cryptography::ec::keypair::generate(
+               infinit::cryptography::ec::Curve::p256),
+             plain);
+  _benchmark("ECDSA P-384",
+             infinit::cryptography::ec::keypair::generate(
+               infinit::cryptography::ec::Curve::p384),
+             plain);
+  _benchmark("RSA 2048",
+             infinit::cryptography::rsa::keypair::generate(2048),
+             plain);
+  _benchmark("RSA 3072",
+             infinit::cryptography::rsa::keypair::generate(3072),
+             plain);
+  _benchmark("DSA 2048",
+             infinit::cryptography::dsa::keypair::generate(2048),
+             plain);
+}
+
+/*-----------.
+| Agreements |
+`-----------*/
+
+/// Measure and report the generation of a key pair and the agreement with
+/// a peer.
+template <typename K>
+static
+void
+_benchmark(std::string const& name,
+           std::function<K ()> const& generate)
+{
+  K keypair1 = generate();
+  K keypair2 = generate();
+
+  BOOST_CHECK_EQUAL(keypair1.k().agree(keypair2.K()),
+                    keypair2.k().agree(keypair1.K()));
+
+  double generation = _measure([&] { generate(); });
+  double agreement = _measure([&] { keypair1.k().agree(keypair2.K()); });
+
+  elle::printf("[benchmark] %-12s generate: %10.1fus agree: %10.1fus\n",
+               name, generation, agreement);
+}
+
+static
+void
+test_agreements()
+{
+  _benchmark<infinit::cryptography::ec::KeyPair>(
+    "ECDH P-256",
+    [] { return (infinit::cryptography::ec::keypair::generate(
+                   infinit::cryptography::ec::Curve::p256)); });
+  _benchmark<infinit::cryptography::dh::KeyPair>(
+    "DH 2048",
+    [] { return (infinit::cryptography::dh::keypair::generate()); });
+}
+
+/*----------.
+| Envelopes |
+`----------*/
+
+/// Measure and report the sealing and opening of the plain with the given
+/// key pair.
+template <typename K>
+static
+void
+_benchmark_envelope(std::string const& name,
+                    K const& keypair,
+                    elle::ConstWeakBuffer const& plain)
+{
+  elle::Buffer code = keypair.K().seal(plain);
+
+  BOOST_CHECK_EQUAL(keypair.k().open(code), plain);
+
+  double seal = _measure([&] { keypair.K().seal(plain); });
+  double open = _measure([&] { keypair.k().open(code); });
+
+  elle::printf("[benchmark] %-12s seal: %10.1fus open: %10.1fus "
+               "overhead: %s bytes\n",
+               name, seal, open, code.size() - plain.size());
+}
+
+static
+void
+test_envelopes()
+{
+  // Large enough not to be directly encrypted with the RSA key.
+  elle::Buffer plain =
+    infinit::cryptography::random::generate<elle::Buffer>(512);
+
+  _benchmark_envelope("ECIES P-256",
+                      infinit::cryptography::ec::keypair::generate(
+                        infinit::cryptography::ec::Curve::p256),
+                      plain);
+  _benchmark_envelope("RSA 2048",
+                      infinit::cryptography::rsa::keypair::generate(2048),
+                      plain);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("ec/benchmark");
+
+  suite->add(BOOST_TEST_CASE(test_signatures));
+  suite->add(BOOST_TEST_CASE(test_agreements));
+  suite->add(BOOST_TEST_CASE(test_envelopes));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
@@ -0,0 +1,205 @@
+#include "../cryptography.hh"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/obj_mac.h>
+
+#include <cryptography/ec/KeyPair.hh>
+#include <cryptography/ec/PrivateKey.hh>
+#include <cryptography/ec/PublicKey.hh>
+#include <cryptography/ec/batch.hh>
+#include <cryptography/ec/deterministic.hh>
+#include <cryptography/hash.hh>
+#include <cryptography/random.hh>
+
+/// Return the private key whose scalar is given in hexadecimal.
+static
+infinit::cryptography::ec::PrivateKey
+_key(int const nid,
+     char const* scalar,
+     infinit::cryptography::Oneway const digest_algorithm)
+{
+  ::EC_KEY* ec = ::EC_KEY_new_by_curve_name(nid);
+  ::EC_GROUP const* group = ::EC_KEY_get0_group(ec);
+  ::BIGNUM* x = nullptr;
+  ::EC_POINT* point = ::EC_POINT_new(group);
+
+  BOOST_REQUIRE(::BN_hex2bn(&x, scalar) > 0);
+  BOOST_REQUIRE(::EC_POINT_mul(group, point, x,
+                               nullptr, nullptr, nullptr) > 0);
+  BOOST_REQUIRE(::EC_KEY_set_private_key(ec, x) > 0);
+  BOOST_REQUIRE(::EC_KEY_set_public_key(ec, point) > 0);
+
+  ::EC_POINT_free(point);
+  ::BN_clear_free(x);
+
+  return (infinit::cryptography::ec::PrivateKey(ec, digest_algorithm));
+}
+
+/// Return the hexadecimal representation of the number.
+static
+std::string
+_hex(::BIGNUM const* number)
+{
+  char* hex = ::BN_bn2hex(number);
+  std::string result(hex);
+
+  ::OPENSSL_free(hex);
+
+  return (result);
+}
+
+/*--------.
+| Vectors |
+`--------*/
+
+// RFC 6979 appendix A.2.5 and A.2.6, with the message "sample".
+static
+void
+_test_vector(int const nid,
+             char const* scalar,
+             infinit::cryptography::Oneway const oneway,
+             std::string const& k,
+             std::string const& r,
+             std::string const& s)
+{
+  auto key = _key(nid, scalar, oneway);
+  auto digest = infinit::cryptography::hash(elle::ConstWeakBuffer("sample", 6),
+                                            oneway);
+
+  ::BIGNUM* nonce = infinit::cryptography::ec::deterministic::nonce(
+    key.key()->pkey.ec,
+    infinit::cryptography::oneway::resolve(oneway),
+    digest);
+
+  BOOST_CHECK_EQUAL(_hex(nonce), k);
+  ::BN_clear_free(nonce);
+
+  elle::Buffer signature = key.sign(elle::ConstWeakBuffer("sample", 6));
+  unsigned char const* buffer = signature.contents();
+  ::ECDSA_SIG* _signature =
+    ::d2i_ECDSA_SIG(nullptr, &buffer, signature.size());
+
+  BOOST_REQUIRE(_signature != nullptr);
+  BOOST_CHECK_EQUAL(_hex(_signature->r), r);
+  BOOST_CHECK_EQUAL(_hex(_signature->s), s);
+  ::ECDSA_SIG_free(_signature);
+
+  infinit::cryptography::ec::PublicKey K(key);
+
+  BOOST_CHECK(K.verify(signature, elle::ConstWeakBuffer("sample", 6)));
+}
+
+static
+void
+test_vectors()
+{
+  _test_vector(
+    NID_X9_62_prime256v1,
+    "C9AFA9D845BA75166B5C215767B1D6934E50C3DB36E89B127B8A622B120F6721",
+    infinit::cryptography::Oneway::sha256,
+    "A6E3C57DD01ABE90086538398355DD4C3B17AA873382B0F24D6129493D8AAD60",
+    "EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716",
+    "F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8");
+  _test_vector(
+    NID_secp384r1,
+    "6B9D3DAD2E1B8C1C05B19875B6659F4DE23C3B667BF297BA9AA47740787137D8"
+    "96D5724E4C70A825F872C9EA60D2EDF5",
+    infinit::cryptography::Oneway::sha384,
+    "94ED910D1A099DAD3254E9242AE85ABDE4BA15168EAF0CA87A555FD56D10FBCA"
+    "2907E3E83BA95368623B8C4686915CF9",
+    "94EDBB92A5ECB8AAD4736E56C691916B3F88140666CE9FA73D64C4EA95AD133C"
+    "81A648152E44ACF96E36DD1E80FABE46",
+    "99EF4AEB15F178CEA1FE40DB2603138F130E740A19624526203B6351D0A3A94F"
+    "A329C145786E679E7B82C71A38628AC8");
+}
+
+/*--------------.
+| Deterministic |
+`--------------*/
+
+static
+void
+test_deterministic()
+{
+  auto keypair = infinit::cryptography::ec::keypair::generate();
+  elle::Buffer plain =
+    infinit::cryptography::random::generate<elle::Buffer>(4096);
+  elle::Buffer other =
+    infinit::cryptography::random::generate<elle::Buffer>(4096);
+
+  auto signature1 = keypair.k().sign(elle::ConstWeakBuffer(plain));
+  auto signature2 = keypair.k().sign(elle::ConstWeakBuffer(plain));
+  auto signature3 = keypair.k().sign(elle::ConstWeakBuffer(other));
+
+  BOOST_CHECK_EQUAL(signature1, signature2);
+  BOOST_CHECK_NE(signature1, signature3);
+  BOOST_CHECK(keypair.K().verify(signature1, elle::ConstWeakBuffer(plain)));
+  BOOST_CHECK(keypair.K().verify(signature3, elle::ConstWeakBuffer(other)));
+}
+
+/*------.
+| Batch |
+`------*/
+
+static
+void
+test_batch()
+{
+  auto keypair1 = infinit::cryptography::ec::keypair::generate(
+    infinit::cryptography::ec::Curve::p256);
+  auto keypair2 = infinit::cryptography::ec::keypair::generate(
+    infinit::cryptography::ec::Curve::p384);
+
+  std::vector<elle::Buffer> plains;
+  std::vector<elle::Buffer> signatures;
+
+  for (int i = 0; i < 32; ++i)
+  {
+    auto const& keypair = (i % 2) ? keypair2 : keypair1;
+
+    plains.emplace_back(
+      infinit::cryptography::random::generate<elle::Buffer>(256));
+    signatures.emplace_back(
+      keypair.k().sign(elle::ConstWeakBuffer(plains.back())));
+  }
+
+  std::vector<infinit::cryptography::ec::batch::Verification> verifications;
+
+  for (int i = 0; i < 32; ++i)
+  {
+    auto const& keypair = (i % 2) ? keypair2 : keypair1;
+
+    verifications.push_back({&keypair.K(), signatures[i], plains[i]});
+  }
+
+  // Tamper with a plain, verify against the wrong key and provide a
+  // malformed signature.
+  plains[3].mutable_contents()[0] ^= 0x1;
+  verifications[4].key = &keypair2.K();
+  verifications[5].signature = elle::ConstWeakBuffer("garbage", 7);
+
+  auto valid = infinit::cryptography::ec::batch::verify(verifications, 4);
+
+  BOOST_REQUIRE_EQUAL(valid.size(), verifications.size());
+  for (std::size_t i = 0; i < valid.size(); ++i)
+    BOOST_CHECK_EQUAL(valid[i], (i < 3) || (i > 5));
+
+  BOOST_CHECK(infinit::cryptography::ec::batch::verify({}).empty());
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("ec/deterministic");
+
+  suite->add(BOOST_TEST_CASE(test_vectors));
+  suite->add(BOOST_TEST_CASE(test_deterministic));
+  suite->add(BOOST_TEST_CASE(test_batch));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
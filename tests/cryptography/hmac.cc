@@ -4,6 +4,7 @@
 #include <cryptography/hmac.hh>
 #include <cryptography/random.hh>
 
+#include <elle/serialization/binary.hh>
 #include <elle/serialization/json.hh>
 
 static std::string const _message(
@@ -103,6 +104,73 @@ test_operate()
   }
 }
 
+/*-------.
+| Object |
+`-------*/
+
+class Object
+{
+public:
+  Object(int i, std::string s)
+    : _i(i)
+    , _s(std::move(s))
+  {}
+
+  void
+  serialize(elle::serialization::Serializer& s, elle::Version const& v)
+  {
+    s.serialize("i", this->_i);
+    if (v >= elle::Version(0, 1, 0))
+      s.serialize("s", this->_s);
+  }
+
+  ELLE_ATTRIBUTE_R(int, i);
+  ELLE_ATTRIBUTE_R(std::string, s);
+};
+
+static
+void
+test_object()
+{
+  std::string key =
+    infinit::cryptography::random::generate<std::string>(32);
+  Object o1(42, "forty-two");
+  Object o2(42, "twenty-four");
+
+  // The legacy version ignores the string.
+  {
+    elle::Version version(0, 0, 0);
+    elle::Buffer digest =
+      infinit::cryptography::hmac::sign(
+        o1, version, key, infinit::cryptography::Oneway::sha256);
+
+    BOOST_CHECK(infinit::cryptography::hmac::verify(
+                  digest, o1, version, key,
+                  infinit::cryptography::Oneway::sha256));
+    BOOST_CHECK(infinit::cryptography::hmac::verify(
+                  digest, o2, version, key,
+                  infinit::cryptography::Oneway::sha256));
+  }
+
+  // The streamed digest must match the one of the serialized object.
+  {
+    elle::Version version(0, 1, 0);
+    elle::Buffer digest =
+      infinit::cryptography::hmac::sign(
+        o1, version, key, infinit::cryptography::Oneway::sha256);
+    elle::Buffer serialized =
+      elle::serialization::binary::serialize(o1, version, false);
+
+    BOOST_CHECK_EQUAL(digest,
+                      infinit::cryptography::hmac::sign(
+                        serialized, key,
+                        infinit::cryptography::Oneway::sha256));
+    BOOST_CHECK(!infinit::cryptography::hmac::verify(
+                  digest, o2, version, key,
+                  infinit::cryptography::Oneway::sha256));
+  }
+}
+
 /*----------.
 | Serialize |
 `----------*/
@@ -170,6 +238,7 @@ ELLE_TEST_SUITE()
 
   suite->add(BOOST_TEST_CASE(test_represent));
   suite->add(BOOST_TEST_CASE(test_operate));
+  suite->add(BOOST_TEST_CASE(test_object));
   suite->add(BOOST_TEST_CASE(test_serialize));
 
   boost::unit_test::framework::master_test_suite().add(suite);
@@ -0,0 +1,151 @@
+#include "cryptography.hh"
+
+#include <sstream>
+
+#include <elle/IOStream.hh>
+
+#include <cryptography/SecretKey.hh>
+#include <cryptography/hash.hh>
+#include <cryptography/pipeline.hh>
+#include <cryptography/random.hh>
+#include <cryptography/dsa/KeyPair.hh>
+#include <cryptography/rsa/KeyPair.hh>
+
+static elle::Buffer const _plain(
+  infinit::cryptography::random::generate<elle::Buffer>(3 * 65536 + 17));
+
+/// Return the plain deciphered from the code.
+static
+elle::Buffer
+_decipher(infinit::cryptography::SecretKey const& key,
+          std::string const& code)
+{
+  return (key.decipher(elle::ConstWeakBuffer(code.data(), code.size())));
+}
+
+/*-----.
+| Hash |
+`-----*/
+
+static
+void
+test_hash()
+{
+  infinit::cryptography::SecretKey key =
+    infinit::cryptography::secretkey::generate(256);
+
+  elle::IOStream plain(_plain.istreambuf());
+  std::stringstream code;
+
+  auto digests = infinit::cryptography::pipeline::encipher(
+    key, plain, code, infinit::cryptography::Oneway::sha512);
+
+  std::string const output = code.str();
+  elle::ConstWeakBuffer _code(output.data(), output.size());
+
+  BOOST_CHECK_EQUAL(_decipher(key, output), _plain);
+  BOOST_CHECK_EQUAL(
+    digests.plain,
+    infinit::cryptography::hash(_plain,
+                                infinit::cryptography::Oneway::sha512));
+  BOOST_CHECK_EQUAL(
+    digests.code,
+    infinit::cryptography::hash(_code,
+                                infinit::cryptography::Oneway::sha512));
+}
+
+/*-----.
+| Sign |
+`-----*/
+
+static
+void
+test_sign()
+{
+  infinit::cryptography::SecretKey key =
+    infinit::cryptography::secretkey::generate(256);
+
+  // RSA.
+  {
+    auto keypair = infinit::cryptography::rsa::keypair::generate(1024);
+
+    elle::IOStream plain(_plain.istreambuf());
+    std::stringstream code;
+
+    auto result = infinit::cryptography::pipeline::encipher(
+      key, keypair.k(), plain, code);
+
+    std::string const output = code.str();
+    elle::ConstWeakBuffer _code(output.data(), output.size());
+
+    BOOST_CHECK_EQUAL(_decipher(key, output), _plain);
+    BOOST_CHECK_EQUAL(
+      result.digest,
+      infinit::cryptography::hash(_plain,
+                                  infinit::cryptography::Oneway::sha256));
+    BOOST_CHECK(keypair.K().verify(result.signature, _code));
+    BOOST_CHECK(!keypair.K().verify(result.signature,
+                                    elle::ConstWeakBuffer(_plain)));
+  }
+
+  // RSA with a non-default padding and oneway.
+  {
+    auto keypair = infinit::cryptography::rsa::keypair::generate(1024);
+
+    elle::IOStream plain(_plain.istreambuf());
+    std::stringstream code;
+
+    auto result = infinit::cryptography::pipeline::encipher(
+      key, keypair.k(), plain, code,
+      infinit::cryptography::Oneway::sha256,
+      infinit::cryptography::SecretKey::defaults::cipher,
+      infinit::cryptography::SecretKey::defaults::mode,
+      infinit::cryptography::SecretKey::defaults::oneway,
+      infinit::cryptography::rsa::Padding::pkcs1,
+      infinit::cryptography::Oneway::sha512);
+
+    std::string const output = code.str();
+    elle::ConstWeakBuffer _code(output.data(), output.size());
+
+    BOOST_CHECK(
+      keypair.K().verify(result.signature, _code,
+                         infinit::cryptography::rsa::Padding::pkcs1,
+                         infinit::cryptography::Oneway::sha512));
+    BOOST_CHECK(!keypair.K().verify(result.signature, _code));
+  }
+
+  // DSA.
+  {
+    auto keypair = infinit::cryptography::dsa::keypair::generate(1024);
+
+    elle::IOStream plain(_plain.istreambuf());
+    std::stringstream code;
+
+    auto result = infinit::cryptography::pipeline::encipher(
+      key, keypair.k(), plain, code);
+
+    std::string const output = code.str();
+    elle::ConstWeakBuffer _code(output.data(), output.size());
+
+    BOOST_CHECK_EQUAL(_decipher(key, output), _plain);
+    BOOST_CHECK_EQUAL(
+      result.digest,
+      infinit::cryptography::hash(_plain,
+                                  infinit::cryptography::Oneway::sha256));
+    BOOST_CHECK(keypair.K().verify(result.signature, _code));
+  }
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("pipeline");
+
+  suite->add(BOOST_TEST_CASE(test_hash));
+  suite->add(BOOST_TEST_CASE(test_sign));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
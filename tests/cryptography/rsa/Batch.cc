@@ -0,0 +1,117 @@
+#include "../cryptography.hh"
+
+#include <cryptography/rsa/Batch.hh>
+#include <cryptography/rsa/KeyPair.hh>
+#include <cryptography/random.hh>
+
+/*--------.
+| Operate |
+`--------*/
+
+static
+void
+test_operate()
+{
+  std::vector<infinit::cryptography::rsa::KeyPair> keypairs;
+  keypairs.push_back(infinit::cryptography::rsa::keypair::generate(1024));
+  keypairs.push_back(infinit::cryptography::rsa::keypair::generate(2048));
+
+  infinit::cryptography::rsa::Batch batch(3);
+
+  std::vector<elle::Buffer> inputs;
+  std::vector<infinit::cryptography::rsa::Batch::Request> requests;
+
+  for (uint32_t i = 0; i < 24; ++i)
+    inputs.push_back(
+      infinit::cryptography::random::generate<elle::Buffer>(32 + i));
+
+  for (uint32_t i = 0; i < inputs.size(); ++i)
+  {
+    auto const& keypair = keypairs[i % keypairs.size()];
+
+    switch (i % 3)
+    {
+      case 0:
+      {
+        requests.push_back({infinit::cryptography::rsa::Batch::Operation::sign,
+                            &keypair.k(),
+                            inputs[i]});
+        break;
+      }
+      case 1:
+      {
+        inputs[i] = keypair.K().encrypt(inputs[i]);
+        requests.push_back(
+          {infinit::cryptography::rsa::Batch::Operation::decrypt,
+           &keypair.k(),
+           inputs[i]});
+        break;
+      }
+      case 2:
+      {
+        inputs[i] = keypair.K().seal(inputs[i]);
+        requests.push_back({infinit::cryptography::rsa::Batch::Operation::open,
+                            &keypair.k(),
+                            inputs[i]});
+        break;
+      }
+    }
+  }
+
+  // Make the last request fail.
+  elle::Buffer garbage =
+    infinit::cryptography::random::generate<elle::Buffer>(16);
+  requests.push_back({infinit::cryptography::rsa::Batch::Operation::decrypt,
+                      &keypairs[0].k(),
+                      garbage});
+
+  auto results = batch.run(requests);
+
+  BOOST_CHECK_EQUAL(results.size(), requests.size());
+  BOOST_CHECK_EQUAL(batch.statistics().count, requests.size());
+  BOOST_CHECK_EQUAL(batch.statistics().errors, 1);
+  BOOST_CHECK(results.back().error != nullptr);
+
+  for (uint32_t i = 0; i < inputs.size(); ++i)
+  {
+    auto const& keypair = keypairs[i % keypairs.size()];
+
+    BOOST_REQUIRE(results[i].error == nullptr);
+
+    switch (i % 3)
+    {
+      case 0:
+      {
+        BOOST_CHECK(keypair.K().verify(results[i].output, inputs[i]));
+        break;
+      }
+      case 1:
+      {
+        BOOST_CHECK_EQUAL(results[i].output, keypair.k().decrypt(inputs[i]));
+        break;
+      }
+      case 2:
+      {
+        BOOST_CHECK_EQUAL(results[i].output, keypair.k().open(inputs[i]));
+        break;
+      }
+    }
+  }
+
+  // An empty batch completes immediately.
+  BOOST_CHECK(batch.run({}).empty());
+  BOOST_CHECK_EQUAL(batch.statistics().count, 0);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("rsa/Batch");
+
+  suite->add(BOOST_TEST_CASE(test_operate));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
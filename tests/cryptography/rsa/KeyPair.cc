@@ -4,11 +4,16 @@
 #include <cryptography/rsa/PublicKey.hh>
 #include <cryptography/rsa/PrivateKey.hh>
 #include <cryptography/rsa/Padding.hh>
+#include <cryptography/rsa/multiprime.hh>
 #include <cryptography/Oneway.hh>
 #include <cryptography/Cipher.hh>
 #include <cryptography/Error.hh>
+#include <cryptography/constants.hh>
+#include <cryptography/envelope.hh>
 #include <cryptography/random.hh>
 
+#include <thread>
+
 #include <elle/printf.hh>
 #include <elle/types.hh>
 #include <elle/serialization/json.hh>
@@ -131,6 +136,33 @@ _test_operate(infinit::cryptography::rsa::KeyPair const& keypair)
     BOOST_CHECK_EQUAL(input, output);
   }
 
+  // Public/private seal/open of a plain text small enough to be directly
+  // encrypted with the key, in the v4 format.
+  {
+    auto input = infinit::cryptography::random::generate<elle::Buffer>(16);
+
+    infinit::cryptography::envelope::format(
+      infinit::cryptography::envelope::Format::v4);
+
+    elle::Buffer code = keypair.K().seal(input);
+
+    infinit::cryptography::envelope::format(
+      infinit::cryptography::envelope::Format::v1);
+
+    // The magic number, the version, the empty key identifier's length
+    // and the code's length precede the code.
+    BOOST_CHECK_EQUAL(code.size(), 8 + 1 + 1 + 2 + keypair.K().size());
+    BOOST_CHECK_EQUAL(keypair.k().open(code), input);
+
+    std::stringstream _code(code.string());
+    std::stringstream plain;
+
+    keypair.k().open(_code, plain);
+
+    BOOST_CHECK_EQUAL(elle::Buffer(plain.str().data(), plain.str().size()),
+                      input);
+  }
+
   // Public/private encryption/decryption.
   {
     std::string input = "a short string";
@@ -264,6 +296,507 @@ signing()
   }
 }
 
+/*---------.
+| Parallel |
+`---------*/
+
+static
+void
+parallel()
+{
+  for (uint32_t length: {1024, 2056})
+  {
+    infinit::cryptography::rsa::KeyPair keypair =
+      infinit::cryptography::rsa::keypair::generate_parallel(length, 2);
+
+    BOOST_CHECK_EQUAL(keypair.length(), length);
+
+    _test_operate(keypair);
+  }
+}
+
+/*-----------.
+| Recipients |
+`-----------*/
+
+static
+void
+recipients()
+{
+  infinit::cryptography::rsa::KeyPair keypair1 = _test_generate(1024);
+  infinit::cryptography::rsa::KeyPair keypair2 = _test_generate(2048);
+  infinit::cryptography::rsa::KeyPair keypair3 = _test_generate(1024);
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(100000);
+  elle::Buffer code =
+    infinit::cryptography::rsa::publickey::seal({&keypair1.K(),
+                                                 &keypair2.K()},
+                                                input);
+
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  BOOST_CHECK_EQUAL(keypair2.k().open(code), input);
+  BOOST_CHECK_THROW(keypair3.k().open(code), infinit::cryptography::Error);
+}
+
+/*-------.
+| Format |
+`-------*/
+
+static
+void
+format()
+{
+  infinit::cryptography::rsa::KeyPair keypair1 = _test_generate(1024);
+  infinit::cryptography::rsa::KeyPair keypair2 = _test_generate(1024);
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(10000);
+
+  auto seal = [&] (infinit::cryptography::envelope::Format const format,
+                   elle::ConstWeakBuffer const& id)
+    {
+      std::stringstream plain(input.string());
+      std::stringstream code;
+
+      infinit::cryptography::envelope::seal(
+        keypair1.K().key().get(),
+        infinit::cryptography::cipher::resolve(
+          infinit::cryptography::Cipher::aes256,
+          infinit::cryptography::Mode::cbc),
+        plain, code,
+        format, id);
+
+      return (code.str());
+    };
+  // Open the envelope, giving a cipher different from the sealing one.
+  auto open = [] (infinit::cryptography::rsa::KeyPair const& keypair,
+                  std::string const& code,
+                  infinit::cryptography::Cipher const cipher)
+    {
+      std::stringstream _code(code);
+      std::stringstream plain;
+
+      infinit::cryptography::envelope::open(
+        keypair.k().key().get(),
+        infinit::cryptography::cipher::resolve(
+          cipher,
+          infinit::cryptography::Mode::cbc),
+        _code, plain);
+
+      return (elle::Buffer(plain.str().data(), plain.str().length()));
+    };
+
+  // v1 envelopes are still opened, the cipher being the caller's.
+  {
+    std::string code =
+      seal(infinit::cryptography::envelope::Format::v1,
+           elle::ConstWeakBuffer());
+
+    BOOST_CHECK_EQUAL(open(keypair1, code,
+                           infinit::cryptography::Cipher::aes256),
+                      input);
+    BOOST_CHECK_THROW(seal(infinit::cryptography::envelope::Format::v1,
+                           elle::ConstWeakBuffer("id", 2)),
+                      infinit::cryptography::Error);
+  }
+
+  // v2 envelopes embed their cipher.
+  {
+    std::string code =
+      seal(infinit::cryptography::envelope::Format::v2,
+           elle::ConstWeakBuffer());
+
+    BOOST_CHECK_EQUAL(open(keypair1, code,
+                           infinit::cryptography::Cipher::blowfish),
+                      input);
+  }
+
+  // v2 envelopes tagged with the recipient's key identifier.
+  {
+    elle::Buffer id =
+      infinit::cryptography::envelope::fingerprint(keypair1.K().key().get());
+    std::string code =
+      seal(infinit::cryptography::envelope::Format::v2, id);
+
+    BOOST_CHECK_EQUAL(open(keypair1, code,
+                           infinit::cryptography::Cipher::aes256),
+                      input);
+    BOOST_CHECK_THROW(open(keypair2, code,
+                           infinit::cryptography::Cipher::aes256),
+                      infinit::cryptography::Error);
+  }
+
+  // v4 envelopes directly encrypt the small plains with the key.
+  {
+    elle::Buffer small =
+      infinit::cryptography::random::generate<elle::Buffer>(32);
+    elle::Buffer id =
+      infinit::cryptography::envelope::fingerprint(keypair1.K().key().get());
+    std::stringstream plain(small.string());
+    std::stringstream code;
+
+    infinit::cryptography::envelope::seal(
+      keypair1.K().key().get(),
+      infinit::cryptography::cipher::resolve(
+        infinit::cryptography::Cipher::aes256,
+        infinit::cryptography::Mode::cbc),
+      plain, code,
+      infinit::cryptography::envelope::Format::v4, id);
+
+    BOOST_CHECK_EQUAL(code.str()[8], 4);
+    BOOST_CHECK_EQUAL(open(keypair1, code.str(),
+                           infinit::cryptography::Cipher::blowfish),
+                      small);
+    BOOST_CHECK_THROW(open(keypair2, code.str(),
+                           infinit::cryptography::Cipher::aes256),
+                      infinit::cryptography::Error);
+  }
+
+  // While the larger ones are sealed in v2 envelopes.
+  {
+    std::string code =
+      seal(infinit::cryptography::envelope::Format::v4,
+           elle::ConstWeakBuffer());
+
+    BOOST_CHECK_EQUAL(code[8], 2);
+    BOOST_CHECK_EQUAL(open(keypair1, code,
+                           infinit::cryptography::Cipher::blowfish),
+                      input);
+  }
+
+  // The default format applies to the regular sealing.
+  {
+    infinit::cryptography::envelope::format(
+      infinit::cryptography::envelope::Format::v2);
+
+    elle::Buffer code = keypair1.K().seal(input);
+
+    infinit::cryptography::envelope::format(
+      infinit::cryptography::envelope::Format::v1);
+
+    BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  }
+}
+
+/*--------.
+| Chunked |
+`--------*/
+
+static
+void
+chunked()
+{
+  namespace envelope = infinit::cryptography::envelope;
+
+  infinit::cryptography::rsa::KeyPair keypair1 = _test_generate(1024);
+  infinit::cryptography::rsa::KeyPair keypair2 = _test_generate(2048);
+
+  auto cipher = infinit::cryptography::cipher::resolve(
+    infinit::cryptography::Cipher::aes256,
+    infinit::cryptography::Mode::cbc);
+  auto open = [&] (infinit::cryptography::rsa::KeyPair const& keypair,
+                   std::string const& code,
+                   std::stringstream& plain)
+    {
+      std::stringstream _code(code);
+
+      envelope::open(keypair.k().key().get(), cipher, _code, plain);
+    };
+
+  // Plains smaller than, equal to and larger than the chunk size.
+  for (std::size_t size: {0u,
+                          1000u,
+                          infinit::cryptography::constants::envelope_chunk_size,
+                          2 * infinit::cryptography::constants::
+                            envelope_chunk_size,
+                          200000u})
+  {
+    elle::Buffer input =
+      infinit::cryptography::random::generate<elle::Buffer>(size);
+    std::stringstream _plain(input.string());
+    std::stringstream _code;
+
+    envelope::seal({keypair1.K().key().get(), keypair2.K().key().get()},
+                   cipher, _plain, _code, envelope::Format::v3);
+
+    for (auto const* keypair: {&keypair1, &keypair2})
+    {
+      std::stringstream plain;
+      open(*keypair, _code.str(), plain);
+      BOOST_CHECK_EQUAL(plain.str(), input.string());
+    }
+  }
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(200000);
+  std::string code;
+  {
+    std::stringstream _plain(input.string());
+    std::stringstream _code;
+
+    envelope::seal(keypair1.K().key().get(), cipher, _plain, _code,
+                   envelope::Format::v3);
+    code = _code.str();
+  }
+
+  // A truncated envelope is detected, the authentic chunks having been
+  // released already.
+  {
+    std::stringstream plain;
+
+    BOOST_CHECK_THROW(open(keypair1, code.substr(0, code.size() - 100),
+                           plain),
+                      infinit::cryptography::Error);
+    BOOST_CHECK_EQUAL(
+      plain.str(),
+      input.string().substr(
+        0,
+        3 * infinit::cryptography::constants::envelope_chunk_size));
+  }
+
+  // So is a tampered one.
+  {
+    std::string tampered = code;
+    tampered[tampered.size() / 2] ^= 1;
+    std::stringstream plain;
+
+    BOOST_CHECK_THROW(open(keypair1, tampered, plain),
+                      infinit::cryptography::Error);
+  }
+}
+
+/*-------.
+| Rewrap |
+`-------*/
+
+static
+void
+rewrap()
+{
+  namespace envelope = infinit::cryptography::envelope;
+
+  infinit::cryptography::rsa::KeyPair from = _test_generate(1024);
+  infinit::cryptography::rsa::KeyPair to = _test_generate(2048);
+  infinit::cryptography::rsa::KeyPair other = _test_generate(1024);
+
+  ::EVP_CIPHER const* cipher = nullptr;
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(100000);
+
+  auto check = [&] (std::string const& code)
+    {
+      // Rewrap the header, copying the payload as is.
+      std::stringstream _code(code);
+      std::stringstream rewrapped;
+
+      envelope::rewrap(from.k().key().get(), to.K().key().get(), cipher,
+                       _code, rewrapped);
+      rewrapped << _code.rdbuf();
+
+      // The payload has not been re-encrypted.
+      BOOST_CHECK(
+        code.compare(code.size() - 50000, 50000,
+                     rewrapped.str(), rewrapped.str().size() - 50000,
+                     50000) == 0);
+
+      std::stringstream plain;
+      envelope::open(to.k().key().get(), cipher, rewrapped, plain);
+      BOOST_CHECK_EQUAL(plain.str(), input.string());
+
+      std::stringstream _rewrapped(rewrapped.str());
+      std::stringstream _plain;
+      BOOST_CHECK_THROW(
+        envelope::open(from.k().key().get(), cipher, _rewrapped, _plain),
+        infinit::cryptography::Error);
+
+      return (rewrapped.str());
+    };
+
+  // Note that the Blowfish IV is shorter than the AES one.
+  for (auto _cipher: {infinit::cryptography::Cipher::aes256,
+                      infinit::cryptography::Cipher::blowfish})
+  {
+    cipher = infinit::cryptography::cipher::resolve(
+      _cipher, infinit::cryptography::Mode::cbc);
+
+    for (auto format: {envelope::Format::v1,
+                       envelope::Format::v2,
+                       envelope::Format::v3})
+    {
+      // The STREAM format is for AES only.
+      if ((format == envelope::Format::v3) &&
+          (_cipher != infinit::cryptography::Cipher::aes256))
+        continue;
+
+      std::stringstream plain(input.string());
+      std::stringstream code;
+
+      envelope::seal(from.K().key().get(), cipher, plain, code, format);
+      check(code.str());
+    }
+  }
+
+  cipher = infinit::cryptography::cipher::resolve(
+    infinit::cryptography::Cipher::aes256,
+    infinit::cryptography::Mode::cbc);
+
+  // The other recipients' slots are kept.
+  {
+    std::stringstream _plain(input.string());
+    std::stringstream code;
+
+    envelope::seal({from.K().key().get(), other.K().key().get()},
+                   cipher, _plain, code);
+
+    std::stringstream rewrapped(check(code.str()));
+    std::stringstream plain;
+    envelope::open(other.k().key().get(), cipher, rewrapped, plain);
+    BOOST_CHECK_EQUAL(plain.str(), input.string());
+  }
+}
+
+/*---------------.
+| Envelope Cache |
+`---------------*/
+
+static
+void
+envelope_cache()
+{
+  namespace cache = infinit::cryptography::envelope::cache;
+
+  infinit::cryptography::rsa::KeyPair keypair1 = _test_generate(1024);
+  infinit::cryptography::rsa::KeyPair keypair2 = _test_generate(1024);
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(10000);
+  elle::Buffer code = keypair1.K().seal(input);
+
+  cache::enable(2);
+
+  auto before = cache::statistics();
+
+  // The second open finds the unwrapped secret.
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  BOOST_CHECK_EQUAL(cache::statistics().misses, before.misses + 1);
+  BOOST_CHECK_EQUAL(cache::statistics().hits, before.hits + 1);
+  BOOST_CHECK_EQUAL(cache::statistics().size, 1u);
+
+  // Another key cannot take advantage of the cached secret.
+  BOOST_CHECK_THROW(keypair2.k().open(code), infinit::cryptography::Error);
+
+  // The least recently used secrets are evicted.
+  for (int i = 0; i < 2; ++i)
+    BOOST_CHECK_EQUAL(keypair1.k().open(keypair1.K().seal(input)), input);
+  BOOST_CHECK_EQUAL(cache::statistics().size, 2u);
+  BOOST_CHECK_EQUAL(cache::statistics().evictions, before.evictions + 1);
+
+  // The purge releases the key's secrets.
+  cache::purge(keypair1.k().key().get());
+  BOOST_CHECK_EQUAL(cache::statistics().size, 0u);
+
+  // The secrets expire.
+  cache::enable(2, std::chrono::seconds(0));
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+  BOOST_CHECK_EQUAL(cache::statistics().expirations, before.expirations + 1);
+
+  cache::disable();
+  BOOST_CHECK(!cache::enabled());
+  BOOST_CHECK_EQUAL(cache::statistics().size, 0u);
+  BOOST_CHECK_EQUAL(keypair1.k().open(code), input);
+}
+
+/*-----------.
+| Multiprime |
+`-----------*/
+
+static
+void
+multiprime()
+{
+  infinit::cryptography::rsa::KeyPair keypair =
+    infinit::cryptography::rsa::keypair::generate(2048, 3);
+
+  BOOST_CHECK_EQUAL(keypair.length(), 2048);
+  BOOST_CHECK(
+    infinit::cryptography::rsa::multiprime::primes(
+      keypair.k().key()->pkey.rsa) != nullptr);
+
+  _test_operate(keypair);
+
+  // The additional primes survive the serialization.
+  {
+    std::stringstream stream;
+    {
+      typename elle::serialization::json::SerializerOut output(stream);
+      keypair.serialize(output);
+    }
+
+    typename elle::serialization::json::SerializerIn input(stream);
+    infinit::cryptography::rsa::KeyPair other(input);
+
+    BOOST_CHECK_EQUAL(keypair, other);
+    BOOST_CHECK(
+      infinit::cryptography::rsa::multiprime::primes(
+        other.k().key()->pkey.rsa) != nullptr);
+    BOOST_CHECK_EQUAL(
+      infinit::cryptography::rsa::privatekey::der::encode(keypair.k()),
+      infinit::cryptography::rsa::privatekey::der::encode(other.k()));
+
+    _test_operate(other);
+  }
+
+  // Too many primes for the key length.
+  BOOST_CHECK_THROW(infinit::cryptography::rsa::keypair::generate(2048, 4),
+                    infinit::cryptography::Error);
+}
+
+/*------.
+| Cache |
+`------*/
+
+static
+void
+cache()
+{
+  infinit::cryptography::rsa::KeyPair keypair = _test_generate(1024);
+
+  // Alternate paddings so that several contexts are cached for the same key.
+  for (int i = 0; i < 16; ++i)
+  {
+    auto padding =
+      (i % 2) == 0 ?
+      infinit::cryptography::rsa::Padding::oaep :
+      infinit::cryptography::rsa::Padding::pkcs1;
+    auto input = infinit::cryptography::random::generate<elle::Buffer>(32);
+    elle::Buffer code = keypair.K().encrypt(input, padding);
+    elle::Buffer plain = keypair.k().decrypt(code, padding);
+
+    BOOST_CHECK_EQUAL(input, plain);
+  }
+
+  // Use keys from another thread and destroy them from this one.
+  for (int i = 0; i < 4; ++i)
+  {
+    auto k = std::make_shared<infinit::cryptography::rsa::PrivateKey>(
+      _test_generate(512).k());
+    infinit::cryptography::rsa::PublicKey K(*k);
+    auto input = infinit::cryptography::random::generate<elle::Buffer>(16);
+    elle::Buffer code = K.encrypt(input);
+    elle::Buffer plain;
+
+    std::thread thread([&] { plain = k->decrypt(code); });
+    thread.join();
+
+    BOOST_CHECK_EQUAL(input, plain);
+
+    k.reset();
+  }
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -277,4 +810,12 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(operate));
   suite.add(BOOST_TEST_CASE(serialize));
   suite.add(BOOST_TEST_CASE(signing));
+  suite.add(BOOST_TEST_CASE(parallel));
+  suite.add(BOOST_TEST_CASE(recipients));
+  suite.add(BOOST_TEST_CASE(format));
+  suite.add(BOOST_TEST_CASE(chunked));
+  suite.add(BOOST_TEST_CASE(rewrap));
+  suite.add(BOOST_TEST_CASE(envelope_cache));
+  suite.add(BOOST_TEST_CASE(multiprime));
+  suite.add(BOOST_TEST_CASE(cache));
 }
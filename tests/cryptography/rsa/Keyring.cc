@@ -0,0 +1,121 @@
+#include "../cryptography.hh"
+
+#include <sstream>
+#include <vector>
+
+#include <cryptography/Error.hh>
+#include <cryptography/envelope.hh>
+#include <cryptography/random.hh>
+#include <cryptography/rsa/KeyPair.hh>
+#include <cryptography/rsa/Keyring.hh>
+
+/*-----.
+| Open |
+`-----*/
+
+static
+void
+test_open()
+{
+  namespace envelope = infinit::cryptography::envelope;
+
+  std::vector<infinit::cryptography::rsa::KeyPair> keypairs;
+  infinit::cryptography::rsa::Keyring keyring;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    keypairs.push_back(infinit::cryptography::rsa::keypair::generate(1024));
+    keyring.add(keypairs.back().k());
+  }
+  BOOST_CHECK_EQUAL(keyring.size(), 4u);
+
+  // Adding a key twice replaces it.
+  keyring.add(keypairs[0].k());
+  BOOST_CHECK_EQUAL(keyring.size(), 4u);
+
+  auto K = keypairs[2].K().key().get();
+  BOOST_CHECK(keyring.find(envelope::fingerprint(K)) != nullptr);
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(10000);
+  auto cipher = infinit::cryptography::cipher::resolve(
+    infinit::cryptography::Cipher::aes256,
+    infinit::cryptography::Mode::cbc);
+
+  // Envelopes identifying their recipient.
+  for (auto format: {envelope::Format::v2,
+                     envelope::Format::v3,
+                     envelope::Format::v4})
+  {
+    elle::Buffer code = keypairs[2].K().seal(input, format, true);
+
+    BOOST_CHECK_EQUAL(keyring.open(code), input);
+  }
+
+  // Envelopes sealed for several recipients.
+  {
+    infinit::cryptography::rsa::KeyPair stranger =
+      infinit::cryptography::rsa::keypair::generate(1024);
+    elle::Buffer code =
+      infinit::cryptography::rsa::publickey::seal(
+        {&stranger.K(), &keypairs[3].K()}, input);
+
+    BOOST_CHECK_EQUAL(keyring.open(code), input);
+  }
+
+  // Small plains directly encrypted with the public key.
+  {
+    elle::Buffer small =
+      infinit::cryptography::random::generate<elle::Buffer>(16);
+    elle::Buffer code =
+      keypairs[1].K().seal(small, envelope::Format::v4, true);
+
+    BOOST_CHECK_EQUAL(keyring.open(code), small);
+
+    // Unless the key is not identified.
+    BOOST_CHECK_THROW(
+      keyring.open(keypairs[1].K().seal(small, envelope::Format::v4, false)),
+      infinit::cryptography::Error);
+  }
+
+  // Envelopes without identifier cannot be opened.
+  {
+    std::stringstream plain(input.string());
+    std::stringstream code;
+
+    envelope::seal(K, cipher, plain, code, envelope::Format::v1);
+
+    BOOST_CHECK_THROW(
+      keyring.open(elle::Buffer(code.str().data(), code.str().size())),
+      infinit::cryptography::Error);
+  }
+
+  // Nor envelopes sealed for a removed key.
+  {
+    BOOST_CHECK(keyring.remove(keypairs[2].K()));
+    BOOST_CHECK(!keyring.remove(keypairs[2].K()));
+
+    std::stringstream plain(input.string());
+    std::stringstream code;
+
+    envelope::seal(K, cipher, plain, code, envelope::Format::v2,
+                   envelope::fingerprint(K));
+
+    BOOST_CHECK_THROW(
+      keyring.open(elle::Buffer(code.str().data(), code.str().size())),
+      infinit::cryptography::Error);
+  }
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("rsa/Keyring");
+
+  suite->add(BOOST_TEST_CASE(test_open));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
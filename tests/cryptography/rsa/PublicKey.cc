@@ -4,6 +4,7 @@
 #include <cryptography/rsa/PrivateKey.hh>
 #include <cryptography/rsa/KeyPair.hh>
 
+#include <elle/printf.hh>
 #include <elle/serialization/json.hh>
 
 /*----------.
@@ -190,6 +191,91 @@ test_serialize()
   }
 }
 
+/*--------.
+| Compact |
+`--------*/
+
+static
+void
+test_compact()
+{
+  infinit::cryptography::rsa::KeyPair keypair =
+    infinit::cryptography::rsa::keypair::generate(2048);
+
+  std::stringstream stream;
+  {
+    typename elle::serialization::json::SerializerOut output(stream);
+    keypair.K().serialize(output);
+  }
+
+  // Deserialize the keys lazily, then materialize them.
+  infinit::cryptography::rsa::publickey::lazy(true);
+  std::vector<infinit::cryptography::rsa::PublicKey> keys;
+  for (uint32_t i = 0; i < 8; ++i)
+  {
+    std::stringstream _stream(stream.str());
+    typename elle::serialization::json::SerializerIn input(_stream);
+    keys.emplace_back(input);
+  }
+  infinit::cryptography::rsa::publickey::lazy(false);
+
+  for (auto& K: keys)
+    BOOST_CHECK(K.key() != nullptr);
+
+  for (auto& K: keys)
+    K.compact();
+
+  // Compact keys are compared and serialized without being materialized.
+  BOOST_CHECK_EQUAL(keys[0], keys[1]);
+  {
+    std::stringstream _stream;
+    {
+      typename elle::serialization::json::SerializerOut output(_stream);
+      keys[2].serialize(output);
+    }
+    BOOST_CHECK_EQUAL(_stream.str(), stream.str());
+  }
+
+  // Use the keys, compact them and use them again.
+  for (auto& K: keys)
+  {
+    BOOST_CHECK_EQUAL(K, keypair.K());
+    BOOST_CHECK_EQUAL(keypair.k().open(K.seal(_input)), _input);
+    K.compact();
+    BOOST_CHECK_EQUAL(keypair.k().decrypt(K.encrypt(_input)), _input);
+  }
+
+  // Copies of compact keys remain compact.
+  {
+    keys[0].compact();
+    infinit::cryptography::rsa::PublicKey K(keys[0]);
+    BOOST_CHECK_EQUAL(K, keypair.K());
+  }
+
+  // Deserializing into a compact key replaces its representation.
+  {
+    infinit::cryptography::rsa::KeyPair other =
+      infinit::cryptography::rsa::keypair::generate(1024);
+    std::stringstream _stream;
+    {
+      typename elle::serialization::json::SerializerOut output(_stream);
+      other.K().serialize(output);
+    }
+
+    keys[3].compact();
+    {
+      typename elle::serialization::json::SerializerIn input(_stream);
+      keys[3].serialize(input);
+    }
+
+    BOOST_CHECK_EQUAL(keys[3], other.K());
+    BOOST_CHECK(keys[3] != keypair.K());
+    BOOST_CHECK_EQUAL(
+      infinit::cryptography::rsa::publickey::der::encode(keys[3]),
+      infinit::cryptography::rsa::publickey::der::encode(other.K()));
+  }
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -204,6 +290,7 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_compare));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_compact));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
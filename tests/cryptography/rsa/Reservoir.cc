@@ -0,0 +1,171 @@
+#include "../cryptography.hh"
+
+#include <chrono>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include <cryptography/Error.hh>
+#include <cryptography/SecretKey.hh>
+#include <cryptography/rsa/KeyPool.hh>
+#include <cryptography/rsa/Reservoir.hh>
+#include <cryptography/rsa/PrivateKey.hh>
+
+static
+std::string
+_test_path()
+{
+  return (
+    (boost::filesystem::temp_directory_path() /
+     boost::filesystem::unique_path("reservoir-%%%%-%%%%-%%%%")).string());
+}
+
+static
+void
+_test_fill(infinit::cryptography::rsa::Reservoir const& reservoir,
+           std::size_t const size)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+
+  while (reservoir.size() < size)
+  {
+    BOOST_REQUIRE(std::chrono::steady_clock::now() < deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+static
+void
+_test_cleanup(std::string const& path)
+{
+  boost::filesystem::remove(path);
+  boost::filesystem::remove(path + ".cursor");
+  boost::filesystem::remove(path + ".lock");
+}
+
+/*--------.
+| Operate |
+`--------*/
+
+static
+void
+test_operate()
+{
+  std::string path = _test_path();
+  infinit::cryptography::SecretKey key("chiche, donne nous tout!");
+  std::vector<infinit::cryptography::rsa::PrivateKey> handed;
+
+  // Fill the reservoir and take a key pair.
+  {
+    infinit::cryptography::rsa::Reservoir reservoir(path, key, 512, 3);
+    _test_fill(reservoir, 3);
+
+    auto keypair = reservoir.take();
+    BOOST_REQUIRE(keypair != nullptr);
+    handed.push_back(keypair->k());
+  }
+
+  // Reload the reservoir without refilling it: the key pair handed out
+  // must not be handed out again.
+  {
+    infinit::cryptography::rsa::Reservoir reservoir(path, key, 512, 0);
+    BOOST_CHECK_GE(reservoir.size(), 2);
+
+    while (auto keypair = reservoir.take())
+      handed.push_back(keypair->k());
+
+    BOOST_CHECK_EQUAL(reservoir.size(), 0);
+  }
+
+  BOOST_CHECK_GE(handed.size(), 3);
+  for (std::size_t i = 0; i < handed.size(); ++i)
+    for (std::size_t j = i + 1; j < handed.size(); ++j)
+      BOOST_CHECK(handed[i] != handed[j]);
+
+  // Every key pair has been consumed.
+  {
+    infinit::cryptography::rsa::Reservoir reservoir(path, key, 512, 0);
+    BOOST_CHECK_EQUAL(reservoir.size(), 0);
+    BOOST_CHECK(reservoir.take() == nullptr);
+  }
+
+  _test_cleanup(path);
+}
+
+/*-----.
+| Lock |
+`-----*/
+
+static
+void
+test_lock()
+{
+  std::string path = _test_path();
+  infinit::cryptography::SecretKey key("chiche, donne nous tout!");
+
+  {
+    infinit::cryptography::rsa::Reservoir reservoir(path, key, 512, 0);
+
+    // The reservoir cannot be opened twice.
+    BOOST_CHECK_THROW(
+      infinit::cryptography::rsa::Reservoir(path, key, 512, 0),
+      infinit::cryptography::Error);
+  }
+
+  // The lock is released along with the reservoir.
+  {
+    infinit::cryptography::rsa::Reservoir reservoir(path, key, 512, 0);
+  }
+
+  _test_cleanup(path);
+}
+
+/*-----.
+| Pool |
+`-----*/
+
+static
+void
+test_pool()
+{
+  std::string path = _test_path();
+  infinit::cryptography::SecretKey key("chiche, donne nous tout!");
+
+  std::unique_ptr<infinit::cryptography::rsa::Reservoir> reservoir(
+    new infinit::cryptography::rsa::Reservoir(path, key, 512, 2));
+  _test_fill(*reservoir, 2);
+
+  // The pool generates longer key pairs than the reservoir's so as to tell
+  // where the key pairs come from.
+  infinit::cryptography::rsa::KeyPool pool(1024, 1, 1, std::move(reservoir));
+
+  // Use the pool through its base class: the reservoir must not be
+  // bypassed.
+  elle::ProducerPool<infinit::cryptography::rsa::KeyPair>& base = pool;
+
+  BOOST_CHECK_EQUAL(base.get().k().length(), 512);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    auto keypair = base.get();
+    BOOST_CHECK(keypair.k().length() == 512 ||
+                keypair.k().length() == 1024);
+  }
+
+  _test_cleanup(path);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("rsa/Reservoir");
+
+  suite->add(BOOST_TEST_CASE(test_operate));
+  suite->add(BOOST_TEST_CASE(test_lock));
+  suite->add(BOOST_TEST_CASE(test_pool));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
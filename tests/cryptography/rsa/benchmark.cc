@@ -0,0 +1,184 @@
+#include "../cryptography.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <cryptography/rsa/KeyPair.hh>
+#include <cryptography/rsa/PublicKey.hh>
+
+#include <elle/printf.hh>
+#include <elle/serialization/json.hh>
+
+#if defined(__GLIBC__)
+# include <malloc.h>
+#endif
+
+/*----------.
+| Utilities |
+`----------*/
+
+static uint32_t const _samples = RUNNING_ON_VALGRIND ? 1 : 20;
+
+/// Return the durations of the successive runs of the operation, in
+/// milliseconds, sorted in increasing order.
+static
+std::vector<double>
+_sample(std::function<void ()> const& operation)
+{
+  std::vector<double> durations;
+
+  for (uint32_t i = 0; i < _samples; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    operation();
+
+    std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    durations.push_back(elapsed.count());
+  }
+
+  std::sort(durations.begin(), durations.end());
+
+  return (durations);
+}
+
+/// Return the given percentile of the sorted durations.
+static
+double
+_percentile(std::vector<double> const& durations,
+            uint32_t const percentile)
+{
+  return (durations[(durations.size() - 1) * percentile / 100]);
+}
+
+/// Measure and report the latency distribution of the generation.
+static
+void
+_benchmark(std::string const& name,
+           std::function<infinit::cryptography::rsa::KeyPair ()> const&
+             generate)
+{
+  std::vector<double> durations = _sample([&] { generate(); });
+
+  elle::printf("[benchmark] %-16s min: %8.1fms p50: %8.1fms "
+               "p90: %8.1fms max: %8.1fms\n",
+               name,
+               durations.front(),
+               _percentile(durations, 50),
+               _percentile(durations, 90),
+               durations.back());
+}
+
+/*-----------.
+| Generation |
+`-----------*/
+
+static
+void
+test_generation()
+{
+  for (uint32_t length: { 2048, 3072 })
+  {
+    _benchmark(
+      elle::sprintf("RSA %s", length),
+      [length] {
+        return (infinit::cryptography::rsa::keypair::generate(length));
+      });
+    _benchmark(
+      elle::sprintf("RSA %s parallel", length),
+      [length] {
+        return (infinit::cryptography::rsa::keypair::generate_parallel(
+                  length));
+      });
+  }
+}
+
+/*--------.
+| Compact |
+`--------*/
+
+#if defined(__GLIBC__)
+static bool const _measurable = true;
+#else
+static bool const _measurable = false;
+#endif
+
+/// Return the number of bytes currently allocated on the heap, zero if
+/// unknown, relying on mallinfo2() where available, mallinfo() being
+/// deprecated since glibc 2.33.
+static
+std::size_t
+_heap()
+{
+#if defined(__GLIBC__) && \
+  ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+  return (::mallinfo2().uordblks);
+#elif defined(__GLIBC__)
+  return (static_cast<std::size_t>(::mallinfo().uordblks));
+#else
+  return (0);
+#endif
+}
+
+/// Measure and report the heap footprint of the public keys, once
+/// deserialized in their compact form and once materialized.
+static
+void
+test_compact()
+{
+  if (!_measurable)
+  {
+    elle::printf("[benchmark] %-16s unavailable on this platform\n",
+                 "RSA 2048 heap");
+    return;
+  }
+
+  infinit::cryptography::rsa::KeyPair keypair =
+    infinit::cryptography::rsa::keypair::generate(2048);
+
+  std::stringstream stream;
+  {
+    typename elle::serialization::json::SerializerOut output(stream);
+    keypair.K().serialize(output);
+  }
+
+  infinit::cryptography::rsa::publickey::lazy(true);
+  std::vector<infinit::cryptography::rsa::PublicKey> keys;
+  keys.reserve(64);
+  std::size_t const start = _heap();
+  for (uint32_t i = 0; i < 64; ++i)
+  {
+    std::stringstream _stream(stream.str());
+    typename elle::serialization::json::SerializerIn input(_stream);
+    keys.emplace_back(input);
+  }
+  std::size_t const compact = _heap();
+  infinit::cryptography::rsa::publickey::lazy(false);
+
+  for (auto& K: keys)
+    K.key();
+  std::size_t const materialized = _heap();
+
+  elle::printf("[benchmark] %-16s compact: %6sB materialized: %6sB\n",
+               "RSA 2048 heap",
+               (compact - start) / keys.size(),
+               (materialized - start) / keys.size());
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("rsa/benchmark");
+
+  suite->add(BOOST_TEST_CASE(test_generation));
+  suite->add(BOOST_TEST_CASE(test_compact));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}
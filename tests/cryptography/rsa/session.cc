@@ -0,0 +1,154 @@
+#include "../cryptography.hh"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <cryptography/Error.hh>
+#include <cryptography/random.hh>
+#include <cryptography/rsa/KeyPair.hh>
+#include <cryptography/rsa/session.hh>
+
+/*--------.
+| Operate |
+`--------*/
+
+static
+void
+test_operate()
+{
+  auto keypair = infinit::cryptography::rsa::keypair::generate(1024);
+  infinit::cryptography::rsa::session::Sealer sealer(
+    keypair.K(),
+    infinit::cryptography::rsa::session::Rotation(3));
+  infinit::cryptography::rsa::session::Opener opener(keypair.k());
+
+  std::vector<elle::Buffer> inputs;
+  std::vector<elle::Buffer> codes;
+
+  for (int i = 0; i < 7; ++i)
+  {
+    inputs.push_back(
+      infinit::cryptography::random::generate<elle::Buffer>(64));
+    codes.push_back(sealer.seal(inputs.back()));
+  }
+
+  // Only the first message of every session carries the wrapped secret.
+  BOOST_CHECK_GT(codes[0].size(), codes[1].size());
+  BOOST_CHECK_EQUAL(codes[1].size(), codes[2].size());
+  BOOST_CHECK_GT(codes[3].size(), codes[2].size());
+
+  for (int i = 0; i < 7; ++i)
+    BOOST_CHECK_EQUAL(opener.open(codes[i]), inputs[i]);
+
+  // The sessions are kept until they expire.
+  BOOST_CHECK_EQUAL(opener.size(), 3u);
+
+  // A message cannot be opened without its session's first message.
+  {
+    infinit::cryptography::rsa::session::Opener other(keypair.k());
+
+    BOOST_CHECK_THROW(other.open(codes[1]), infinit::cryptography::Error);
+    BOOST_CHECK_EQUAL(other.open(codes[0]), inputs[0]);
+    BOOST_CHECK_EQUAL(other.open(codes[1]), inputs[1]);
+  }
+
+  // A reset sealer starts a new session.
+  {
+    elle::Buffer input =
+      infinit::cryptography::random::generate<elle::Buffer>(64);
+
+    sealer.reset();
+    opener.clear();
+
+    BOOST_CHECK_EQUAL(opener.open(sealer.seal(input)), input);
+    BOOST_CHECK_EQUAL(opener.open(sealer.seal(input)), input);
+  }
+}
+
+/*----------.
+| Rotation |
+`----------*/
+
+static
+void
+test_rotation()
+{
+  auto keypair = infinit::cryptography::rsa::keypair::generate(1024);
+  // The sealer alone decides of the sessions' length.
+  infinit::cryptography::rsa::session::Sealer sealer(
+    keypair.K(),
+    infinit::cryptography::rsa::session::Rotation(8));
+  infinit::cryptography::rsa::session::Opener opener(keypair.k(), 2);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    elle::Buffer input =
+      infinit::cryptography::random::generate<elle::Buffer>(64);
+
+    BOOST_CHECK_EQUAL(opener.open(sealer.seal(input)), input);
+  }
+
+  BOOST_CHECK_EQUAL(opener.size(), 1u);
+}
+
+/*-----------.
+| Expiration |
+`-----------*/
+
+static
+void
+test_expiration()
+{
+  auto keypair = infinit::cryptography::rsa::keypair::generate(1024);
+  infinit::cryptography::rsa::session::Rotation rotation(
+    1024, std::chrono::seconds(0));
+  infinit::cryptography::rsa::session::Sealer sealer(keypair.K(), rotation);
+  infinit::cryptography::rsa::session::Opener opener(keypair.k());
+
+  elle::Buffer input =
+    infinit::cryptography::random::generate<elle::Buffer>(64);
+  elle::Buffer first = sealer.seal(input);
+  elle::Buffer second = sealer.seal(input);
+
+  // Every message starts a new session since the period has elapsed.
+  BOOST_CHECK_EQUAL(first.size(), second.size());
+  BOOST_CHECK_EQUAL(opener.open(second), input);
+
+  // The openers forget the sessions once the sealer's period elapsed,
+  // extended with their tolerance.
+  infinit::cryptography::rsa::session::Sealer other(
+    keypair.K(),
+    infinit::cryptography::rsa::session::Rotation(
+      1024, std::chrono::seconds(1)));
+  infinit::cryptography::rsa::session::Opener strict(
+    keypair.k(), 64, std::chrono::seconds(0));
+  infinit::cryptography::rsa::session::Opener tolerant(keypair.k());
+
+  elle::Buffer opening = other.seal(input);
+  elle::Buffer continuation = other.seal(input);
+
+  BOOST_CHECK_EQUAL(strict.open(opening), input);
+  BOOST_CHECK_EQUAL(tolerant.open(opening), input);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+  BOOST_CHECK_THROW(strict.open(continuation),
+                    infinit::cryptography::Error);
+  BOOST_CHECK_EQUAL(tolerant.open(continuation), input);
+}
+
+/*-----.
+| Main |
+`-----*/
+
+ELLE_TEST_SUITE()
+{
+  boost::unit_test::test_suite* suite = BOOST_TEST_SUITE("rsa/session");
+
+  suite->add(BOOST_TEST_CASE(test_operate));
+  suite->add(BOOST_TEST_CASE(test_rotation));
+  suite->add(BOOST_TEST_CASE(test_expiration));
+
+  boost::unit_test::framework::master_test_suite().add(suite);
+}